@@ -0,0 +1,588 @@
+/**
+ * @file benchmark.c
+ * @brief Medição de desempenho das operações principais em mapas sintéticos
+ * 
+ * @details Para cada tamanho (potências de 10 entre --min e --max antenas):
+ * - Gera um mapa com gerarMapa (semente fixa)
+ * - Mede carregarAntenasDoMapa, calcularEfeitoNefasto,
+ *   removerAntenasEmEfeitos, imprimirMapa, avaliarCandidatos (lote de
+ *   BENCH_CANDIDATOS posições) e uma sequência de inserções/remoções
+ * - Escreve uma linha CSV por fase: tempo total, ns/op, alocações e pico de RSS
+ * 
+ * Com --gerar, apenas escreve o mapa sintético no ficheiro indicado; com
+ * --verificar, compara os motores de efeitos em mapas aleatórios, também
+ * depois de sequências de edições.
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <stdint.h>
+ #include "funcoes.h"
+ #include "util.h"
+ #include "indice.h"
+ #include "simulacao.h"
+ #include "conjunto.h"
+ #include "incremental.h"
+ #include "cenario.h"
+ #include "paralelo.h"
+ #include "kernel.h"
+ #include "intensidade.h"
+ #include "gerador.h"
+
+ #ifdef _WIN32
+ #define PSAPI_VERSION 2
+ #include <windows.h>
+ #include <psapi.h>
+ #define DISPOSITIVO_NULO "NUL"
+ #else
+ #include <time.h>
+ #include <sys/resource.h>
+ #define DISPOSITIVO_NULO "/dev/null"
+ #endif
+
+/**
+ * @brief Número de candidatos avaliados na fase avaliarCandidatos
+ */
+ #define BENCH_CANDIDATOS 100000
+
+/**
+ * @brief Número de edições aplicadas a cada mapa da verificação
+ */
+ #define BENCH_EDICOES 40
+
+ #ifdef BENCH_CONTAR_ALOCACOES
+/**
+ * @brief Número de chamadas a malloc/calloc/realloc desde o início
+ * 
+ * @note Só é contado quando compilado com -DBENCH_CONTAR_ALOCACOES e
+ *       -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc
+ */
+static long long alocacoes = 0;
+
+void* __real_malloc(size_t n);
+void* __real_calloc(size_t n, size_t t);
+void* __real_realloc(void* p, size_t n);
+
+void* __wrap_malloc(size_t n) {
+    alocacoes++;
+    return __real_malloc(n);
+}
+
+void* __wrap_calloc(size_t n, size_t t) {
+    alocacoes++;
+    return __real_calloc(n, t);
+}
+
+void* __wrap_realloc(void* p, size_t n) {
+    alocacoes++;
+    return __real_realloc(p, n);
+}
+ #endif
+
+/**
+ * @brief Devolve o número de alocações, ou -1 se não estiver a ser contado
+ */
+static long long contarAlocacoes(void) {
+ #ifdef BENCH_CONTAR_ALOCACOES
+    return alocacoes;
+ #else
+    return -1;
+ #endif
+}
+
+/**
+ * @brief Relógio monotónico em nanossegundos
+ */
+static uint64_t agoraNs(void) {
+ #ifdef _WIN32
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (uint64_t)((double)t.QuadPart * 1e9 / (double)f.QuadPart);
+ #else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
+ #endif
+}
+
+/**
+ * @brief Pico de memória residente do processo em KiB
+ */
+static long picoRssKb(void) {
+ #ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return (long)(pmc.PeakWorkingSetSize / 1024);
+    return -1;
+ #else
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) return -1;
+ #ifdef __APPLE__
+    return (long)(uso.ru_maxrss / 1024);
+ #else
+    return (long)uso.ru_maxrss;
+ #endif
+ #endif
+}
+
+/**
+ * @brief Medição de uma fase em curso
+ */
+typedef struct {
+    uint64_t inicio;         ///< Instante de início (ns)
+    long long alocacoes;     ///< Alocações no início
+} Medicao;
+
+/**
+ * @brief Inicia a medição de uma fase
+ */
+static Medicao iniciarMedicao(void) {
+    Medicao m;
+    m.alocacoes = contarAlocacoes();
+    m.inicio = agoraNs();
+    return m;
+}
+
+/**
+ * @brief Termina a medição e escreve a linha CSV correspondente
+ */
+static void terminarMedicao(FILE* csv, const Medicao* m, size_t alvo, size_t antenas,
+                            const ParametrosGerador* p, const char* fase, size_t operacoes) {
+    uint64_t total = agoraNs() - m->inicio;
+    long long alocs = contarAlocacoes();
+    fprintf(csv, "%zu,%zu,%d,%d,%s,%zu,%llu,%.1f,%lld,%ld\n",
+            alvo, antenas, p->linhas, p->colunas, fase, operacoes,
+            (unsigned long long)total, operacoes ? (double)total / (double)operacoes : 0.0,
+            alocs < 0 ? -1 : alocs - m->alocacoes, picoRssKb());
+    fflush(csv);
+}
+
+/**
+ * @brief Executa todas as fases para um tamanho de mapa
+ */
+static void medirTamanho(FILE* csv, size_t alvo, ParametrosGerador p) {
+    char ficheiro[64];
+    snprintf(ficheiro, sizeof(ficheiro), "bench_mapa_%zu.txt", alvo);
+    dimensionarMapa(alvo, &p);
+    gerarMapa(ficheiro, &p);
+
+    int linhas, colunas;
+    Medicao m = iniciarMedicao();
+    Antena* lista = carregarAntenasDoMapa(ficheiro, &linhas, &colunas);
+    size_t n = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox) n++;
+    terminarMedicao(csv, &m, alvo, n, &p, "carregarAntenasDoMapa", n);
+
+    Mapa mapa = {linhas, colunas};
+    m = iniciarMedicao();
+    Antena* efeitos = calcularEfeitoNefasto(lista, &mapa);
+    terminarMedicao(csv, &m, alvo, n, &p, "calcularEfeitoNefasto", n);
+
+    FILE* nulo = fopen(DISPOSITIVO_NULO, "w");
+    m = iniciarMedicao();
+    imprimirJanela(nulo, lista, efeitos, 0, 0, colunas, linhas);
+    terminarMedicao(csv, &m, alvo, n, &p, "imprimirMapa", (size_t)linhas * (size_t)colunas);
+    fclose(nulo);
+
+    // Lote de candidatos em posições pseudo-aleatórias, sem alterar o estado
+    EstadoEfeitos* estadoEfeitos = criarEstadoEfeitos(lista, linhas, colunas);
+    Candidato* candidatos = (Candidato*)malloc(BENCH_CANDIDATOS * sizeof(Candidato));
+    uint64_t semente = p.semente ^ 0x9E3779B97F4A7C15ULL;
+    for (size_t k = 0; k < BENCH_CANDIDATOS; k++) {
+        semente = semente * 6364136223846793005ULL + 1442695040888963407ULL;
+        candidatos[k].x = (int)((semente >> 33) % (uint64_t)colunas);
+        candidatos[k].y = (int)((semente >> 13) % (uint64_t)linhas);
+        candidatos[k].frequencia = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"[(semente >> 50) % 36];
+    }
+    m = iniciarMedicao();
+    ResultadoCandidato* resultados = avaliarCandidatos(estadoEfeitos, candidatos, BENCH_CANDIDATOS, 0);
+    terminarMedicao(csv, &m, alvo, n, &p, "avaliarCandidatos", BENCH_CANDIDATOS);
+    libertarResultados(resultados, BENCH_CANDIDATOS);
+    free(candidatos);
+    libertarEstadoEfeitos(estadoEfeitos);
+
+    // Inserções e remoções alternadas em posições pseudo-aleatórias
+    size_t operacoes = n < 2000 ? n : 2000;
+    uint64_t estado = p.semente ^ 0xD1B54A32D192ED03ULL;
+    m = iniciarMedicao();
+    for (size_t k = 0; k < operacoes; k++) {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        int x = (int)((estado >> 33) % (uint64_t)colunas);
+        int y = (int)((estado >> 13) % (uint64_t)linhas);
+        if (k & 1) lista = removerAntena(lista, x, y);
+        else lista = inserirAntena(lista, 'Z', x, y);
+    }
+    terminarMedicao(csv, &m, alvo, n, &p, "inserirRemoverAntena", operacoes);
+
+    // Modo silencioso: o mesmo percurso de removerAntenasEmEfeitos sem escrita no terminal
+    m = iniciarMedicao();
+    IndiceCoord* zonas = indexarLista(efeitos, linhas, colunas);
+    lista = filtrarAntenasEmEfeitos(lista, zonas, NULL, NULL);
+    libertarIndiceCoord(zonas);
+    terminarMedicao(csv, &m, alvo, n, &p, "removerAntenasEmEfeitos", n);
+
+    libertarLista(lista);
+    libertarLista(efeitos);
+    remove(ficheiro);
+}
+
+/**
+ * @brief Próximo número do gerador xorshift64* da verificação
+ */
+static uint64_t sortear(uint64_t* estado) {
+    uint64_t x = *estado;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *estado = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Inteiro uniforme em [minimo, maximo]
+ */
+static int sortearEntre(uint64_t* estado, int minimo, int maximo) {
+    return minimo + (int)(sortear(estado) % (uint64_t)(maximo - minimo + 1));
+}
+
+/**
+ * @brief Dimensão de um eixo: ilimitado (0 ou negativo) em cerca de metade dos casos
+ */
+static int sortearDimensao(uint64_t* estado) {
+    switch (sortear(estado) % 4) {
+        case 0: return 0;
+        case 1: return -1;
+        default: return sortearEntre(estado, 1, 40);
+    }
+}
+
+/**
+ * @brief Compara duas listas de efeitos pelas coordenadas
+ * 
+ * @return int 1 se tiverem os mesmos pontos, pela mesma ordem (x,y)
+ */
+static int mesmosEfeitos(Antena* a, Antena* b) {
+    for (; a != NULL && b != NULL; a = a->prox, b = b->prox)
+        if (a->x != b->x || a->y != b->y) return 0;
+    return a == NULL && b == NULL;
+}
+
+/**
+ * @brief Conta os pontos de uma lista
+ */
+static size_t contarLista(Antena* lista) {
+    size_t n = 0;
+    for (; lista != NULL; lista = lista->prox) n++;
+    return n;
+}
+
+/**
+ * @brief Indica uma divergência entre um motor e o motor de listas
+ */
+static int confirmarMotor(const char* motor, Antena* obtidos, Antena* esperados, int linhas, int colunas) {
+    if (mesmosEfeitos(obtidos, esperados)) return 1;
+    fprintf(stderr, "Divergência em L%d C%d: %s=%zu, listas=%zu\n", linhas, colunas,
+            motor, contarLista(obtidos), contarLista(esperados));
+    return 0;
+}
+
+/**
+ * @brief Compara o mapa de intensidade com as contagens do estado incremental
+ * 
+ * @return int 1 se as células com contagem positiva e as contagens coincidirem
+ */
+static int confirmarIntensidade(const MapaIntensidade* intensidade, const EstadoEfeitos* estado,
+                                Antena* efeitos, int linhas, int colunas) {
+    size_t n = 0, diferentes = 0;
+    for (Antena* e = efeitos; e != NULL; e = e->prox, n++)
+        if (intensidadePares(intensidade, e->x, e->y) != contagemValor(estado->efeitos, e->x, e->y))
+            diferentes++;
+    if (diferentes == 0 && intensidade->celulas == n) return 1;
+    fprintf(stderr, "Divergência em L%d C%d: intensidade=%zu células, incremental=%zu (%zu contagens diferentes)\n",
+            linhas, colunas, intensidade->celulas, n, diferentes);
+    return 0;
+}
+
+/**
+ * @brief Compara o núcleo vetorial escolhido com o escalar em entradas aleatórias
+ * 
+ * @return int 1 se todas as marcas coincidirem
+ */
+static int verificarKernel(uint64_t* estado) {
+    enum { N = 37 };
+    int xs[N], ys[N];
+    uint32_t ie[N], iv[N];
+    uint8_t pe[N], pv[N];
+    KernelAlinhamento vetorial = escolherKernel();
+    int raio = sortear(estado) % 2 ? 40 : KERNEL_COORD_MAXIMA;
+    int x0 = sortearEntre(estado, -raio, raio), y0 = sortearEntre(estado, -raio, raio);
+    for (int j = 0; j < N; j++) {
+        // Metade dos parceiros alinhados com (x0,y0) para exercitar as projeções
+        int d = sortearEntre(estado, -raio / 3, raio / 3);
+        xs[j] = sortear(estado) % 2 ? x0 + d : sortearEntre(estado, -raio, raio);
+        ys[j] = sortear(estado) % 2 ? y0 + d * sortearEntre(estado, -1, 1) : sortearEntre(estado, -raio, raio);
+    }
+    int colunas = sortearDimensao(estado), linhas = sortearDimensao(estado);
+    size_t ne = kernelEscalar(xs, ys, N, x0, y0, colunas, linhas, ie, pe);
+    size_t nv = vetorial(xs, ys, N, x0, y0, colunas, linhas, iv, pv);
+    int iguais = ne == nv && memcmp(ie, iv, ne * sizeof(uint32_t)) == 0 && memcmp(pe, pv, ne) == 0;
+    if (!iguais) fprintf(stderr, "Divergência do núcleo %s em L%d C%d\n", nomeKernel(), linhas, colunas);
+    return iguais;
+}
+
+/**
+ * @brief Intervalo das edições num eixo: [-2, dimensão+1], ou o das antenas se ilimitado
+ */
+static void intervaloEdicoes(int dimensao, int* minimo, int* maximo) {
+    *minimo = dimensao > 0 ? -2 : -15;
+    *maximo = dimensao > 0 ? dimensao + 1 : 45;
+}
+
+/**
+ * @brief Compara um ramo de cenário com o estado incremental que o acompanha
+ * 
+ * @return int 1 se as antenas e os efeitos coincidirem em todas as células
+ *         onde podem existir
+ */
+static int confirmarCenario(const Cenario* cenario, const EstadoEfeitos* estado, Mapa mapa) {
+    int xMin, xMax, yMin, yMax;
+    intervaloEdicoes(mapa.colunas, &xMin, &xMax);
+    intervaloEdicoes(mapa.linhas, &yMin, &yMax);
+    const AntenaSet* antenas = estado->antenas;
+    size_t diferentes = 0;
+    for (int x = xMin; x <= xMax; x++) {
+        for (int y = yMin; y <= yMax; y++) {
+            size_t pos = procurarNoConjunto(antenas, x, y);
+            char esperada = pos == CONJUNTO_NAO_ENCONTRADO ? '\0' : antenas->frequencia[pos];
+            diferentes += cenarioAntena(cenario, x, y) != esperada;
+        }
+    }
+    // Os efeitos estão no mapa e a no máximo uma distância entre antenas do intervalo
+    int xFim = mapa.colunas > 0 ? mapa.colunas : 2 * xMax - xMin + 1;
+    int yFim = mapa.linhas > 0 ? mapa.linhas : 2 * yMax - yMin + 1;
+    for (int x = 0; x < xFim; x++)
+        for (int y = 0; y < yFim; y++)
+            diferentes += cenarioTemEfeito(cenario, x, y) != estadoTemEfeito(estado, x, y);
+    if (diferentes > 0)
+        fprintf(stderr, "Divergência do cenário em L%d C%d: %zu células\n", mapa.linhas, mapa.colunas, diferentes);
+    return diferentes == 0;
+}
+
+/**
+ * @brief Aplica uma sequência de edições ao estado incremental e a ramos de cenário
+ * 
+ * @details As edições caem em [-2, dimensão+1] nos eixos limitados, pelo que
+ * há inserções e remoções fora do mapa. A meio da sequência o cenário é
+ * ramificado e cada ramo passa a ter o seu estado de referência. No fim,
+ * cada estado é comparado com o recálculo completo pelo motor de listas e
+ * cada ramo com o seu estado.
+ * 
+ * @return int 1 se não houver divergências
+ */
+static int verificarEdicoes(uint64_t* sorteio, Antena* lista, Mapa mapa) {
+    EstadoEfeitos* estados[2] = {criarEstadoEfeitos(lista, mapa.linhas, mapa.colunas), NULL};
+    Cenario* ramos[2] = {criarCenario(criarEstadoEfeitos(lista, mapa.linhas, mapa.colunas)), NULL};
+    int numRamos = 1, ok = 1;
+    int xMin, xMax, yMin, yMax;
+    intervaloEdicoes(mapa.colunas, &xMin, &xMax);
+    intervaloEdicoes(mapa.linhas, &yMin, &yMax);
+
+    for (int passo = 0; passo < BENCH_EDICOES; passo++) {
+        if (passo == BENCH_EDICOES / 2) {
+            Antena* antenas = conjuntoParaLista(estados[0]->antenas);
+            estados[1] = criarEstadoEfeitos(antenas, mapa.linhas, mapa.colunas);
+            ramos[1] = ramificarCenario(ramos[0]);
+            libertarLista(antenas);
+            numRamos = 2;
+        }
+        int r = sortearEntre(sorteio, 0, numRamos - 1);
+        const AntenaSet* antenas = estados[r]->antenas;
+        int x = sortearEntre(sorteio, xMin, xMax), y = sortearEntre(sorteio, yMin, yMax);
+        if (sortear(sorteio) % 3 == 0) {
+            // Metade das remoções atinge uma antena existente
+            if (antenas->tamanho > 0 && sortear(sorteio) % 2 == 0) {
+                size_t k = sortear(sorteio) % antenas->tamanho;
+                x = antenas->x[k];
+                y = antenas->y[k];
+            }
+            ok = estadoRemoverAntena(estados[r], x, y) == cenarioRemoverAntena(ramos[r], x, y) && ok;
+        } else {
+            char frequencia = (char)sortearEntre(sorteio, 'A', 'D');
+            ok = estadoInserirAntena(estados[r], frequencia, x, y) ==
+                 cenarioInserirAntena(ramos[r], frequencia, x, y) && ok;
+        }
+    }
+
+    for (int r = 0; r < numRamos; r++) {
+        Antena* antenas = conjuntoParaLista(estados[r]->antenas);
+        Antena* esperados = calcularEfeitoNefasto(antenas, &mapa);
+        Antena* doEstado = estadoListaEfeitos(estados[r]);
+        ok = confirmarMotor("edições", doEstado, esperados, mapa.linhas, mapa.colunas) && ok;
+        ok = confirmarCenario(ramos[r], estados[r], mapa) && ok;
+        libertarLista(doEstado);
+        libertarLista(esperados);
+        libertarLista(antenas);
+        libertarCenario(ramos[r]);
+        libertarEstadoEfeitos(estados[r]);
+    }
+    return ok;
+}
+
+/**
+ * @brief Compara os motores de efeitos com o motor de listas em mapas aleatórios
+ * 
+ * @param[in] mapas Número de mapas a gerar
+ * @param[in] semente Semente do gerador
+ * @return size_t Número de mapas com alguma divergência
+ * 
+ * @details Cada eixo é limitado ou ilimitado (dimensão 0 ou negativa) de
+ * forma independente, e há antenas com coordenadas negativas e fora do
+ * mapa. São comparados o estado incremental, o AntenaSet, a versão
+ * paralela, o mapa de intensidade (contra as contagens do estado
+ * incremental) e o núcleo vetorial escolhido contra o escalar. Cada mapa
+ * recebe ainda uma sequência de edições (verificarEdicoes) aplicada ao
+ * estado incremental e a cenários ramificados.
+ */
+static size_t verificarMotores(size_t mapas, uint64_t semente) {
+    uint64_t estado = semente ? semente : 1;
+    size_t falhas = 0;
+    for (size_t m = 0; m < mapas; m++) {
+        Mapa mapa = {sortearDimensao(&estado), sortearDimensao(&estado)};
+        Antena* lista = NULL;
+        int n = sortearEntre(&estado, 2, 60);
+        for (int i = 0; i < n; i++) {
+            int x = sortearEntre(&estado, -15, 45), y = sortearEntre(&estado, -15, 45);
+            if (!existeNaLista(lista, x, y))
+                lista = inserirAntena(lista, (char)sortearEntre(&estado, 'A', 'D'), x, y);
+        }
+
+        Antena* esperados = calcularEfeitoNefasto(lista, &mapa);
+        EstadoEfeitos* incremental = criarEstadoEfeitos(lista, mapa.linhas, mapa.colunas);
+        Antena* doEstado = estadoListaEfeitos(incremental);
+        AntenaSet* conjunto = conjuntoDeLista(lista, mapa.linhas, mapa.colunas);
+        AntenaSet* efeitos = calcularEfeitoNefastoConjunto(conjunto);
+        Antena* doConjunto = conjuntoParaLista(efeitos);
+        AntenaSet* efeitosParalelos = calcularEfeitoNefastoParalelo(conjunto, 2);
+        Antena* doParalelo = conjuntoParaLista(efeitosParalelos);
+        MapaIntensidade* intensidade = calcularIntensidade(conjunto);
+
+        int ok = confirmarMotor("incremental", doEstado, esperados, mapa.linhas, mapa.colunas);
+        ok = confirmarMotor("conjunto", doConjunto, esperados, mapa.linhas, mapa.colunas) && ok;
+        ok = confirmarMotor("paralelo", doParalelo, esperados, mapa.linhas, mapa.colunas) && ok;
+        ok = confirmarIntensidade(intensidade, incremental, doEstado, mapa.linhas, mapa.colunas) && ok;
+        ok = verificarKernel(&estado) && ok;
+        ok = verificarEdicoes(&estado, lista, mapa) && ok;
+        if (!ok) falhas++;
+
+        libertarIntensidade(intensidade);
+        libertarLista(doParalelo);
+        libertarConjunto(efeitosParalelos);
+        libertarLista(doConjunto);
+        libertarConjunto(efeitos);
+        libertarConjunto(conjunto);
+        libertarLista(doEstado);
+        libertarEstadoEfeitos(incremental);
+        libertarLista(esperados);
+        libertarLista(lista);
+    }
+    return falhas;
+}
+
+/**
+ * @brief Lê o valor numérico de uma opção
+ */
+static double valorOpcao(int argc, char** argv, int* i) {
+    if (*i + 1 >= argc) {
+        fprintf(stderr, "Erro: Falta o valor da opção %s\n", argv[*i]);
+        exit(EXIT_FAILURE);
+    }
+    return atof(argv[++*i]);
+}
+
+/**
+ * @brief Lê o valor de uma opção de tamanho (0 se não for positivo)
+ */
+static size_t tamanhoOpcao(int argc, char** argv, int* i) {
+    double v = valorOpcao(argc, argv, i);
+    return v >= 1.0 && v < 1e18 ? (size_t)v : 0;
+}
+
+/**
+ * @brief Ponto de entrada do benchmark
+ * 
+ * @note Opções: --min N, --max N, --densidade D, --frequencias F,
+ *       --enviesamento S, --semente X, --saida ficheiro.csv,
+ *       --gerar ficheiro (com --linhas L --colunas C),
+ *       --verificar N (com --semente X)
+ */
+int main(int argc, char** argv) {
+    ParametrosGerador p = {0, 0, 0.05, 36, 0.0, 42};
+    size_t minimo = 100, maximo = 100000;
+    const char* saida = NULL;
+    const char* gerar = NULL;
+    size_t verificar = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--min") == 0) minimo = tamanhoOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--max") == 0) maximo = tamanhoOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--densidade") == 0) p.densidade = valorOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--frequencias") == 0) p.frequencias = (int)valorOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--enviesamento") == 0) p.enviesamento = valorOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--semente") == 0) p.semente = (uint64_t)valorOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--linhas") == 0) p.linhas = (int)valorOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--colunas") == 0) p.colunas = (int)valorOpcao(argc, argv, &i);
+        else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) saida = argv[++i];
+        else if (strcmp(argv[i], "--gerar") == 0 && i + 1 < argc) gerar = argv[++i];
+        else if (strcmp(argv[i], "--verificar") == 0) verificar = tamanhoOpcao(argc, argv, &i);
+        else {
+            fprintf(stderr, "Erro: Opção desconhecida %s\n", argv[i]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (verificar > 0) {
+        size_t falhas = verificarMotores(verificar, p.semente);
+        fprintf(stderr, "%zu mapas verificados (núcleo %s), %zu com divergências\n",
+                verificar, nomeKernel(), falhas);
+        return falhas == 0 ? 0 : EXIT_FAILURE;
+    }
+
+    if (gerar == NULL && (minimo < 1 || maximo < minimo)) {
+        fprintf(stderr, "Erro: --min deve ser pelo menos 1 e não maior do que --max\n");
+        return EXIT_FAILURE;
+    }
+
+    if (gerar != NULL) {
+        if (p.linhas <= 0 || p.colunas <= 0) {
+            fprintf(stderr, "Erro: --gerar requer --linhas e --colunas positivos\n");
+            return EXIT_FAILURE;
+        }
+        size_t total = gerarMapa(gerar, &p);
+        fprintf(stderr, "%zu antenas escritas em %s\n", total, gerar);
+        return 0;
+    }
+
+    FILE* csv = stdout;
+    if (saida != NULL && (csv = fopen(saida, "w")) == NULL) {
+        fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", saida);
+        return EXIT_FAILURE;
+    }
+    fprintf(csv, "alvo,antenas,linhas,colunas,fase,operacoes,ns_total,ns_por_op,alocacoes,pico_rss_kb\n");
+    for (size_t alvo = minimo; alvo <= maximo; alvo *= 10) {
+        medirTamanho(csv, alvo, p);
+        if (alvo > maximo / 10) break;
+    }
+    if (csv != stdout) fclose(csv);
+    return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file gerador.c
+ * @brief Implementação do gerador de mapas sintéticos
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <math.h>
+ #include "gerador.h"
+ #include "memoria.h"
+
+/**
+ * @brief Carácteres usados como frequência, pela ordem de peso
+ */
+static const char SIMBOLOS[GERADOR_MAX_FREQUENCIAS + 1] =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+/**
+ * @brief Próximo número do gerador xorshift64*
+ */
+static uint64_t proximoAleatorio(uint64_t* estado) {
+    uint64_t x = *estado;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *estado = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * @brief Número real uniforme em [0,1)
+ */
+static double aleatorioReal(uint64_t* estado) {
+    return (double)(proximoAleatorio(estado) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+size_t gerarMapa(const char* filename, const ParametrosGerador* p) {
+    FILE* f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", filename);
+        exit(EXIT_FAILURE);
+    }
+
+    int frequencias = p->frequencias;
+    if (frequencias < 1) frequencias = 1;
+    if (frequencias > GERADOR_MAX_FREQUENCIAS) frequencias = GERADOR_MAX_FREQUENCIAS;
+
+    // Distribuição acumulada de Zipf sobre as frequências
+    double acumulado[GERADOR_MAX_FREQUENCIAS];
+    double soma = 0.0;
+    for (int i = 0; i < frequencias; i++) {
+        soma += 1.0 / pow((double)(i + 1), p->enviesamento);
+        acumulado[i] = soma;
+    }
+
+    uint64_t estado = p->semente ? p->semente : 0x9E3779B97F4A7C15ULL;
+    char* linha = (char*)realocar(NULL, (size_t)p->colunas + 1, 1);
+    linha[p->colunas] = '\n';
+
+    size_t total = 0;
+    fprintf(f, "%d %d\n", p->linhas, p->colunas);
+    for (int y = 0; y < p->linhas; y++) {
+        for (int x = 0; x < p->colunas; x++) {
+            linha[x] = '.';
+            if (aleatorioReal(&estado) >= p->densidade) continue;
+            double alvo = aleatorioReal(&estado) * soma;
+            int i = 0;
+            while (i < frequencias - 1 && acumulado[i] <= alvo) i++;
+            linha[x] = SIMBOLOS[i];
+            total++;
+        }
+        fwrite(linha, 1, (size_t)p->colunas + 1, f);
+    }
+
+    free(linha);
+    fclose(f);
+    return total;
+}
+
+void dimensionarMapa(size_t antenas, ParametrosGerador* p) {
+    double area = (double)antenas / (p->densidade > 0.0 ? p->densidade : 1.0);
+    int lado = (int)ceil(sqrt(area));
+    p->linhas = lado > 0 ? lado : 1;
+    p->colunas = p->linhas;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file gerador.h
+ * @brief Gerador determinístico de mapas sintéticos para medições de desempenho
+ * 
+ * @details Gera ficheiros no formato lido por carregarAntenasDoMapa:
+ * - Dimensões e densidade de antenas configuráveis
+ * - Número de frequências configurável, com distribuição enviesada (Zipf)
+ * - Resultado reprodutível a partir de uma semente
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef GERADOR_H
+ #define GERADOR_H
+
+ #include <stdint.h>
+ #include <stddef.h>
+
+/**
+ * @brief Número máximo de frequências distintas ('0'-'9', 'A'-'Z', 'a'-'z')
+ */
+ #define GERADOR_MAX_FREQUENCIAS 62
+
+/**
+ * @brief Parâmetros de geração de um mapa
+ */
+typedef struct {
+    int linhas;           ///< Número de linhas do mapa
+    int colunas;          ///< Número de colunas do mapa
+    double densidade;     ///< Probabilidade de cada célula ter uma antena (0..1)
+    int frequencias;      ///< Número de frequências distintas (1..62)
+    double enviesamento;  ///< Expoente Zipf: peso da frequência i = 1/(i+1)^s (0 = uniforme)
+    uint64_t semente;     ///< Semente do gerador pseudo-aleatório
+} ParametrosGerador;
+
+/**
+ * @brief Gera um mapa sintético e escreve-o num ficheiro
+ * 
+ * @param[in] filename Caminho do ficheiro a escrever
+ * @param[in] parametros Parâmetros de geração
+ * @return size_t Número de antenas escritas
+ * 
+ * @note Termina o programa se o ficheiro não puder ser escrito
+ */
+size_t gerarMapa(const char* filename, const ParametrosGerador* parametros);
+
+/**
+ * @brief Calcula as dimensões de um mapa quadrado com cerca de n antenas
+ * 
+ * @param[in] antenas Número de antenas pretendido
+ * @param[in,out] parametros Parâmetros cuja densidade é usada e cujas
+ *                           linhas/colunas são preenchidas
+ */
+void dimensionarMapa(size_t antenas, ParametrosGerador* parametros);
+
+ #endif // GERADOR_H
@@ -0,0 +1,145 @@
+/**
+ * @file arena.h
+ * @brief Alocador por blocos (arena) para nós de antenas e efeitos
+ * 
+ * @details Evita uma chamada a malloc por nó:
+ * - Os nós são retirados de blocos contíguos que crescem geometricamente
+ * - Os nós removidos voltam para uma lista de livres e são reutilizados
+ * - Uma lista inteira (ou um conjunto de efeitos) é libertada de uma só vez
+ *   ao reiniciar ou libertar a arena que a contém
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef ARENA_H
+ #define ARENA_H
+
+ #include <stddef.h>
+ #include "funcoes.h"
+
+/**
+ * @brief Número de nós do primeiro bloco quando não é indicado
+ */
+ #define ARENA_BLOCO_INICIAL 256
+
+/**
+ * @brief Número máximo de nós por bloco (limita o crescimento geométrico)
+ */
+ #define ARENA_BLOCO_MAXIMO (1u << 20)
+
+/**
+ * @brief Bloco contíguo de nós
+ */
+typedef struct BlocoAntenas {
+    struct BlocoAntenas* prox; ///< Bloco alocado anteriormente
+    size_t capacidade;         ///< Número de nós do bloco
+    size_t usados;             ///< Nós já entregues a partir deste bloco
+    Antena nos[];              ///< Armazenamento dos nós
+} BlocoAntenas;
+
+/**
+ * @brief Arena de nós com lista de livres
+ * 
+ * @warning Os nós de uma arena nunca devem ser passados a free(), nem a
+ *          funções que o fazem (removerAntena, removerAntenasEmEfeitos);
+ *          usar as variantes arena* declaradas neste ficheiro
+ */
+typedef struct ArenaAntenas {
+    BlocoAntenas* blocos;      ///< Bloco atual (cabeça da lista de blocos)
+    Antena* livres;            ///< Nós devolvidos, ligados pelo campo prox
+    size_t proximaCapacidade;  ///< Capacidade do próximo bloco a alocar
+    size_t ativos;             ///< Número de nós atualmente em uso
+} ArenaAntenas;
+
+/**
+ * @brief Cria uma arena vazia
+ * 
+ * @param[in] nosIniciais Capacidade do primeiro bloco (0 para o valor padrão)
+ * @return ArenaAntenas* Nova arena
+ */
+ArenaAntenas* criarArena(size_t nosIniciais);
+
+/**
+ * @brief Liberta a arena e todos os nós que contém
+ * 
+ * @param[in] arena Arena a libertar (pode ser NULL)
+ * 
+ * @note Complexidade: O(número de blocos), logarítmico no número de nós
+ */
+void libertarArena(ArenaAntenas* arena);
+
+/**
+ * @brief Descarta todos os nós da arena, mantendo o bloco maior para reutilização
+ * 
+ * @param[in] arena Arena a reiniciar
+ * 
+ * @note Todas as listas construídas na arena deixam de ser válidas
+ * @note Complexidade: O(número de blocos)
+ */
+void reiniciarArena(ArenaAntenas* arena);
+
+/**
+ * @brief Cria uma nova antena a partir da arena
+ * 
+ * @param[in] arena Arena de origem
+ * @param[in] frequencia Carácter identificador da frequência
+ * @param[in] x Posição horizontal no mapa (0-based)
+ * @param[in] y Posição vertical no mapa (0-based)
+ * @return Antena* Nó inicializado com prox a NULL
+ * 
+ * @note Reutiliza primeiro os nós da lista de livres
+ */
+Antena* arenaCriarAntena(ArenaAntenas* arena, char frequencia, int x, int y);
+
+/**
+ * @brief Devolve um nó à lista de livres da arena
+ * 
+ * @param[in] arena Arena de origem do nó
+ * @param[in] no Nó a devolver (já desligado da sua lista)
+ */
+void arenaLibertarAntena(ArenaAntenas* arena, Antena* no);
+
+/**
+ * @brief Equivalente a inserirAntena com o nó retirado da arena
+ * 
+ * @param[in] arena Arena de origem dos nós da lista
+ * @param[in] head Cabeça da lista
+ * @param[in] frequencia Carácter da frequência
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return Antena* Nova cabeça da lista
+ */
+Antena* arenaInserirAntena(ArenaAntenas* arena, Antena* head, char frequencia, int x, int y);
+
+/**
+ * @brief Equivalente a removerAntena, devolvendo o nó à arena
+ * 
+ * @param[in] arena Arena de origem dos nós da lista
+ * @param[in] head Cabeça da lista
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return Antena* Nova cabeça da lista
+ */
+Antena* arenaRemoverAntena(ArenaAntenas* arena, Antena* head, int x, int y);
+
+/**
+ * @brief Equivalente a calcularEfeitoNefasto com os nós '#' retirados da arena
+ * 
+ * @param[in] arena Arena onde é construída a lista de efeitos
+ * @param[in] lista Lista de antenas
+ * @param[in] mapa Dimensões do mapa (NULL para não limitar os efeitos)
+ * @return Antena* Lista de efeitos nefastos
+ * 
+ * @note Ao recalcular repetidamente, reiniciarArena descarta o conjunto
+ *       anterior sem percorrer a lista
+ */
+Antena* calcularEfeitoNefastoNaArena(ArenaAntenas* arena, Antena* lista, const Mapa* mapa);
+
+ #endif // ARENA_H
@@ -0,0 +1,166 @@
+/**
+ * @file cenario.h
+ * @brief Cenários ramificáveis de antenas e efeitos com cópia na escrita
+ *
+ * @details Cada cenário é uma cadeia de camadas de alterações sobre um
+ * EstadoEfeitos base partilhado:
+ * - Cada camada guarda, por célula alterada, a antena que lá fica (ou a sua
+ *   remoção) e a variação da contagem de efeitos
+ * - Ramificar congela a camada de topo e dá a cada ramo uma camada nova e
+ *   vazia por cima dela: O(1), sem copiar antenas nem efeitos
+ * - As camadas congeladas são partilhadas e libertadas por contagem de
+ *   referências quando o último ramo que as usa é descartado
+ *
+ * Um cenário ocupa assim memória proporcional às suas alterações, e uma
+ * consulta percorre as camadas até encontrar a célula (O(profundidade)).
+ * As edições seguem estadoInserirAntena/estadoRemoverAntena, mas cada
+ * antena visitada é procurada em todas as camadas: O((n + m) * profundidade),
+ * com n antenas base e m células alteradas em todas as camadas (as antenas
+ * do grupo para os pares, todas para os pares bloqueados).
+ *
+ * A profundidade é limitada a cada edição ou ramificação: uma camada
+ * congelada que só o topo ainda usa é fundida nele, e uma cadeia mais
+ * funda do que CENARIO_PROFUNDIDADE_MAXIMA é achatada numa camada privada.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef CENARIO_H
+ #define CENARIO_H
+
+ #include <stddef.h>
+ #include "incremental.h"
+
+/**
+ * @brief Número máximo de camadas por baixo do topo de um cenário
+ *
+ * @note Acima disto, a edição ou ramificação seguinte copia as alterações
+ *       visíveis para uma camada privada: O(m), amortizado pelas
+ *       ramificações que fizeram a cadeia crescer
+ */
+ #define CENARIO_PROFUNDIDADE_MAXIMA 16
+
+/**
+ * @brief Camada de alterações (definida em cenario.c)
+ */
+typedef struct Camada Camada;
+
+/**
+ * @brief Ramo de cenário: uma camada privada sobre camadas congeladas
+ */
+typedef struct Cenario {
+    Camada* topo; ///< Camada onde são escritas as edições deste ramo
+} Cenario;
+
+/**
+ * @brief Diferenças entre dois cenários, em listas ordenadas por (x,y)
+ *
+ * @note Uma antena que muda de frequência aparece nas duas listas de antenas
+ */
+typedef struct DiferencaCenarios {
+    Antena* antenasSoEmA; ///< Antenas presentes em A e não em B
+    Antena* antenasSoEmB; ///< Antenas presentes em B e não em A
+    Antena* efeitosSoEmA; ///< Efeitos '#' presentes em A e não em B
+    Antena* efeitosSoEmB; ///< Efeitos '#' presentes em B e não em A
+} DiferencaCenarios;
+
+/**
+ * @brief Cria o cenário raiz sobre um estado existente
+ *
+ * @param[in] base Estado base (passa a pertencer aos cenários)
+ * @return Cenario* Novo cenário, sem alterações
+ *
+ * @note O estado base não pode ser alterado diretamente a partir daqui e é
+ *       libertado com o último cenário que o usa
+ */
+Cenario* criarCenario(EstadoEfeitos* base);
+
+/**
+ * @brief Cria um ramo com o estado atual de um cenário
+ *
+ * @param[in] cenario Cenário de origem
+ * @return Cenario* Novo ramo, independente da origem a partir daqui
+ *
+ * @note Complexidade: O(1), salvo quando a compactação da origem funde ou
+ *       achata camadas (ver CENARIO_PROFUNDIDADE_MAXIMA); as edições
+ *       seguintes de qualquer dos dois ramos não são vistas pelo outro
+ * @note Cada ramificação acrescenta uma camada às consultas e às edições de
+ *       ambos os ramos enquanto os dois existirem
+ */
+Cenario* ramificarCenario(Cenario* cenario);
+
+/**
+ * @brief Descarta um ramo e as camadas que só ele usava
+ *
+ * @param[in] cenario Cenário a libertar (pode ser NULL)
+ */
+void libertarCenario(Cenario* cenario);
+
+/**
+ * @brief Insere uma antena no cenário e atualiza os efeitos
+ *
+ * @param[in] cenario Cenário a editar
+ * @param[in] frequencia Carácter da frequência
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se inserida, 0 se (x,y) já estava ocupada
+ */
+int cenarioInserirAntena(Cenario* cenario, char frequencia, int x, int y);
+
+/**
+ * @brief Remove uma antena do cenário e atualiza os efeitos
+ *
+ * @param[in] cenario Cenário a editar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se removida, 0 se não existia
+ */
+int cenarioRemoverAntena(Cenario* cenario, int x, int y);
+
+/**
+ * @brief Devolve a frequência da antena numa célula do cenário
+ *
+ * @param[in] cenario Cenário a consultar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return char Frequência da antena, ou '\0' se a célula estiver livre
+ */
+char cenarioAntena(const Cenario* cenario, int x, int y);
+
+/**
+ * @brief Verifica se uma célula tem efeito nefasto no cenário
+ *
+ * @param[in] cenario Cenário a consultar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se existir efeito, 0 caso contrário
+ */
+int cenarioTemEfeito(const Cenario* cenario, int x, int y);
+
+/**
+ * @brief Compara as antenas e os efeitos de dois cenários
+ *
+ * @param[in] a Primeiro cenário
+ * @param[in] b Segundo cenário (com o mesmo estado base que a)
+ * @return DiferencaCenarios Listas de diferenças (libertar com libertarDiferenca)
+ *
+ * @note Só são visitadas as células alteradas desde o antepassado comum
+ *       dos dois ramos
+ */
+DiferencaCenarios diferencaCenarios(const Cenario* a, const Cenario* b);
+
+/**
+ * @brief Liberta as listas de uma DiferencaCenarios
+ *
+ * @param[in] diferenca Diferença a libertar
+ */
+void libertarDiferenca(DiferencaCenarios* diferenca);
+
+ #endif // CENARIO_H
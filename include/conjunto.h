@@ -0,0 +1,160 @@
+/**
+ * @file conjunto.h
+ * @brief Conjunto contíguo de antenas em estrutura de vetores (SoA)
+ * 
+ * @details Alternativa à lista ligada Antena para percursos intensivos:
+ * - Coordenadas e frequências guardadas em vetores separados x[], y[], frequencia[]
+ * - Elementos ordenados por (frequência, x, y), formando grupos contíguos
+ *   por frequência cujos limites são mantidos em inicio[]
+ * - Índice de coordenadas para consultas e rejeição de duplicados em O(1)
+ * - Conversão de e para a lista ligada, mantendo compatíveis os chamadores atuais
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef CONJUNTO_H
+ #define CONJUNTO_H
+
+ #include <stddef.h>
+ #include "funcoes.h"
+ #include "indice.h"
+
+/**
+ * @brief Valor devolvido por procurarNoConjunto quando a coordenada não existe
+ */
+ #define CONJUNTO_NAO_ENCONTRADO ((size_t)-1)
+
+/**
+ * @brief Conjunto de antenas agrupado por frequência
+ * 
+ * @note O grupo da frequência f ocupa as posições [inicio[f], inicio[f+1])
+ *       com f convertido para unsigned char
+ */
+typedef struct AntenaSet {
+    int* x;               ///< Coordenadas horizontais (0-based)
+    int* y;               ///< Coordenadas verticais (0-based)
+    char* frequencia;     ///< Frequência de cada elemento
+    size_t tamanho;       ///< Número de elementos
+    size_t capacidade;    ///< Capacidade alocada dos vetores
+    size_t inicio[257];   ///< Início de cada grupo de frequência
+    int linhas;           ///< Número de linhas do mapa (0 se desconhecido)
+    int colunas;          ///< Número de colunas do mapa (0 se desconhecido)
+    IndiceCoord* ocupadas;///< Índice das coordenadas presentes
+} AntenaSet;
+
+/**
+ * @brief Cria um conjunto vazio
+ * 
+ * @param[in] linhas Número de linhas do mapa (0 se desconhecido)
+ * @param[in] colunas Número de colunas do mapa (0 se desconhecido)
+ * @param[in] capacidade Número previsto de elementos
+ * @return AntenaSet* Novo conjunto
+ */
+AntenaSet* criarConjunto(int linhas, int colunas, size_t capacidade);
+
+/**
+ * @brief Liberta o conjunto e todos os seus vetores
+ * 
+ * @param[in] conjunto Conjunto a libertar (pode ser NULL)
+ */
+void libertarConjunto(AntenaSet* conjunto);
+
+/**
+ * @brief Insere uma antena mantendo a ordenação por (frequência, x, y)
+ * 
+ * @param[in] conjunto Conjunto a atualizar
+ * @param[in] frequencia Carácter da frequência
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se inserida, 0 se já existia um elemento em (x,y)
+ * 
+ * @note Complexidade: O(1) para duplicados, O(log k + n) para o deslocamento
+ */
+int inserirNoConjunto(AntenaSet* conjunto, char frequencia, int x, int y);
+
+/**
+ * @brief Remove o elemento nas coordenadas indicadas
+ * 
+ * @param[in] conjunto Conjunto a atualizar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se removido, 0 se não existia
+ */
+int removerDoConjunto(AntenaSet* conjunto, int x, int y);
+
+/**
+ * @brief Verifica se existe um elemento nas coordenadas indicadas
+ * 
+ * @param[in] conjunto Conjunto a consultar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se existir, 0 caso contrário
+ * 
+ * @note Complexidade: O(1)
+ */
+int existeNoConjunto(const AntenaSet* conjunto, int x, int y);
+
+/**
+ * @brief Devolve a posição do elemento nas coordenadas indicadas
+ * 
+ * @param[in] conjunto Conjunto a consultar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return size_t Posição nos vetores ou CONJUNTO_NAO_ENCONTRADO
+ * 
+ * @note Pesquisa binária em cada grupo de frequência não vazio
+ */
+size_t procurarNoConjunto(const AntenaSet* conjunto, int x, int y);
+
+/**
+ * @brief Devolve a posição de (x,y) dentro do grupo de uma frequência
+ * 
+ * @param[in] conjunto Conjunto a consultar
+ * @param[in] frequencia Frequência do grupo
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return size_t Posição nos vetores ou CONJUNTO_NAO_ENCONTRADO
+ * 
+ * @note Complexidade: O(log k) para um grupo de tamanho k
+ */
+size_t procurarNoGrupo(const AntenaSet* conjunto, char frequencia, int x, int y);
+
+/**
+ * @brief Calcula os efeitos nefastos do conjunto
+ * 
+ * @param[in] conjunto Conjunto de antenas
+ * @return AntenaSet* Novo conjunto com os pontos '#'
+ * 
+ * @details Mesmas regras de calcularEfeitoNefasto; os pontos fora de
+ * [0,colunas) x [0,linhas) são descartados quando as dimensões são conhecidas.
+ */
+AntenaSet* calcularEfeitoNefastoConjunto(const AntenaSet* conjunto);
+
+/**
+ * @brief Constrói um conjunto a partir de uma lista ligada
+ * 
+ * @param[in] lista Lista de antenas ordenada por (x,y)
+ * @param[in] linhas Número de linhas do mapa (0 se desconhecido)
+ * @param[in] colunas Número de colunas do mapa (0 se desconhecido)
+ * @return AntenaSet* Novo conjunto
+ * 
+ * @note Complexidade: O(n) (counting sort estável por frequência)
+ */
+AntenaSet* conjuntoDeLista(Antena* lista, int linhas, int colunas);
+
+/**
+ * @brief Constrói uma lista ligada ordenada por (x,y) a partir do conjunto
+ * 
+ * @param[in] conjunto Conjunto de origem
+ * @return Antena* Nova lista (libertar com libertarLista)
+ */
+Antena* conjuntoParaLista(const AntenaSet* conjunto);
+
+ #endif // CONJUNTO_H
@@ -0,0 +1,131 @@
+/**
+ * @file consulta.h
+ * @brief Consultas preguiçosas de efeitos por região e por frequência
+ *
+ * @details Em vez de calcular todos os efeitos do mapa, uma consulta indica
+ * as frequências e o retângulo pretendidos e só são avaliados os pares cujos
+ * pontos projetados podem cair nesse retângulo:
+ * - Todo o ponto de efeito é da forma 2u - v, com u, v e o ponto na mesma
+ *   linha de uma das 12 direções de alinhamento; cada frequência guarda,
+ *   por direção, as antenas ordenadas por (linha, posição), e só as linhas
+ *   que atravessam o retângulo são percorridas, com os v possíveis de cada u
+ *   encontrados por pesquisa binária
+ * - O mapa é dividido em ladrilhos de CONSULTA_LADRILHO x CONSULTA_LADRILHO
+ *   células e os efeitos de cada (frequência, ladrilho) ficam em cache
+ * - Alterar as antenas de uma frequência invalida todos os seus ladrilhos;
+ *   nas outras frequências só são invalidados os ladrilhos dos pares cujo
+ *   ponto projetado coincide com a célula alterada
+ *
+ * Os resultados coincidem com os de calcularEfeitoNefastoConjunto restritos
+ * ao retângulo e às frequências pedidas.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef CONSULTA_H
+ #define CONSULTA_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "conjunto.h"
+ #include "simulacao.h"
+
+/**
+ * @brief Lado, em células, de cada ladrilho da cache (potência de 2)
+ */
+ #define CONSULTA_LADRILHO 64
+
+/**
+ * @brief Número de direções de linha distintas das regras de alinhamento
+ */
+ #define CONSULTA_DIRECOES 12
+
+/**
+ * @brief Entrada da cache de ladrilhos (definida em consulta.c)
+ */
+typedef struct EntradaLadrilho EntradaLadrilho;
+
+/**
+ * @brief Índice das antenas de uma frequência por linha de alinhamento (definido em consulta.c)
+ */
+typedef struct LinhasFrequencia LinhasFrequencia;
+
+/**
+ * @brief Conjunto de antenas com a cache de efeitos por (frequência, ladrilho)
+ */
+typedef struct ConsultaEfeitos {
+    AntenaSet* conjunto;        ///< Antenas (pertencem à consulta)
+    uint64_t versoes[256];      ///< Versão das antenas de cada frequência
+    uint64_t completas[256];    ///< Versão em que todos os ladrilhos da frequência foram preenchidos (0: nenhuma)
+    LinhasFrequencia* linhas[256]; ///< Índice de linhas de cada frequência (criado na primeira consulta)
+    EntradaLadrilho* entradas;  ///< Tabela de hash dos ladrilhos calculados
+    size_t capacidade;          ///< Número de posições da tabela (potência de 2)
+    size_t usadas;              ///< Posições ocupadas
+    unsigned long long acertos; ///< Ladrilhos servidos pela cache
+    unsigned long long falhas;  ///< Ladrilhos calculados
+} ConsultaEfeitos;
+
+/**
+ * @brief Cria uma consulta sobre um conjunto de antenas
+ *
+ * @param[in] conjunto Antenas (passam a pertencer à consulta)
+ * @return ConsultaEfeitos* Nova consulta, com a cache vazia
+ */
+ConsultaEfeitos* criarConsulta(AntenaSet* conjunto);
+
+/**
+ * @brief Liberta a consulta, a cache e o conjunto de antenas
+ *
+ * @param[in] consulta Consulta a libertar (pode ser NULL)
+ */
+void libertarConsulta(ConsultaEfeitos* consulta);
+
+/**
+ * @brief Devolve os efeitos de algumas frequências dentro de um retângulo
+ *
+ * @param[in] consulta Consulta
+ * @param[in] frequencias Frequências a considerar (NULL ou "" para todas)
+ * @param[in] x0 Primeira coluna do retângulo
+ * @param[in] y0 Primeira linha do retângulo
+ * @param[in] x1 Última coluna do retângulo (inclusive)
+ * @param[in] y1 Última linha do retângulo (inclusive)
+ * @param[out] n Número de efeitos devolvidos
+ * @return Coordenada* Efeitos ordenados por (x,y), sem repetições (libertar
+ *         com free; NULL se não houver nenhum)
+ *
+ * @note Um ladrilho não guardado custa O(log k) por direção mais as antenas
+ *       das linhas que o atravessam; um ladrilho guardado custa O(efeitos).
+ *       A primeira consulta de uma frequência indexa-a em O(k log k)
+ */
+Coordenada* consultarEfeitos(ConsultaEfeitos* consulta, const char* frequencias,
+                             int x0, int y0, int x1, int y1, size_t* n);
+
+/**
+ * @brief Insere uma antena e invalida os ladrilhos afetados
+ *
+ * @param[in] consulta Consulta
+ * @param[in] frequencia Frequência da antena
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se inserida, 0 se a célula já estava ocupada
+ */
+int consultaInserirAntena(ConsultaEfeitos* consulta, char frequencia, int x, int y);
+
+/**
+ * @brief Remove uma antena e invalida os ladrilhos afetados
+ *
+ * @param[in] consulta Consulta
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se removida, 0 se não existia
+ */
+int consultaRemoverAntena(ConsultaEfeitos* consulta, int x, int y);
+
+ #endif // CONSULTA_H
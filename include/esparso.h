@@ -0,0 +1,148 @@
+/**
+ * @file esparso.h
+ * @brief Representação comprimida por linhas (CSR) de mapas esparsos
+ *
+ * @details Nos mapas reais quase todas as células são '.', e tanto a grelha
+ * densa como o formato de texto gastam trabalho e espaço em cada uma delas.
+ * Um MapaEsparso guarda apenas as células ocupadas:
+ * - As linhas com pelo menos uma célula, por ordem crescente, e para cada
+ *   uma o intervalo das suas células (índice de linhas ao estilo CSR)
+ * - As colunas de cada linha, ordenadas, com o carácter de cada célula
+ * - Verificação de ocupação por duas pesquisas binárias (linha e coluna)
+ * - Renderização de janelas que só visita as linhas e colunas da janela
+ *
+ * A memória é de 5 bytes por célula ocupada mais 12 bytes por linha não
+ * vazia, independentemente de linhas x colunas: um mapa de 100k x 100k com
+ * 1M de antenas ocupa cerca de 6 MB.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef ESPARSO_H
+ #define ESPARSO_H
+
+ #include <stdio.h>
+ #include <stddef.h>
+ #include "funcoes.h"
+ #include "conjunto.h"
+
+/**
+ * @brief Valor devolvido por procurarEsparso quando a célula está vazia
+ */
+ #define ESPARSO_NAO_ENCONTRADO ((size_t)-1)
+
+/**
+ * @brief Mapa com as células ocupadas comprimidas por linha
+ */
+typedef struct MapaEsparso {
+    int linhas;          ///< Número de linhas do mapa
+    int colunas;         ///< Número de colunas do mapa
+    int* linha;          ///< Linhas não vazias, por ordem crescente
+    size_t* inicio;      ///< Células da linha linha[r] em [inicio[r], inicio[r+1])
+    size_t numLinhas;    ///< Número de linhas não vazias
+    int* coluna;         ///< Coluna de cada célula (crescente dentro da linha)
+    char* carac;         ///< Carácter de cada célula (frequência ou '#')
+    size_t tamanho;      ///< Número de células ocupadas
+} MapaEsparso;
+
+/**
+ * @brief Cria um mapa a partir de células já ordenadas por (y,x)
+ *
+ * @param[in] linhas Número de linhas do mapa
+ * @param[in] colunas Número de colunas do mapa
+ * @param[in] coluna Coluna de cada célula (passa a pertencer ao mapa)
+ * @param[in] carac Carácter de cada célula (passa a pertencer ao mapa)
+ * @param[in] y Linha de cada célula (não é guardado)
+ * @param[in] n Número de células
+ * @return MapaEsparso* Novo mapa (libertar com libertarEsparso)
+ *
+ * @note Os vetores não são copiados; as células repetidas devem ter sido
+ *       eliminadas por quem chama
+ * @note Complexidade: O(n)
+ */
+MapaEsparso* esparsoOrdenado(int linhas, int colunas, int* coluna, char* carac, const int* y, size_t n);
+
+/**
+ * @brief Constrói um mapa a partir de uma lista ligada
+ *
+ * @param[in] lista Lista de antenas ou efeitos
+ * @param[in] linhas Número de linhas do mapa
+ * @param[in] colunas Número de colunas do mapa
+ * @return MapaEsparso* Novo mapa (libertar com libertarEsparso)
+ *
+ * @note Complexidade: O(n) (radix sort por (y,x)); numa célula repetida
+ *       fica o primeiro elemento da lista
+ */
+MapaEsparso* esparsoDeLista(Antena* lista, int linhas, int colunas);
+
+/**
+ * @brief Constrói um mapa a partir de um AntenaSet
+ *
+ * @param[in] conjunto Conjunto de origem (define as dimensões do mapa)
+ * @return MapaEsparso* Novo mapa (libertar com libertarEsparso)
+ */
+MapaEsparso* esparsoDeConjunto(const AntenaSet* conjunto);
+
+/**
+ * @brief Converte um mapa para um AntenaSet agrupado por frequência
+ *
+ * @param[in] mapa Mapa de origem
+ * @return AntenaSet* Novo conjunto (libertar com libertarConjunto)
+ *
+ * @note Permite calcular efeitos e exportar snapshots sem grelha densa
+ * @note Complexidade: O(n)
+ */
+AntenaSet* conjuntoDeEsparso(const MapaEsparso* mapa);
+
+/**
+ * @brief Liberta o mapa e os seus vetores
+ *
+ * @param[in] mapa Mapa a libertar (pode ser NULL)
+ */
+void libertarEsparso(MapaEsparso* mapa);
+
+/**
+ * @brief Devolve a posição de uma célula no mapa
+ *
+ * @param[in] mapa Mapa a consultar
+ * @param[in] x Coordenada X
+ * @param[in] y Coordenada Y
+ * @return size_t Posição nos vetores coluna/carac ou ESPARSO_NAO_ENCONTRADO
+ *
+ * @note Complexidade: O(log linhas não vazias + log células da linha)
+ */
+size_t procurarEsparso(const MapaEsparso* mapa, int x, int y);
+
+/**
+ * @brief Memória ocupada pelo mapa, em bytes
+ *
+ * @param[in] mapa Mapa
+ * @return size_t Bytes da estrutura e dos vetores
+ */
+size_t memoriaEsparso(const MapaEsparso* mapa);
+
+/**
+ * @brief Desenha uma janela do mapa a partir de mapas esparsos
+ *
+ * @param[in] saida Ficheiro de destino
+ * @param[in] antenas Antenas (podem ser NULL)
+ * @param[in] efeitos Efeitos (podem ser NULL)
+ * @param[in] x0 Primeira coluna da janela
+ * @param[in] y0 Primeira linha da janela
+ * @param[in] largura Número de colunas da janela
+ * @param[in] altura Número de linhas da janela
+ *
+ * @note Mesmo resultado que imprimirJanela; cada linha da janela custa uma
+ *       pesquisa binária mais as células dentro da janela
+ */
+void imprimirJanelaEsparsa(FILE* saida, const MapaEsparso* antenas, const MapaEsparso* efeitos,
+                           int x0, int y0, int largura, int altura);
+
+ #endif // ESPARSO_H
@@ -0,0 +1,126 @@
+/**
+ * @file estatisticas.h
+ * @brief Contadores dos caminhos críticos e tempos por fase
+ *
+ * @details Contadores globais incrementados pelos motores de efeitos e
+ * pelas operações sobre listas:
+ * - Pares possíveis, pares comparados (mesma frequência) e pares alinhados
+ * - Verificações de colisão e efeitos emitidos antes/depois da deduplicação
+ * - Nós percorridos nas pesquisas lineares e antenas criadas com malloc
+ * - Tempo de relógio de cada fase registada com ESTAT_FASE
+ *
+ * Os contadores são acumulados em variáveis locais dentro dos ciclos e
+ * somados ao total uma vez por chamada; as threads que correm motores em
+ * simultâneo somam em contadores próprios, juntos no fim. Compilar com -DEDA_SEM_ESTATISTICAS
+ * remove-os por completo (as macros passam a não gerar código).
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef ESTATISTICAS_H
+ #define ESTATISTICAS_H
+
+ #include <stdio.h>
+
+/**
+ * @brief Número máximo de fases com tempo registado
+ */
+ #define ESTAT_MAX_FASES 32
+
+/**
+ * @brief Totais acumulados desde o início do programa (ou do último reinício)
+ */
+typedef struct Estatisticas {
+    unsigned long long paresPossiveis;       ///< n(n-1)/2: pares que uma comparação exaustiva avaliaria
+    unsigned long long paresComparados;      ///< Pares da mesma frequência sujeitos ao teste de alinhamento
+    unsigned long long paresAlinhados;       ///< Pares que passaram o teste de alinhamento
+    unsigned long long verificacoesColisao;  ///< Pontos projetados sujeitos à verificação de ocupação
+    unsigned long long efeitosEmitidos;      ///< Pontos de efeito produzidos (com repetições)
+    unsigned long long efeitosUnicos;        ///< Pontos de efeito após deduplicação
+    unsigned long long nosPercorridos;       ///< Nós visitados por existeNaLista/inserirAntena/ligarOrdenado
+    unsigned long long antenasCriadas;       ///< Nós alocados por criarAntena
+    int numFases;                            ///< Número de fases registadas
+    const char* nomeFase[ESTAT_MAX_FASES];   ///< Nome de cada fase
+    double segundosFase[ESTAT_MAX_FASES];    ///< Tempo de relógio de cada fase
+} Estatisticas;
+
+/**
+ * @brief Totais globais
+ *
+ * @note Apenas os motores sequenciais escrevem diretamente; o motor
+ *       paralelo soma os contadores das threads depois de as juntar
+ */
+extern Estatisticas estatisticas;
+
+/**
+ * @brief Contadores da thread atual (NULL: os totais globais)
+ *
+ * @note Uma thread que chama os motores em paralelo com outras desvia os
+ *       seus contadores com desviarEstatisticas; quem a criou soma-os com
+ *       juntarEstatisticas depois de a juntar
+ */
+extern _Thread_local Estatisticas* estatisticasDaThread;
+
+ #ifndef EDA_SEM_ESTATISTICAS
+ #define ESTAT_ATIVAS 1
+/**
+ * @brief Soma n ao contador indicado
+ */
+ #define ESTAT_SOMAR(campo, n) \
+    ((estatisticasDaThread != NULL ? estatisticasDaThread : &estatisticas)->campo += (unsigned long long)(n))
+/**
+ * @brief Termina a fase em curso (se existir) e inicia uma nova (NULL para só terminar)
+ */
+ #define ESTAT_FASE(nome) registarFase(nome)
+ #else
+ #define ESTAT_ATIVAS 0
+ #define ESTAT_SOMAR(campo, n) ((void)(n))
+ #define ESTAT_FASE(nome) ((void)0)
+ #endif
+
+/**
+ * @brief Termina a fase em curso e inicia uma nova
+ *
+ * @param[in] nome Nome da nova fase (literal), ou NULL para só terminar
+ *
+ * @note Fases além de ESTAT_MAX_FASES são ignoradas
+ */
+void registarFase(const char* nome);
+
+/**
+ * @brief Passa a somar os contadores da thread atual noutro destino
+ *
+ * @param[in] destino Contadores da thread (NULL para voltar aos globais)
+ */
+void desviarEstatisticas(Estatisticas* destino);
+
+/**
+ * @brief Soma aos totais globais os contadores de uma thread já terminada
+ *
+ * @param[in] parciais Contadores preenchidos através de desviarEstatisticas
+ *
+ * @note Só deve ser chamada sem outras threads a escrever nos totais
+ */
+void juntarEstatisticas(const Estatisticas* parciais);
+
+/**
+ * @brief Põe todos os contadores e fases a zero
+ */
+void reiniciarEstatisticas(void);
+
+/**
+ * @brief Escreve os totais numa tabela legível ou em JSON
+ *
+ * @param[in] saida Ficheiro de destino (ex.: stderr)
+ * @param[in] json 1 para JSON (um objeto numa linha), 0 para tabela
+ */
+void imprimirEstatisticas(FILE* saida, int json);
+
+ #endif // ESTATISTICAS_H
@@ -0,0 +1,81 @@
+/**
+ * @file faixas.h
+ * @brief Cálculo dos efeitos nefastos fora de memória, por faixas de colunas
+ *
+ * @details Para mapas maiores do que a memória disponível:
+ * - O ficheiro é lido em blocos, sem nunca guardar o mapa inteiro; as
+ *   antenas vão para um resumo por frequência que é despejado em ficheiros
+ *   temporários quando excede metade do orçamento de memória
+ * - Os pares de cada grupo são avaliados em blocos que cabem no orçamento
+ *   e cada par alinhado é escrito no balde da faixa do seu primeiro ponto
+ * - Um par só é válido se nenhum dos dois pontos estiver ocupado, e esses
+ *   pontos podem cair em faixas diferentes: cada faixa confirma o primeiro
+ *   ponto contra as suas antenas e reencaminha o par para a faixa do
+ *   segundo ponto, que o confirma por sua vez
+ * - Os efeitos dos pares válidos são ordenados e deduplicados faixa a
+ *   faixa e escritos como um fluxo "x y" ordenado por (x,y)
+ *
+ * Só o índice das antenas de uma faixa e um bloco de cada grupo têm de
+ * caber em memória; o resto passa por ficheiros temporários (tmpfile).
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef FAIXAS_H
+ #define FAIXAS_H
+
+ #include <stdio.h>
+ #include <stddef.h>
+
+/**
+ * @brief Orçamento de memória usado quando não é indicado nenhum
+ */
+ #define FAIXAS_MEMORIA_OMISSAO ((size_t)256 << 20)
+
+/**
+ * @brief Número máximo de faixas
+ */
+ #define FAIXAS_MAXIMO 256
+
+/**
+ * @brief Ficheiros temporários que podem estar abertos ao mesmo tempo
+ *
+ * @details Cada faixa tem até quatro ficheiros abertos (antenas, pares por
+ * confirmar em cada ponto e efeitos) e cada frequência despejada tem um; o
+ * número de faixas é reduzido para o total caber neste limite, abaixo dos
+ * 512 descritores por omissão do MSVCRT e de "ulimit -n 512".
+ */
+ #define FAIXAS_FICHEIROS_MAXIMO 400
+
+/**
+ * @brief Ficheiros reservados para as divisões ao meio da escrita dos efeitos
+ */
+ #define FAIXAS_FICHEIROS_RESERVA 64
+
+/**
+ * @brief Tamanho de cada bloco lido do ficheiro do mapa
+ */
+ #define FAIXAS_BLOCO_LEITURA (1 << 22)
+
+/**
+ * @brief Calcula os efeitos nefastos de um mapa sem o carregar em memória
+ *
+ * @param[in] filename Caminho do ficheiro do mapa (mesmo formato que carregarAntenasDoMapa)
+ * @param[in] saida Ficheiro onde é escrita uma linha "x y" por efeito, ordenada por (x,y)
+ * @param[in] memoria Orçamento de memória em bytes (0 para FAIXAS_MEMORIA_OMISSAO)
+ * @return long long Número de efeitos escritos, ou -1 se o mapa não puder ser lido
+ *
+ * @note O resultado é o mesmo que o de calcularEfeitoNefasto sobre o mapa completo
+ * @note Os ficheiros temporários são criados com tmpfile e apagados no fim;
+ *       nunca há mais de FAIXAS_FICHEIROS_MAXIMO abertos
+ */
+long long calcularEfeitosPorFaixas(const char* filename, FILE* saida, size_t memoria);
+
+ #endif // FAIXAS_H
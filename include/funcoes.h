@@ -21,6 +21,10 @@
 
  #ifndef FUNCOES_H
  #define FUNCOES_H
+
+ #include <stddef.h>
+
+ struct IndiceCoord;
  
 /**
  * @brief Estrutura que representa uma antena ou localização com efeito nefasto
@@ -40,6 +44,21 @@ typedef struct Antena {
     int y;               ///< Coordenada vertical (linha) no mapa (0-based)
     struct Antena *prox; ///< Apontador para o próximo elemento na lista
 } Antena;
+
+/**
+ * @brief Dimensões do mapa sobre o qual são calculados os efeitos
+ * 
+ * @details Preenchido a partir dos valores devolvidos por
+ * carregarAntenasDoMapa. Um valor não positivo numa das dimensões (ou um
+ * apontador NULL para o mapa) significa que o mapa é ilimitado nesse eixo.
+ * 
+ * @note As coordenadas são int, pelo que o mapa pode ter até 2^31 células
+ *       de lado; os cálculos intermédios são feitos em 64 bits
+ */
+typedef struct Mapa {
+    int linhas;  ///< Número de linhas (limite exclusivo de y)
+    int colunas; ///< Número de colunas (limite exclusivo de x)
+} Mapa;
  
 /**
  * @brief Cria uma nova antena alocada dinamicamente
@@ -65,6 +84,17 @@ Antena* criarAntena(char frequencia, int x, int y);
  * @note Não permite duplicação por coordenadas (x,y)
  */
 Antena* inserirAntena(Antena* head, char frequencia, int x, int y);
+
+/**
+ * @brief Liga um nó já criado à lista, na posição ordenada
+ * 
+ * @param[in] head Apontador para o primeiro elemento da lista
+ * @param[in] nova Nó a ligar (o campo prox é reescrito)
+ * @return Antena* Novo início da lista
+ * 
+ * @note Não verifica duplicados; o chamador deve garantir que (x,y) não existe
+ */
+Antena* ligarOrdenado(Antena* head, Antena* nova);
  
 /**
  * @brief Remove uma antena específica da lista
@@ -87,9 +117,54 @@ Antena* removerAntena(Antena* head, int x, int y);
  * @return Antena* Nova lista após remoções
  * 
  * @note Remove apenas antenas normais (não remove os próprios efeitos)
+ * @note Cada remoção é relatada no terminal
  */
 Antena* removerAntenasEmEfeitos(Antena* lista, Antena* efeitos);
 
+/**
+ * @brief Função chamada para cada antena removida por filtrarAntenasEmEfeitos
+ * 
+ * @param[in] removida Antena removida (válida apenas durante a chamada)
+ * @param[in] contexto Apontador fornecido pelo chamador
+ */
+typedef void (*CallbackRemocao)(const Antena* removida, void* contexto);
+
+/**
+ * @brief Buffer fornecido pelo chamador para acumular o relatório de remoções
+ * 
+ * @note Usar com relatarNoBuffer como callback e o buffer como contexto
+ */
+typedef struct BufferRemocoes {
+    char* dados;        ///< Texto do relatório (terminado em '\0')
+    size_t capacidade;  ///< Tamanho de dados em bytes
+    size_t usado;       ///< Bytes escritos (sem contar o '\0')
+    size_t removidas;   ///< Número de antenas removidas
+    int truncado;       ///< 1 se o relatório não coube no buffer
+} BufferRemocoes;
+
+/**
+ * @brief Remove numa só passagem as antenas cujas coordenadas estão no índice de efeitos
+ * 
+ * @param[in] lista Apontador para a lista de antenas
+ * @param[in] efeitos Índice (bitmap ou hash) das localizações com efeito nefasto
+ * @param[in] relatar Callback chamado para cada remoção (NULL para modo silencioso)
+ * @param[in] contexto Apontador entregue ao callback
+ * @return Antena* Nova lista após remoções
+ * 
+ * @note Remove apenas antenas normais (não remove os próprios efeitos)
+ * @note Não escreve no terminal
+ */
+Antena* filtrarAntenasEmEfeitos(Antena* lista, const struct IndiceCoord* efeitos,
+                                CallbackRemocao relatar, void* contexto);
+
+/**
+ * @brief Callback de remoção que escreve o relatório num BufferRemocoes
+ * 
+ * @param[in] removida Antena removida
+ * @param[in] contexto Apontador para um BufferRemocoes
+ */
+void relatarNoBuffer(const Antena* removida, void* contexto);
+
 /**
  * @brief Imprime todas as antenas/efeitos da lista no terminal
  * 
@@ -111,11 +186,55 @@ void imprimirAntenas(Antena* head);
  * 
  */
 int existeNaLista(Antena* lista, int x, int y);
+
+/**
+ * @brief Liberta todos os nós de uma lista de antenas ou efeitos
+ * 
+ * @param[in] head Apontador para o primeiro elemento da lista (pode ser NULL)
+ * 
+ * @note Apenas para listas criadas com criarAntena; listas construídas numa
+ *       arena são libertadas com reiniciarArena/libertarArena (ver arena.h)
+ */
+void libertarLista(Antena* head);
+ 
+/**
+ * @brief Verifica se duas antenas separadas por (dx,dy) estão alinhadas
+ * 
+ * @param[in] dx Diferença horizontal (x2 - x1)
+ * @param[in] dy Diferença vertical (y2 - y1)
+ * @return int 1 se o alinhamento é horizontal, vertical, diagonal ou de
+ *         declive 1:2, 2:1, 1:3, 3:1; 0 caso contrário
+ * 
+ * @see regras.h para outros conjuntos de regras
+ */
+int antenasAlinhadas(long long dx, long long dy);
+
+/**
+ * @brief Verifica se um ponto calculado em 64 bits cabe nas coordenadas int
+ * 
+ * @param[in] x Coordenada horizontal
+ * @param[in] y Coordenada vertical
+ * @return int 1 se ambas as coordenadas são representáveis como int
+ */
+int coordenadaRepresentavel(long long x, long long y);
+
+/**
+ * @brief Verifica se um ponto está dentro dos limites do mapa
+ * 
+ * @param[in] mapa Dimensões do mapa (NULL para mapa ilimitado)
+ * @param[in] x Coordenada horizontal
+ * @param[in] y Coordenada vertical
+ * @return int 1 se o ponto pertence ao mapa, 0 caso contrário
+ * 
+ * @note Num eixo ilimitado apenas se exige x,y >= 0 e representável
+ */
+int pontoNoMapa(const Mapa* mapa, long long x, long long y);
  
 /**
  * @brief Calcula as localizações com efeito nefasto entre antenas alinhadas
  * 
  * @param[in] lista Apontador para a lista de antenas
+ * @param[in] mapa Dimensões do mapa (NULL para não limitar os efeitos)
  * @return Antena* Nova lista contendo apenas os pontos com efeito nefasto
  * 
  * @details Um efeito nefasto ocorre quando:
@@ -124,7 +243,9 @@ int existeNaLista(Antena* lista, int x, int y);
  * - Uma está duas vezes mais distante que a outra
  * 
  * @note Os pontos de efeito são marcados com o carácter '#'
+ * @note As antenas são agrupadas por frequência e só os pares dentro de
+ *       cada grupo são comparados
  */
-Antena* calcularEfeitoNefasto(Antena* lista);
+Antena* calcularEfeitoNefasto(Antena* lista, const Mapa* mapa);
  
 #endif // FUNCOES_H
\ No newline at end of file
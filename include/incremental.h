@@ -0,0 +1,121 @@
+/**
+ * @file incremental.h
+ * @brief Manutenção incremental do conjunto de efeitos nefastos
+ * 
+ * @details Mantém o conjunto de efeitos sempre atual enquanto as antenas
+ * são inseridas e removidas, sem recalcular todo o mapa:
+ * - Cada célula de efeito guarda o número de pares válidos que a produzem
+ *   (contagem de referências), pelo que remover um par só apaga o '#'
+ *   quando nenhum outro par o produz
+ * - Os pares da antena alterada são avaliados apenas dentro do seu grupo de
+ *   frequência (O(k) para um grupo de tamanho k)
+ * - Uma célula ocupada anula os pares (de qualquer frequência) que a têm
+ *   como ponto de efeito; esses pares são encontrados com uma consulta O(1)
+ *   por antena, sem percorrer pares
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef INCREMENTAL_H
+ #define INCREMENTAL_H
+
+ #include "funcoes.h"
+ #include "indice.h"
+ #include "conjunto.h"
+
+/**
+ * @brief Estado de antenas e efeitos mantido de forma incremental
+ */
+typedef struct EstadoEfeitos {
+    AntenaSet* antenas;      ///< Antenas agrupadas por frequência
+    ContagemCoord* efeitos;  ///< Número de pares que produzem cada efeito
+    int linhas;              ///< Número de linhas do mapa
+    int colunas;             ///< Número de colunas do mapa
+    size_t foraDoMapa;       ///< Antenas fora do mapa (com alguma, não se usam raios)
+} EstadoEfeitos;
+
+/**
+ * @brief Direções primitivas de alinhamento (horizontal, vertical, diagonal, 1:2 e 1:3)
+ *
+ * @note Todo o vetor alinhado é um múltiplo positivo de exatamente uma delas
+ */
+extern const int DIRECOES_ALINHAMENTO[24][2];
+
+/**
+ * @brief Cria o estado a partir de uma lista e calcula os efeitos iniciais
+ * 
+ * @param[in] lista Lista de antenas (não é alterada)
+ * @param[in] linhas Número de linhas do mapa
+ * @param[in] colunas Número de colunas do mapa
+ * @return EstadoEfeitos* Novo estado
+ * 
+ * @note Os efeitos fora de [0,colunas) x [0,linhas) são descartados; uma
+ *       dimensão não positiva não limita esse eixo (ver pontoNoMapa)
+ */
+EstadoEfeitos* criarEstadoEfeitos(Antena* lista, int linhas, int colunas);
+
+/**
+ * @brief Liberta o estado e todas as estruturas internas
+ * 
+ * @param[in] estado Estado a libertar (pode ser NULL)
+ */
+void libertarEstadoEfeitos(EstadoEfeitos* estado);
+
+/**
+ * @brief Insere uma antena e atualiza os efeitos
+ * 
+ * @param[in] estado Estado a atualizar
+ * @param[in] frequencia Carácter da frequência
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se inserida, 0 se (x,y) já estava ocupada
+ * 
+ * @note Complexidade: O(k) pares do grupo e o deslocamento O(n) dos vetores
+ *       do conjunto (memmove); se (x,y) já é um efeito, ou está fora do
+ *       mapa, anular os pares bloqueados custa ainda O(lado do mapa)
+ *       consultas com o mapa limitado e todas as antenas dentro dele, ou
+ *       O(n) consultas caso contrário
+ */
+int estadoInserirAntena(EstadoEfeitos* estado, char frequencia, int x, int y);
+
+/**
+ * @brief Remove uma antena e atualiza os efeitos
+ * 
+ * @param[in] estado Estado a atualizar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se removida, 0 se não existia
+ * 
+ * @note Complexidade: O(k) pares do grupo, o deslocamento O(n) dos vetores
+ *       do conjunto (memmove) e a reativação dos pares bloqueados pela
+ *       antena: O(lado do mapa) consultas com o mapa limitado e todas as
+ *       antenas dentro dele, O(n) consultas caso contrário
+ */
+int estadoRemoverAntena(EstadoEfeitos* estado, int x, int y);
+
+/**
+ * @brief Verifica se uma célula tem efeito nefasto no estado atual
+ * 
+ * @param[in] estado Estado a consultar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se existir efeito, 0 caso contrário
+ */
+int estadoTemEfeito(const EstadoEfeitos* estado, int x, int y);
+
+/**
+ * @brief Devolve os efeitos atuais como lista ordenada por (x,y)
+ * 
+ * @param[in] estado Estado a consultar
+ * @return Antena* Nova lista de efeitos '#' (libertar com libertarLista)
+ */
+Antena* estadoListaEfeitos(const EstadoEfeitos* estado);
+
+ #endif // INCREMENTAL_H
@@ -0,0 +1,209 @@
+/**
+ * @file indice.h
+ * @brief Índice de coordenadas com consulta em tempo constante
+ * 
+ * @details Conjunto de coordenadas (x,y) ocupadas, usado para substituir os
+ * percursos lineares da lista ligada nas verificações de existência:
+ * - Mapas densos usam um bitmap de ocupação com um bit por célula
+ * - Espaços de coordenadas esparsos/enormes usam uma tabela de hash com
+ *   endereçamento aberto (sondagem linear)
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef INDICE_H
+ #define INDICE_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "funcoes.h"
+
+/**
+ * @brief Razão máxima células/elementos para a qual se usa o bitmap
+ * 
+ * @details Com 1 bit por célula, o bitmap ocupa no máximo 32 bytes por
+ * elemento, comparável à tabela de hash com fator de carga 0.5.
+ */
+ #define INDICE_RACIO_DENSO 256
+
+/**
+ * @brief Representação interna escolhida para o índice
+ */
+typedef enum {
+    INDICE_BITMAP, ///< Bitmap de ocupação linhas x colunas
+    INDICE_HASH    ///< Tabela de hash com endereçamento aberto
+} ModoIndice;
+
+/**
+ * @brief Conjunto de coordenadas ocupadas
+ */
+typedef struct IndiceCoord {
+    ModoIndice modo;      ///< Representação em uso
+    int linhas;           ///< Número de linhas coberto pelo bitmap
+    int colunas;          ///< Número de colunas coberto pelo bitmap
+    size_t tamanho;       ///< Número de coordenadas presentes
+    uint8_t* bits;        ///< Bitmap de ocupação (modo INDICE_BITMAP)
+    uint64_t* chaves;     ///< Chaves (x,y) compactadas (modo INDICE_HASH)
+    uint8_t* usados;      ///< Marca de posição ocupada (modo INDICE_HASH)
+    size_t capacidade;    ///< Número de posições da tabela (potência de 2)
+} IndiceCoord;
+
+/**
+ * @brief Cria um índice vazio
+ * 
+ * @param[in] linhas Número de linhas do mapa (0 se desconhecido)
+ * @param[in] colunas Número de colunas do mapa (0 se desconhecido)
+ * @param[in] previstos Número previsto de coordenadas a guardar
+ * @return IndiceCoord* Novo índice
+ * 
+ * @note Usa bitmap quando linhas*colunas <= INDICE_RACIO_DENSO*previstos,
+ *       caso contrário usa a tabela de hash
+ */
+IndiceCoord* criarIndiceCoord(int linhas, int colunas, size_t previstos);
+
+/**
+ * @brief Cria um índice com todas as coordenadas de uma lista
+ * 
+ * @param[in] lista Lista de antenas ou efeitos
+ * @param[in] linhas Número de linhas do mapa (0 se desconhecido)
+ * @param[in] colunas Número de colunas do mapa (0 se desconhecido)
+ * @return IndiceCoord* Novo índice sincronizado com a lista
+ */
+IndiceCoord* indexarLista(Antena* lista, int linhas, int colunas);
+
+/**
+ * @brief Liberta toda a memória associada ao índice
+ * 
+ * @param[in] indice Índice a libertar (pode ser NULL)
+ */
+void libertarIndiceCoord(IndiceCoord* indice);
+
+/**
+ * @brief Verifica se uma coordenada está no índice
+ * 
+ * @param[in] indice Índice a consultar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se existir, 0 caso contrário
+ * 
+ * @note Complexidade: O(1) (esperada no modo hash)
+ */
+int existeNoIndice(const IndiceCoord* indice, int x, int y);
+
+/**
+ * @brief Acrescenta uma coordenada ao índice
+ * 
+ * @param[in] indice Índice a atualizar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se foi acrescentada, 0 se já existia
+ * 
+ * @note Uma coordenada fora do bitmap converte o índice para o modo hash
+ */
+int indiceInserir(IndiceCoord* indice, int x, int y);
+
+/**
+ * @brief Retira uma coordenada do índice
+ * 
+ * @param[in] indice Índice a atualizar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return int 1 se foi retirada, 0 se não existia
+ */
+int indiceRemover(IndiceCoord* indice, int x, int y);
+
+/**
+ * @brief Contagem por coordenada (tabela de hash com endereçamento aberto)
+ * 
+ * @details Associa a cada coordenada um contador positivo; as coordenadas
+ * cujo contador chega a zero deixam de estar na tabela.
+ */
+typedef struct ContagemCoord {
+    uint64_t* chaves;     ///< Chaves (x,y) compactadas
+    uint32_t* valores;    ///< Contadores (0 marca posição livre)
+    size_t capacidade;    ///< Número de posições da tabela (potência de 2)
+    size_t tamanho;       ///< Número de coordenadas com contador positivo
+} ContagemCoord;
+
+/**
+ * @brief Cria uma tabela de contagens vazia
+ * 
+ * @param[in] previstos Número previsto de coordenadas distintas
+ * @return ContagemCoord* Nova tabela
+ */
+ContagemCoord* criarContagemCoord(size_t previstos);
+
+/**
+ * @brief Liberta a tabela de contagens
+ * 
+ * @param[in] contagem Tabela a libertar (pode ser NULL)
+ */
+void libertarContagemCoord(ContagemCoord* contagem);
+
+/**
+ * @brief Devolve o contador associado a uma coordenada
+ * 
+ * @param[in] contagem Tabela a consultar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return uint32_t Contador (0 se ausente)
+ */
+uint32_t contagemValor(const ContagemCoord* contagem, int x, int y);
+
+/**
+ * @brief Soma delta ao contador de uma coordenada
+ * 
+ * @param[in] contagem Tabela a atualizar
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @param[in] delta Valor a somar (pode ser negativo)
+ * @return uint32_t Novo valor do contador
+ * 
+ * @note Um contador que chega a zero é retirado da tabela
+ */
+uint32_t contagemSomar(ContagemCoord* contagem, int x, int y, int delta);
+
+/**
+ * @brief Constrói uma lista ordenada por (x,y) das coordenadas com contador positivo
+ * 
+ * @param[in] contagem Tabela de origem
+ * @param[in] frequencia Carácter a atribuir aos nós (tipicamente '#')
+ * @return Antena* Nova lista (libertar com libertarLista)
+ */
+Antena* contagemParaLista(const ContagemCoord* contagem, char frequencia);
+
+/**
+ * @brief Inserção ordenada na lista mantendo o índice sincronizado
+ * 
+ * @param[in] head Cabeça da lista
+ * @param[in] indice Índice das coordenadas da lista
+ * @param[in] frequencia Carácter da frequência
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return Antena* Nova cabeça da lista
+ * 
+ * @note A verificação de duplicados é feita no índice em O(1)
+ */
+Antena* inserirAntenaIndexada(Antena* head, IndiceCoord* indice, char frequencia, int x, int y);
+
+/**
+ * @brief Remoção por coordenadas mantendo o índice sincronizado
+ * 
+ * @param[in] head Cabeça da lista
+ * @param[in] indice Índice das coordenadas da lista
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return Antena* Nova cabeça da lista
+ * 
+ * @note Coordenadas ausentes são rejeitadas em O(1) sem percorrer a lista
+ */
+Antena* removerAntenaIndexada(Antena* head, IndiceCoord* indice, int x, int y);
+
+ #endif // INDICE_H
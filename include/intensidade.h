@@ -0,0 +1,133 @@
+/**
+ * @file intensidade.h
+ * @brief Mapa de intensidade da interferência (pares e frequências por célula)
+ *
+ * @details Em vez de reduzir os efeitos a uma lista deduplicada de '#',
+ * conta diretamente, para cada célula:
+ * - O número de pares válidos que a têm como ponto de efeito
+ * - O número de frequências distintas desses pares
+ *
+ * e, para cada frequência, o total de pontos de efeito e de células
+ * atingidas. As contagens são somadas em contadores (grelha densa ou
+ * tabela de hash), sem criar nós de lista nem deduplicar.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef INTENSIDADE_H
+ #define INTENSIDADE_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "conjunto.h"
+ #include "indice.h"
+
+/**
+ * @brief Maior número de células para o qual se usa a grelha densa
+ *
+ * @details A grelha ocupa 8 bytes por célula durante o cálculo (contagem,
+ * frequências e marca da última frequência) e 6 bytes depois.
+ */
+ #define INTENSIDADE_DENSO_MAXIMO ((size_t)1 << 24)
+
+/**
+ * @brief Versão atual do formato binário do mapa de intensidade
+ */
+ #define INTENSIDADE_VERSAO 1
+
+/**
+ * @brief Contagens de interferência por célula e por frequência
+ *
+ * @note Na grelha densa a célula (x,y) está na posição y*colunas + x
+ */
+typedef struct MapaIntensidade {
+    int linhas;                      ///< Número de linhas do mapa
+    int colunas;                     ///< Número de colunas do mapa
+    int denso;                       ///< 1 se usa a grelha, 0 se usa as tabelas de hash
+    uint32_t* pares;                 ///< Grelha: pares por célula
+    uint16_t* frequencias;           ///< Grelha: frequências distintas por célula
+    ContagemCoord* paresEsparsos;    ///< Tabela: pares por célula
+    ContagemCoord* frequenciasEsparsas; ///< Tabela: frequências distintas por célula
+    unsigned long long pontosPorFrequencia[256];  ///< Pontos de efeito de cada frequência
+    unsigned long long celulasPorFrequencia[256]; ///< Células atingidas por cada frequência
+    unsigned long long totalPontos;  ///< Soma de todas as contagens
+    size_t celulas;                  ///< Células com pelo menos um par
+    uint32_t maximo;                 ///< Maior contagem de uma célula
+} MapaIntensidade;
+
+/**
+ * @brief Calcula o mapa de intensidade de um conjunto de antenas
+ *
+ * @param[in] conjunto Antenas agrupadas por frequência (com as dimensões do mapa)
+ * @return MapaIntensidade* Novo mapa (libertar com libertarIntensidade)
+ *
+ * @note Os pontos seguem o domínio de pontoNoMapa (x, y >= 0 e cada eixo
+ *       limitado só se a sua dimensão for positiva), também em mapas
+ *       ilimitados; assim, as células com contagem positiva são os efeitos
+ *       de calcularEfeitoNefasto e a contagem é a de criarEstadoEfeitos
+ *       (verificado por benchmark.exe --verificar)
+ * @note Complexidade: O(Σk²) pares, O(1) por ponto de efeito
+ */
+MapaIntensidade* calcularIntensidade(const AntenaSet* conjunto);
+
+/**
+ * @brief Liberta um mapa de intensidade
+ *
+ * @param[in] mapa Mapa a libertar (pode ser NULL)
+ */
+void libertarIntensidade(MapaIntensidade* mapa);
+
+/**
+ * @brief Número de pares válidos com ponto de efeito numa célula
+ *
+ * @param[in] mapa Mapa de intensidade
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return uint32_t Contagem (0 fora do mapa)
+ */
+uint32_t intensidadePares(const MapaIntensidade* mapa, int x, int y);
+
+/**
+ * @brief Número de frequências distintas com ponto de efeito numa célula
+ *
+ * @param[in] mapa Mapa de intensidade
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ * @return unsigned Número de frequências (0 fora do mapa)
+ */
+unsigned intensidadeFrequencias(const MapaIntensidade* mapa, int x, int y);
+
+/**
+ * @brief Exporta a contagem de pares como imagem PGM binária (P5)
+ *
+ * @param[in] mapa Mapa de intensidade (com dimensões conhecidas)
+ * @param[in] filename Caminho do ficheiro a escrever
+ * @param[in] fator Lado, em células, de cada píxel (1 para uma célula por píxel)
+ * @return int 1 em caso de sucesso, 0 em caso de erro
+ *
+ * @note Cada píxel tem o máximo do seu bloco, escalado para 0..255 face ao
+ *       máximo do mapa; qualquer contagem positiva dá pelo menos 1
+ */
+int exportarIntensidadePGM(const MapaIntensidade* mapa, const char* filename, int fator);
+
+/**
+ * @brief Exporta as células com contagem positiva num ficheiro binário
+ *
+ * @param[in] mapa Mapa de intensidade
+ * @param[in] filename Caminho do ficheiro a escrever
+ * @return int 1 em caso de sucesso, 0 em caso de erro
+ *
+ * @note Formato: cabeçalho fixo ("EDAINT", versão, ordem de bytes,
+ *       dimensões, totais por frequência) seguido dos vetores x, y, pares e
+ *       frequências das células, ordenados por (x,y) e alinhados a 8 bytes
+ */
+int exportarIntensidadeBinaria(const MapaIntensidade* mapa, const char* filename);
+
+ #endif // INTENSIDADE_H
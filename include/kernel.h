@@ -0,0 +1,115 @@
+/**
+ * @file kernel.h
+ * @brief Núcleo vetorial do teste de alinhamento entre pares de antenas
+ * 
+ * @details Avalia uma antena contra um bloco contíguo de antenas da mesma
+ * frequência (vetores x[] e y[] de um AntenaSet):
+ * - Teste de alinhamento (horizontal, vertical, diagonal, 1:2, 1:3)
+ * - Verificação dos limites do mapa para os dois pontos projetados
+ * 
+ * Existem implementações AVX2 (8 parceiros por instrução), SSE4.1 (4
+ * parceiros) e escalar; a escolha é feita em tempo de execução via CPUID.
+ * A verificação de ocupação fica a cargo do chamador, apenas para os pares
+ * alinhados devolvidos.
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef KERNEL_H
+ #define KERNEL_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+
+/**
+ * @brief Número de parceiros avaliados por chamada pelos motores de efeitos
+ */
+ #define KERNEL_BLOCO 256
+
+/**
+ * @brief Marca: o ponto (a1 - d) está dentro do mapa
+ */
+ #define KERNEL_PONTO1 1
+
+/**
+ * @brief Marca: o ponto (a2 + d) está dentro do mapa
+ */
+ #define KERNEL_PONTO2 2
+
+/**
+ * @brief Maior coordenada (em valor absoluto) aceite pelas versões vetoriais
+ * 
+ * @details As versões SSE4.1/AVX2 calculam 3·|dx| e a2 + dx em 32 bits;
+ * abaixo de 2^28 estes valores nunca excedem int. Conjuntos com
+ * coordenadas maiores usam a versão escalar, que trabalha em 64 bits.
+ */
+ #define KERNEL_COORD_MAXIMA (1 << 28)
+
+/**
+ * @brief Assinatura comum das implementações do núcleo
+ * 
+ * @param[in] xs Coordenadas X dos parceiros
+ * @param[in] ys Coordenadas Y dos parceiros
+ * @param[in] n Número de parceiros
+ * @param[in] x0 Coordenada X da antena de referência
+ * @param[in] y0 Coordenada Y da antena de referência
+ * @param[in] colunas Número de colunas do mapa (<= 0 para não limitar x)
+ * @param[in] linhas Número de linhas do mapa (<= 0 para não limitar y)
+ * @param[out] indices Posições (0..n-1) dos parceiros alinhados
+ * @param[out] pontos Marcas KERNEL_PONTO1/KERNEL_PONTO2 de cada parceiro alinhado
+ * @return size_t Número de parceiros alinhados escritos
+ * 
+ * @note indices e pontos devem ter espaço para n elementos
+ * @note Um ponto está dentro do mapa nas condições de pontoNoMapa:
+ *       coordenadas não negativas e cada eixo limitado só se a sua
+ *       dimensão for positiva
+ */
+typedef size_t (*KernelAlinhamento)(const int* xs, const int* ys, size_t n,
+                                    int x0, int y0, int colunas, int linhas,
+                                    uint32_t* indices, uint8_t* pontos);
+
+/**
+ * @brief Implementação escalar do núcleo (sempre disponível)
+ */
+size_t kernelEscalar(const int* xs, const int* ys, size_t n,
+                     int x0, int y0, int colunas, int linhas,
+                     uint32_t* indices, uint8_t* pontos);
+
+/**
+ * @brief Devolve a melhor implementação suportada pelo processador
+ * 
+ * @return KernelAlinhamento Implementação escolhida
+ * 
+ * @note A variável de ambiente EDA_KERNEL ("escalar", "sse41" ou "avx2")
+ *       força uma implementação, se suportada
+ * @note A escolha é feita uma vez (pthread_once) e pode ser pedida de
+ *       várias threads em simultâneo
+ */
+KernelAlinhamento escolherKernel(void);
+
+/**
+ * @brief Escolhe a implementação adequada às coordenadas de um conjunto
+ * 
+ * @param[in] xs Coordenadas X das antenas
+ * @param[in] ys Coordenadas Y das antenas
+ * @param[in] n Número de antenas
+ * @return KernelAlinhamento escolherKernel() se todas as coordenadas
+ *         cabem em ±KERNEL_COORD_MAXIMA, kernelEscalar caso contrário
+ */
+KernelAlinhamento escolherKernelPara(const int* xs, const int* ys, size_t n);
+
+/**
+ * @brief Nome da implementação devolvida por escolherKernel
+ * 
+ * @return const char* "avx2", "sse41" ou "escalar"
+ */
+const char* nomeKernel(void);
+
+ #endif // KERNEL_H
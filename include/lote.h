@@ -0,0 +1,127 @@
+/**
+ * @file lote.h
+ * @brief Processamento em lote de vários mapas, com as etapas em pipeline
+ *
+ * @details Cada mapa passa por três etapas, cada uma com as suas threads:
+ * - Leitura: abre o ficheiro e carrega as antenas num AntenaSet
+ * - Cálculo: calcula os efeitos nefastos (calcularEfeitoNefastoConjunto)
+ * - Escrita: escreve os efeitos num ficheiro "x y" e liberta o mapa
+ *
+ * As etapas ligam-se por filas limitadas: uma etapa mais rápida bloqueia
+ * quando a fila seguinte está cheia, pelo que o número de mapas em memória
+ * nunca passa da soma das capacidades das filas e das threads. Enquanto um
+ * mapa é lido, outro está a ser calculado e um terceiro a ser escrito.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef LOTE_H
+ #define LOTE_H
+
+ #include <stdio.h>
+ #include <stddef.h>
+
+/**
+ * @brief Número de etapas do pipeline
+ */
+ #define LOTE_ETAPAS 3
+
+/**
+ * @brief Capacidade de cada fila quando não é indicada nenhuma
+ */
+ #define LOTE_FILA_OMISSAO 4
+
+/**
+ * @brief Extensão acrescentada ao nome de cada mapa no ficheiro de efeitos
+ */
+ #define LOTE_EXTENSAO ".efeitos"
+
+/**
+ * @brief Configuração do lote
+ */
+typedef struct ParametrosLote {
+    const char* saida;   ///< Diretório dos ficheiros de efeitos (NULL: junto de cada mapa)
+    int leitores;        ///< Threads da etapa de leitura (<= 0: 1)
+    int calculadores;    ///< Threads da etapa de cálculo (<= 0: todos os processadores)
+    int escritores;      ///< Threads da etapa de escrita (<= 0: 1)
+    size_t capacidadeFila; ///< Capacidade de cada fila (0: LOTE_FILA_OMISSAO)
+} ParametrosLote;
+
+/**
+ * @brief Totais de uma etapa
+ */
+typedef struct EtapaLote {
+    const char* nome;           ///< Nome da etapa
+    int threads;                ///< Threads da etapa
+    size_t mapas;               ///< Mapas processados
+    double segundosOcupada;     ///< Soma do tempo de trabalho das threads
+    size_t filaMaxima;          ///< Maior profundidade da fila de entrada
+    double filaMedia;           ///< Profundidade média da fila de entrada, amostrada a cada entrada
+} EtapaLote;
+
+/**
+ * @brief Relatório de um lote
+ */
+typedef struct RelatorioLote {
+    size_t mapas;               ///< Mapas processados com sucesso
+    size_t falhas;              ///< Mapas que não puderam ser lidos ou escritos
+    unsigned long long antenas; ///< Total de antenas lidas
+    unsigned long long efeitos; ///< Total de efeitos escritos
+    double segundos;            ///< Tempo total de relógio
+    EtapaLote etapas[LOTE_ETAPAS]; ///< Totais de cada etapa
+} RelatorioLote;
+
+/**
+ * @brief Lista os mapas de um diretório ou de um ficheiro de manifesto
+ *
+ * @param[in] caminho Diretório (todos os ficheiros regulares, por ordem de
+ *                    nome) ou manifesto (um caminho por linha; linhas vazias
+ *                    e começadas por '#' são ignoradas)
+ * @param[out] numero Número de mapas encontrados
+ * @return char** Vetor de caminhos (libertar com libertarListaMapas), ou NULL
+ *                se o caminho não pode ser aberto
+ */
+char** listarMapas(const char* caminho, size_t* numero);
+
+/**
+ * @brief Liberta um vetor devolvido por listarMapas
+ *
+ * @param[in] mapas Vetor de caminhos (pode ser NULL)
+ * @param[in] numero Número de caminhos
+ */
+void libertarListaMapas(char** mapas, size_t numero);
+
+/**
+ * @brief Processa um lote de mapas em pipeline
+ *
+ * @param[in] mapas Caminhos dos mapas
+ * @param[in] numero Número de mapas
+ * @param[in] parametros Configuração (NULL para os valores por omissão)
+ * @return RelatorioLote Totais do lote e de cada etapa
+ *
+ * @note Um mapa que não pode ser aberto, ou cujo cabeçalho é inválido, é
+ *       contado como falha e não interrompe o lote
+ * @note Dois mapas com o mesmo ficheiro de efeitos (ex.: a/m.txt e b/m.txt
+ *       com saida definida) não se sobrepõem: o primeiro da lista é
+ *       processado e os outros contam como falha
+ * @note Cada thread soma os contadores de --stats à parte; são juntos aos
+ *       totais depois de todas as threads terminarem
+ */
+RelatorioLote processarLote(char** mapas, size_t numero, const ParametrosLote* parametros);
+
+/**
+ * @brief Escreve o relatório de um lote
+ *
+ * @param[in] saida Ficheiro de destino (ex.: stderr)
+ * @param[in] relatorio Relatório a escrever
+ */
+void imprimirRelatorioLote(FILE* saida, const RelatorioLote* relatorio);
+
+ #endif // LOTE_H
@@ -0,0 +1,48 @@
+/**
+ * @file mapeamento.h
+ * @brief Mapeamento de ficheiros em memória (mmap / MapViewOfFile)
+ * 
+ * @details Permite ler ficheiros de qualquer dimensão, incluindo maiores do
+ * que a memória disponível, sem cópias intermédias: as páginas são
+ * carregadas pelo sistema operativo à medida que são acedidas.
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef MAPEAMENTO_H
+ #define MAPEAMENTO_H
+
+ #include <stddef.h>
+
+/**
+ * @brief Ficheiro mapeado em memória, apenas para leitura
+ */
+typedef struct FicheiroMapeado {
+    const char* dados;  ///< Início do conteúdo (NULL se o ficheiro estiver vazio)
+    size_t tamanho;     ///< Tamanho do conteúdo em bytes
+} FicheiroMapeado;
+
+/**
+ * @brief Mapeia um ficheiro em memória para leitura sequencial
+ * 
+ * @param[in] filename Caminho do ficheiro
+ * @param[out] ficheiro Estrutura a preencher
+ * @return int 1 em caso de sucesso, 0 se o ficheiro não puder ser aberto
+ */
+int mapearFicheiro(const char* filename, FicheiroMapeado* ficheiro);
+
+/**
+ * @brief Desfaz o mapeamento de um ficheiro
+ * 
+ * @param[in] ficheiro Ficheiro mapeado com mapearFicheiro
+ */
+void desmapearFicheiro(FicheiroMapeado* ficheiro);
+
+ #endif // MAPEAMENTO_H
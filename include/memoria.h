@@ -0,0 +1,107 @@
+/**
+ * @file memoria.h
+ * @brief Alocação com saída em caso de erro e chaves (x,y) de 64 bits
+ *
+ * @details Rotinas partilhadas pelos vários módulos:
+ * - Reserva e redimensionamento de vetores que terminam o programa se
+ *   faltar memória
+ * - Chave de 64 bits de (x,y) cuja ordem sem sinal é a ordem (x,y), também
+ *   com coordenadas negativas, e a sua dispersão para tabelas de hash
+ * - Radix sort estável de chaves de 64 bits, opcionalmente acompanhadas
+ *   das posições de origem
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef MEMORIA_H
+ #define MEMORIA_H
+
+ #include <stddef.h>
+ #include <stdint.h>
+
+/**
+ * @brief Redimensiona um vetor ou termina o programa
+ *
+ * @param[in] p Vetor atual (NULL para reservar um novo)
+ * @param[in] n Número de elementos (0 reserva um elemento)
+ * @param[in] tamanho Tamanho de cada elemento em bytes
+ * @return void* Vetor com espaço para n elementos (nunca NULL)
+ */
+void* realocar(void* p, size_t n, size_t tamanho);
+
+/**
+ * @brief Reserva um vetor inicializado a zeros ou termina o programa
+ *
+ * @param[in] n Número de elementos (0 reserva um elemento)
+ * @param[in] tamanho Tamanho de cada elemento em bytes
+ * @return void* Novo vetor (nunca NULL)
+ */
+void* alocarZeros(size_t n, size_t tamanho);
+
+/**
+ * @brief Chave de 64 bits cuja ordem sem sinal coincide com a ordem (x,y)
+ *
+ * @param[in] x Coordenada X
+ * @param[in] y Coordenada Y
+ * @return uint64_t x e y com o bit de sinal invertido, x nos 32 bits altos
+ *
+ * @note As funções de chaves estão no cabeçalho para serem expandidas nos
+ *       ciclos internos das tabelas de hash e dos motores
+ */
+static inline uint64_t chaveOrdenada(int x, int y) {
+    return ((uint64_t)((uint32_t)x ^ 0x80000000u) << 32) | ((uint32_t)y ^ 0x80000000u);
+}
+
+/**
+ * @brief Coordenada X de uma chave criada por chaveOrdenada
+ */
+static inline int xDaChave(uint64_t chave) {
+    return (int)((uint32_t)(chave >> 32) ^ 0x80000000u);
+}
+
+/**
+ * @brief Coordenada Y de uma chave criada por chaveOrdenada
+ */
+static inline int yDaChave(uint64_t chave) {
+    return (int)((uint32_t)chave ^ 0x80000000u);
+}
+
+/**
+ * @brief Dispersão de uma chave para tabelas de hash (finalizador do splitmix64)
+ */
+static inline size_t dispersarChave(uint64_t chave) {
+    chave ^= chave >> 30;
+    chave *= 0xbf58476d1ce4e5b9ULL;
+    chave ^= chave >> 27;
+    chave *= 0x94d049bb133111ebULL;
+    chave ^= chave >> 31;
+    return (size_t)chave;
+}
+
+/**
+ * @brief Comparação de chaves de 64 bits sem sinal para qsort
+ *
+ * @note Serve também para vetores de estruturas cujo primeiro campo é a chave
+ */
+int compararChaves(const void* a, const void* b);
+
+/**
+ * @brief Ordena chaves de 64 bits (radix sort estável, dígitos de 8 bits)
+ *
+ * @param[in,out] chaves Chaves (ficam ordenadas)
+ * @param[in,out] posicoes Posições que acompanham as chaves (pode ser NULL)
+ * @param[in] n Número de elementos
+ *
+ * @note Os dígitos iguais em todas as chaves não dão origem a passagem
+ * @note Complexidade: O(n) por passagem, no máximo 8 passagens
+ */
+void ordenarPorChave(uint64_t* chaves, size_t* posicoes, size_t n);
+
+ #endif // MEMORIA_H
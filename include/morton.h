@@ -0,0 +1,161 @@
+/**
+ * @file morton.h
+ * @brief Armazenamento de antenas e efeitos por ordem Z (Morton)
+ *
+ * @details Alternativa opcional às listas ordenadas por (x,y), que são
+ * por colunas enquanto o carregamento e a renderização são por linhas:
+ * - Cada célula é guardada como uma chave de 64 bits com os bits de x e y
+ *   intercalados, num vetor contíguo ordenado; células vizinhas no mapa
+ *   ficam, na maioria, próximas na memória
+ * - Consulta por retângulo: as chaves fora do retângulo são saltadas com o
+ *   cálculo do BIGMIN (Tropf e Herzog), sem percorrer o resto do conjunto
+ * - Percurso por linhas ou por colunas, por radix sort das posições
+ * - Verificação de ocupação por pesquisa binária
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef MORTON_H
+ #define MORTON_H
+
+ #include <stdio.h>
+ #include <stddef.h>
+ #include <stdint.h>
+ #include "funcoes.h"
+ #include "conjunto.h"
+
+/**
+ * @brief Valor devolvido por procurarMorton quando a coordenada não existe
+ */
+ #define MORTON_NAO_ENCONTRADO ((size_t)-1)
+
+/**
+ * @brief Percurso por linhas: (y, depois x)
+ */
+ #define MORTON_POR_LINHAS 0
+
+/**
+ * @brief Percurso por colunas: (x, depois y)
+ */
+ #define MORTON_POR_COLUNAS 1
+
+/**
+ * @brief Conjunto de células ordenado pela chave de Morton
+ */
+typedef struct ConjuntoMorton {
+    uint64_t* chaves;   ///< Chaves ordenadas (ver chaveMorton)
+    char* frequencia;   ///< Frequência (ou '#') de cada célula
+    size_t tamanho;     ///< Número de células
+} ConjuntoMorton;
+
+/**
+ * @brief Chave de Morton de uma célula
+ *
+ * @param[in] x Coordenada X
+ * @param[in] y Coordenada Y
+ * @return uint64_t Bits de x nas posições pares e de y nas ímpares
+ *
+ * @note As coordenadas são deslocadas de 2^31, pelo que a ordem das chaves
+ *       também é válida para coordenadas negativas
+ */
+uint64_t chaveMorton(int x, int y);
+
+/**
+ * @brief Coordenadas de uma chave de Morton
+ *
+ * @param[in] chave Chave devolvida por chaveMorton
+ * @param[out] x Coordenada X
+ * @param[out] y Coordenada Y
+ */
+void descodificarMorton(uint64_t chave, int* x, int* y);
+
+/**
+ * @brief Constrói um conjunto a partir de uma lista ligada
+ *
+ * @param[in] lista Lista de antenas ou efeitos
+ * @return ConjuntoMorton* Novo conjunto (libertar com libertarMorton)
+ *
+ * @note Complexidade: O(n) (radix sort das chaves); numa célula repetida
+ *       fica o primeiro elemento da lista
+ */
+ConjuntoMorton* mortonDeLista(Antena* lista);
+
+/**
+ * @brief Constrói um conjunto a partir de um AntenaSet
+ *
+ * @param[in] conjunto Conjunto de origem
+ * @return ConjuntoMorton* Novo conjunto (libertar com libertarMorton)
+ */
+ConjuntoMorton* mortonDeConjunto(const AntenaSet* conjunto);
+
+/**
+ * @brief Liberta o conjunto e os seus vetores
+ *
+ * @param[in] conjunto Conjunto a libertar (pode ser NULL)
+ */
+void libertarMorton(ConjuntoMorton* conjunto);
+
+/**
+ * @brief Devolve a posição de uma célula no conjunto
+ *
+ * @param[in] conjunto Conjunto a consultar
+ * @param[in] x Coordenada X
+ * @param[in] y Coordenada Y
+ * @return size_t Posição nos vetores ou MORTON_NAO_ENCONTRADO
+ *
+ * @note Complexidade: O(log n)
+ */
+size_t procurarMorton(const ConjuntoMorton* conjunto, int x, int y);
+
+/**
+ * @brief Devolve as posições das células dentro de um retângulo
+ *
+ * @param[in] conjunto Conjunto a consultar
+ * @param[in] x0 Primeira coluna
+ * @param[in] y0 Primeira linha
+ * @param[in] x1 Última coluna (inclusive)
+ * @param[in] y1 Última linha (inclusive)
+ * @param[out] n Número de posições devolvidas
+ * @return size_t* Posições por ordem de Morton (libertar com free; NULL se nenhuma)
+ *
+ * @note Cada chave fora do retângulo leva a um salto para a menor chave
+ *       seguinte que lhe pertence (BIGMIN) e a uma pesquisa binária
+ */
+size_t* mortonRetangulo(const ConjuntoMorton* conjunto, int x0, int y0, int x1, int y1, size_t* n);
+
+/**
+ * @brief Devolve todas as posições por linhas ou por colunas
+ *
+ * @param[in] conjunto Conjunto a percorrer
+ * @param[in] ordem MORTON_POR_LINHAS ou MORTON_POR_COLUNAS
+ * @return size_t* Permutação das posições 0..tamanho-1 (libertar com free)
+ *
+ * @note Complexidade: O(n) (radix sort)
+ */
+size_t* mortonPercorrer(const ConjuntoMorton* conjunto, int ordem);
+
+/**
+ * @brief Desenha uma janela do mapa a partir de conjuntos de Morton
+ *
+ * @param[in] saida Ficheiro de destino
+ * @param[in] antenas Antenas (podem ser NULL)
+ * @param[in] efeitos Efeitos (podem ser NULL)
+ * @param[in] x0 Primeira coluna da janela
+ * @param[in] y0 Primeira linha da janela
+ * @param[in] largura Número de colunas da janela
+ * @param[in] altura Número de linhas da janela
+ *
+ * @note Mesmo resultado que imprimirJanela, mas só as células dentro da
+ *       janela são visitadas: O(k log n + largura*altura) para k células
+ */
+void imprimirJanelaMorton(FILE* saida, const ConjuntoMorton* antenas, const ConjuntoMorton* efeitos,
+                          int x0, int y0, int largura, int altura);
+
+ #endif // MORTON_H
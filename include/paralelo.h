@@ -0,0 +1,69 @@
+/**
+ * @file paralelo.h
+ * @brief Cálculo de efeitos nefastos em paralelo (pthreads)
+ * 
+ * @details Divide o trabalho em tarefas:
+ * - Uma tarefa por grupo de frequência pequeno
+ * - Grupos grandes partidos em blocos de linhas i do espaço de pares (i,j),
+ *   com um número de pares aproximadamente igual por bloco
+ * 
+ * Cada thread retira tarefas de um contador partilhado e guarda as chaves
+ * (x,y) dos efeitos em baldes próprios, um por faixa de colunas, sem
+ * qualquer contenção sobre o conjunto de efeitos. No fim, as faixas são
+ * fundidas em paralelo (cada thread junta, ordena e deduplica faixas
+ * inteiras) e concatenadas pela ordem de x.
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef PARALELO_H
+ #define PARALELO_H
+
+ #include "conjunto.h"
+
+/**
+ * @brief Número de faixas de colunas por thread na fusão dos resultados
+ */
+ #define PARALELO_FAIXAS_POR_THREAD 4
+
+/**
+ * @brief Capacidade a partir da qual um balde cheio é compactado
+ *        (ordenado e deduplicado) antes de crescer
+ */
+ #define PARALELO_BALDE_COMPACTAR 4096
+
+/**
+ * @brief Número mínimo de pares por tarefa
+ */
+ #define PARALELO_PARES_MINIMO 4096
+
+/**
+ * @brief Devolve o número de processadores disponíveis
+ * 
+ * @return int Número de processadores (pelo menos 1)
+ */
+int numeroProcessadores(void);
+
+/**
+ * @brief Calcula os efeitos nefastos do conjunto usando várias threads
+ * 
+ * @param[in] conjunto Conjunto de antenas
+ * @param[in] threads Número de threads (<= 0 para usar todos os processadores)
+ * @return AntenaSet* Novo conjunto com os pontos '#'
+ * 
+ * @note O resultado é idêntico ao de calcularEfeitoNefastoConjunto
+ * @note Funciona com eixos ilimitados e mapas de qualquer tamanho; a
+ *       memória é proporcional aos pontos de efeito distintos de cada
+ *       thread (no máximo o dobro, pela compactação dos baldes), não às
+ *       células do mapa
+ */
+AntenaSet* calcularEfeitoNefastoParalelo(const AntenaSet* conjunto, int threads);
+
+ #endif // PARALELO_H
@@ -0,0 +1,144 @@
+/**
+ * @file regras.h
+ * @brief Conjuntos de regras de alinhamento configuráveis
+ *
+ * @details Uma regra define que geometrias produzem interferência:
+ * - Declives permitidos, como razões |dx|:|dy| (ex.: 1:0, 1:1, 1:2)
+ * - Fator de distância: os pontos de efeito são A - fator·d e B + fator·d
+ * - Lados projetados: os dois pontos ou apenas o que fica além de B
+ *
+ * Cada conjunto de regras é compilado numa tabela de direções: para
+ * diferenças pequenas o teste de um par é um único acesso a
+ * direta[|dx|][|dy|]; para as restantes a diferença é normalizada pelo
+ * máximo divisor comum e consultada na tabela de razões.
+ *
+ * O perfil clássico (REGRAS_PERFIL_CLASSICO) corresponde a antenasAlinhadas
+ * e continua a usar o núcleo vetorial de kernel.h.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef REGRAS_H
+ #define REGRAS_H
+
+ #include <stdint.h>
+ #include "conjunto.h"
+
+/**
+ * @brief Maior termo de uma razão de declive (após simplificação)
+ */
+ #define REGRAS_RACIO_MAXIMO 16
+
+/**
+ * @brief Lado da tabela direta: |dx|,|dy| abaixo deste valor dispensam a normalização
+ */
+ #define REGRAS_TABELA 128
+
+/**
+ * @brief Maior fator de distância aceite
+ */
+ #define REGRAS_FATOR_MAXIMO 16
+
+/**
+ * @brief Projeta os dois pontos de efeito (A - fator·d e B + fator·d)
+ */
+ #define REGRAS_LADOS_AMBOS 2
+
+/**
+ * @brief Projeta apenas o ponto além da segunda antena (B + fator·d)
+ *
+ * @note A segunda antena é a maior das duas na ordem (x,y)
+ */
+ #define REGRAS_LADO_UNICO 1
+
+/**
+ * @brief Perfil equivalente a antenasAlinhadas
+ */
+ #define REGRAS_PERFIL_CLASSICO "1:0,0:1,1:1,1:2,2:1,1:3,3:1"
+
+/**
+ * @brief Perfil usado quando nenhum é indicado
+ *
+ * @note Pode ser definido na compilação, ex.: -DREGRAS_PERFIL_OMISSAO="\"1:0,0:1;fator=2\""
+ */
+ #ifndef REGRAS_PERFIL_OMISSAO
+ #define REGRAS_PERFIL_OMISSAO REGRAS_PERFIL_CLASSICO
+ #endif
+
+/**
+ * @brief Razão de declive |dx|:|dy|
+ */
+typedef struct RacioAlinhamento {
+    int dx; ///< Termo horizontal
+    int dy; ///< Termo vertical
+} RacioAlinhamento;
+
+/**
+ * @brief Conjunto de regras compilado
+ */
+typedef struct RegrasAlinhamento {
+    uint8_t direta[REGRAS_TABELA][REGRAS_TABELA]; ///< 1 se (|dx|,|dy|) está alinhado
+    uint8_t racios[REGRAS_RACIO_MAXIMO + 1][REGRAS_RACIO_MAXIMO + 1]; ///< 1 se a razão primitiva (p,q) é permitida
+    int fator;     ///< Multiplicador da distância projetada
+    int lados;     ///< REGRAS_LADOS_AMBOS ou REGRAS_LADO_UNICO
+    int classicas; ///< 1 se equivale ao perfil clássico
+} RegrasAlinhamento;
+
+/**
+ * @brief Compila um conjunto de regras
+ *
+ * @param[in] racios Razões permitidas (simplificadas pelo máximo divisor comum)
+ * @param[in] n Número de razões
+ * @param[in] fator Fator de distância (1..REGRAS_FATOR_MAXIMO)
+ * @param[in] lados REGRAS_LADOS_AMBOS ou REGRAS_LADO_UNICO
+ * @param[out] regras Regras compiladas
+ * @return int 1 em caso de sucesso, 0 se algum parâmetro é inválido
+ */
+int compilarRegras(const RacioAlinhamento* racios, size_t n, int fator, int lados,
+                   RegrasAlinhamento* regras);
+
+/**
+ * @brief Compila um perfil de regras em texto
+ *
+ * @param[in] perfil Elementos separados por ',' ';' ou espaços: razões
+ *                   "p:q", "fator=n" e "lados=1|2" (ex.: "1:0,0:1,1:1;fator=2")
+ * @param[out] regras Regras compiladas
+ * @return int 1 em caso de sucesso, 0 se o perfil é inválido
+ */
+int lerRegras(const char* perfil, RegrasAlinhamento* regras);
+
+/**
+ * @brief Verifica se duas antenas separadas por (dx,dy) estão alinhadas
+ *
+ * @param[in] regras Regras compiladas
+ * @param[in] dx Diferença horizontal
+ * @param[in] dy Diferença vertical
+ * @return int 1 se alinhadas segundo as regras
+ *
+ * @note Um acesso à tabela direta, ou uma normalização e um acesso à tabela
+ *       de razões se |dx| ou |dy| >= REGRAS_TABELA
+ */
+int regrasAlinhadas(const RegrasAlinhamento* regras, long long dx, long long dy);
+
+/**
+ * @brief Calcula os efeitos nefastos de um conjunto segundo as regras
+ *
+ * @param[in] conjunto Conjunto de antenas
+ * @param[in] regras Regras compiladas
+ * @return AntenaSet* Novo conjunto com os pontos '#'
+ *
+ * @details Um par é ignorado se algum dos pontos projetados estiver ocupado;
+ * os pontos fora de [0,colunas) x [0,linhas) são descartados quando as
+ * dimensões são conhecidas. Com as regras clássicas delega em
+ * calcularEfeitoNefastoConjunto.
+ */
+AntenaSet* calcularEfeitosComRegras(const AntenaSet* conjunto, const RegrasAlinhamento* regras);
+
+ #endif // REGRAS_H
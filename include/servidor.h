@@ -0,0 +1,149 @@
+/**
+ * @file servidor.h
+ * @brief Modo servidor: mapa carregado uma vez e comandos por stdin ou socket
+ *
+ * @details O servidor mantém em memória o conjunto de antenas, os índices e
+ * os efeitos (EstadoEfeitos) e responde a um protocolo de texto, um comando
+ * por linha:
+ * - INSERIR <freq> <x> <y>       -> OK | ERRO <motivo>
+ * - REMOVER <x> <y>              -> OK | ERRO <motivo>
+ * - CONSULTAR <x> <y>            -> CELULA <x> <y> <freq|#|.>
+ * - ANTENAS                      -> ANTENAS <n>, seguido de n linhas "<freq> <x> <y>"
+ * - EFEITOS                      -> EFEITOS <n>, seguido de n linhas "<x> <y>"
+ * - JANELA <x0> <y0> <larg> <alt> -> JANELA <alt>, seguido de alt linhas do mapa
+ * - SNAPSHOT <ficheiro>          -> OK | ERRO <motivo>
+ * - ESTATISTICAS                 -> contadores acumulados, num objeto JSON
+ * - SAIR                         -> OK, e termina a sessão
+ *
+ * Os comandos recebidos num mesmo bloco de leitura são executados em
+ * sequência e as respostas saem num único envio no fim do bloco, pelo que
+ * um cliente pode enviar vários pedidos sem esperar pelas respostas. No
+ * socket, cada cliente é lido sem bloquear (até SERVIDOR_BLOCOS_POR_LEITURA
+ * blocos de cada vez) e as respostas ficam numa memória própria que é
+ * enviada à medida que o cliente as lê; vários clientes são atendidos em
+ * simultâneo por poll(). As
+ * listas de antenas e efeitos usadas pelas consultas são materializadas uma
+ * vez e partilhadas por todas as leituras até à próxima alteração; JANELA
+ * usa cópias por ordem Z (morton.h), pelo que só visita as células da janela.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef SERVIDOR_H
+ #define SERVIDOR_H
+
+ #include <stdio.h>
+ #include "funcoes.h"
+ #include "incremental.h"
+ #include "morton.h"
+
+/**
+ * @brief Comprimento máximo de uma linha de comando (incluindo '\n')
+ */
+ #define SERVIDOR_LINHA_MAXIMA 4096
+
+/**
+ * @brief Número máximo de células devolvidas por um comando JANELA
+ */
+ #define SERVIDOR_JANELA_MAXIMA (1 << 24)
+
+/**
+ * @brief Número máximo de clientes ligados ao socket em simultâneo
+ */
+ #define SERVIDOR_CLIENTES_MAXIMO 64
+
+/**
+ * @brief Blocos lidos de um cliente antes de passar ao seguinte
+ */
+ #define SERVIDOR_BLOCOS_POR_LEITURA 8
+
+/**
+ * @brief Bytes de respostas por enviar a partir dos quais o cliente deixa
+ *        de ser lido até as consumir
+ */
+ #define SERVIDOR_PENDENTE_MAXIMO (1 << 20)
+
+/**
+ * @brief Tempo (ms) sem leituras nem escritas após o qual um cliente é desligado
+ */
+ #define SERVIDOR_INATIVIDADE_MS 30000
+
+/**
+ * @brief Pausa (ms) na aceitação de ligações quando se esgotam os descritores
+ */
+ #define SERVIDOR_PAUSA_ACEITAR_MS 100
+
+/**
+ * @brief Estado de um servidor com um mapa carregado
+ */
+typedef struct Servidor {
+    EstadoEfeitos* estado;   ///< Antenas, índices e efeitos mantidos incrementalmente
+    Antena* antenas;         ///< Lista de antenas materializada (NULL se desatualizada)
+    Antena* efeitos;         ///< Lista de efeitos materializada (NULL se desatualizada)
+    ConjuntoMorton* antenasZ;///< Antenas por ordem Z para JANELA (NULL se por construir)
+    ConjuntoMorton* efeitosZ;///< Efeitos por ordem Z para JANELA (NULL se por construir)
+    int atualizado;          ///< 1 se as listas refletem o estado atual
+    Mapa mapa;               ///< Dimensões do mapa carregado
+} Servidor;
+
+/**
+ * @brief Carrega um mapa e cria o servidor correspondente
+ *
+ * @param[in] filename Ficheiro do mapa (formato de carregarAntenasDoMapa)
+ * @return Servidor* Novo servidor
+ */
+Servidor* criarServidor(const char* filename);
+
+/**
+ * @brief Liberta o servidor e todo o estado associado
+ *
+ * @param[in] servidor Servidor a libertar (pode ser NULL)
+ */
+void libertarServidor(Servidor* servidor);
+
+/**
+ * @brief Executa um comando do protocolo e escreve a resposta
+ *
+ * @param[in,out] servidor Servidor alvo
+ * @param[in] linha Comando, sem o terminador de linha
+ * @param[in] saida Destino da resposta
+ * @return int 0 se o comando foi SAIR, 1 caso contrário
+ */
+int executarComando(Servidor* servidor, const char* linha, FILE* saida);
+
+/**
+ * @brief Atende comandos lidos de um descritor até SAIR ou fim de ficheiro
+ *
+ * @param[in,out] servidor Servidor alvo
+ * @param[in] entrada Descritor de leitura (ex.: 0 para stdin)
+ * @param[in] saida Destino das respostas, esvaziado no fim de cada bloco lido
+ * @return int 0 se a sessão terminou com SAIR, 1 se terminou por fim de ficheiro
+ */
+int servirDescritor(Servidor* servidor, int entrada, FILE* saida);
+
+/**
+ * @brief Atende até SERVIDOR_CLIENTES_MAXIMO clientes num socket Unix local
+ *
+ * @param[in,out] servidor Servidor alvo
+ * @param[in] caminho Caminho do socket (um socket antigo é substituído;
+ *            qualquer outro tipo de ficheiro é recusado)
+ * @return int 1 se o servidor terminou com SAIR, SIGINT ou SIGTERM; 0 se o
+ *         socket não pôde ser criado ou deixou de aceitar ligações
+ *
+ * @note Os comandos dos vários clientes atuam sobre o mesmo estado, pela
+ *       ordem em que são lidos; SAIR termina o servidor para todos
+ * @note Clientes inativos durante SERVIDOR_INATIVIDADE_MS são desligados;
+ *       sem descritores livres, a aceitação pára SERVIDOR_PAUSA_ACEITAR_MS
+ * @note O ficheiro do socket é removido à saída
+ * @note Indisponível em Windows (devolve 0)
+ */
+int servirSocket(Servidor* servidor, const char* caminho);
+
+ #endif // SERVIDOR_H
@@ -0,0 +1,91 @@
+/**
+ * @file simulacao.h
+ * @brief Avaliação "e se" de antenas candidatas, sem alterar o estado
+ *
+ * @details Para cada candidato (frequência, x, y) calcula os efeitos que a
+ * sua inserção acrescentaria e os que faria desaparecer, a partir das
+ * contagens de referência de um EstadoEfeitos:
+ * - Pares novos: apenas entre o candidato e o seu grupo de frequência
+ *   (O(k) para um grupo de tamanho k)
+ * - Pares anulados: só existem se a célula do candidato já for um efeito;
+ *   nesse caso percorrem-se as antenas como em estadoInserirAntena (O(n))
+ *
+ * O estado é apenas lido, pelo que os candidatos são avaliados em paralelo
+ * (pthreads), com cada thread a retirar blocos de um contador partilhado.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #ifndef SIMULACAO_H
+ #define SIMULACAO_H
+
+ #include <stddef.h>
+ #include "incremental.h"
+
+/**
+ * @brief Número de candidatos retirados de cada vez por uma thread
+ */
+ #define SIMULACAO_BLOCO 256
+
+/**
+ * @brief Antena candidata a inserir
+ */
+typedef struct Candidato {
+    char frequencia; ///< Frequência da antena
+    int x;           ///< Coluna (0-based)
+    int y;           ///< Linha (0-based)
+} Candidato;
+
+/**
+ * @brief Coordenada de uma célula do mapa
+ */
+typedef struct Coordenada {
+    int x; ///< Coluna
+    int y; ///< Linha
+} Coordenada;
+
+/**
+ * @brief Efeito da inserção de um candidato
+ *
+ * @note Os vetores estão ordenados por (x,y) e são NULL quando vazios
+ */
+typedef struct ResultadoCandidato {
+    int valido;                ///< 0 se a célula está ocupada, fora do mapa ou a frequência é inválida
+    size_t numAdicionados;     ///< Número de efeitos novos
+    size_t numRemovidos;       ///< Número de efeitos que deixariam de existir
+    Coordenada* adicionados;   ///< Células que passariam a ter efeito
+    Coordenada* removidos;     ///< Células que deixariam de ter efeito
+} ResultadoCandidato;
+
+/**
+ * @brief Avalia um lote de candidatos contra o estado atual
+ *
+ * @param[in] estado Estado de antenas e efeitos (não é alterado)
+ * @param[in] candidatos Vetor de candidatos
+ * @param[in] n Número de candidatos
+ * @param[in] threads Número de threads (<= 0 para usar todos os processadores)
+ * @return ResultadoCandidato* Vetor de n resultados, pela ordem dos candidatos
+ *
+ * @note Cada candidato é avaliado isoladamente: o resultado é o que
+ *       estadoInserirAntena produziria se fosse a única inserção
+ * @note O estado não pode ser alterado enquanto a avaliação decorre
+ */
+ResultadoCandidato* avaliarCandidatos(const EstadoEfeitos* estado, const Candidato* candidatos,
+                                      size_t n, int threads);
+
+/**
+ * @brief Liberta um vetor devolvido por avaliarCandidatos
+ *
+ * @param[in] resultados Vetor de resultados (pode ser NULL)
+ * @param[in] n Número de resultados
+ */
+void libertarResultados(ResultadoCandidato* resultados, size_t n);
+
+ #endif // SIMULACAO_H
@@ -20,7 +20,44 @@
  #ifndef UTIL_H
  #define UTIL_H
  
+ #include <stdio.h>
  #include "funcoes.h"
+ #include "conjunto.h"
+ #include "indice.h"
+ #include "mapeamento.h"
+ #include "esparso.h"
+
+/**
+ * @brief Versão atual do formato binário de snapshot
+ */
+ #define SNAPSHOT_VERSAO 1
+
+/**
+ * @brief Marca de snapshot: inclui bitmap de ocupação das antenas
+ */
+ #define SNAPSHOT_BITMAP_ANTENAS 1u
+
+/**
+ * @brief Marca de snapshot: inclui bitmap de ocupação dos efeitos
+ */
+ #define SNAPSHOT_BITMAP_EFEITOS 2u
+
+/**
+ * @brief Snapshot binário aberto em memória mapeada
+ * 
+ * @details Os vetores dos conjuntos apontam diretamente para o ficheiro
+ * mapeado; não há alocação por nó. Os conjuntos são apenas de leitura:
+ * não devem ser passados a funções que os alterem nem a libertarConjunto.
+ */
+typedef struct SnapshotMapa {
+    FicheiroMapeado ficheiro;  ///< Ficheiro mapeado
+    int linhas;                ///< Número de linhas do mapa
+    int colunas;               ///< Número de colunas do mapa
+    AntenaSet antenas;         ///< Antenas agrupadas por frequência (só leitura)
+    AntenaSet efeitos;         ///< Efeitos nefastos (só leitura)
+    IndiceCoord ocupadasAntenas; ///< Índice das antenas (bitmap no ficheiro ou hash)
+    IndiceCoord ocupadasEfeitos; ///< Índice dos efeitos (bitmap no ficheiro ou hash)
+} SnapshotMapa;
  
 /**
  * @brief Carrega antenas de um ficheiro de mapa para uma lista ligada
@@ -35,8 +72,62 @@
  *       Linhas seguintes: linhas do mapa ('.' para vazio, outros chars para antenas)
  * 
  * @note Caracteres inválidos são tratados como espaços vazios
+ * @note O ficheiro é mapeado em memória; não há limite de largura ou altura
+ * @note Complexidade: linear no tamanho do ficheiro
  */
 Antena* carregarAntenasDoMapa(const char* filename, int* linhas, int* colunas);
+
+/**
+ * @brief Carrega antenas de um ficheiro de mapa diretamente para um AntenaSet
+ * 
+ * @param[in] filename Caminho do ficheiro contendo o mapa
+ * @param[out] linhas Apontador para armazenar número de linhas do mapa
+ * @param[out] colunas Apontador para armazenar número de colunas do mapa
+ * @return AntenaSet* Conjunto agrupado por frequência, com as dimensões do mapa
+ * 
+ * @note Mesmo formato de ficheiro que carregarAntenasDoMapa
+ */
+AntenaSet* carregarConjuntoDoMapa(const char* filename, int* linhas, int* colunas);
+
+/**
+ * @brief Como carregarConjuntoDoMapa, mas devolve NULL em vez de terminar o programa
+ * 
+ * @param[in] filename Caminho do ficheiro contendo o mapa
+ * @param[out] linhas Apontador para armazenar número de linhas do mapa
+ * @param[out] colunas Apontador para armazenar número de colunas do mapa
+ * @return AntenaSet* Conjunto carregado, ou NULL se o ficheiro não abre ou
+ *         o cabeçalho é inválido (a mensagem de erro vai para stderr)
+ * 
+ * @note Para quem processa vários mapas e não deve parar num inválido
+ */
+AntenaSet* tentarCarregarConjuntoDoMapa(const char* filename, int* linhas, int* colunas);
+
+/**
+ * @brief Carrega um mapa para a representação comprimida por linhas
+ * 
+ * @param[in] filename Caminho do ficheiro: mapa de texto ou formato comprimido
+ * @param[out] linhas Apontador para armazenar número de linhas do mapa
+ * @param[out] colunas Apontador para armazenar número de colunas do mapa
+ * @return MapaEsparso* Mapa com as células ocupadas (libertar com libertarEsparso)
+ * 
+ * @note Formato comprimido, reconhecido pela primeira palavra:
+ *       Linha 1: "EDARLE <linhas> <colunas>"
+ *       Uma linha por linha não vazia: "<y> <n>" seguido de n pares
+ *       "<vazios> <carácter>", com os '.' saltados desde a célula anterior
+ * @note Nunca é criada uma grelha densa: memória proporcional às células ocupadas
+ */
+MapaEsparso* carregarEsparsoDoMapa(const char* filename, int* linhas, int* colunas);
+
+/**
+ * @brief Exporta um mapa no formato comprimido por linhas
+ * 
+ * @param[in] filename Caminho do ficheiro a escrever
+ * @param[in] mapa Mapa a exportar
+ * @return int 1 em caso de sucesso, 0 em caso de erro
+ * 
+ * @note O ficheiro pode ser lido por carregarEsparsoDoMapa
+ */
+int guardarMapaEsparso(const char* filename, const MapaEsparso* mapa);
  
 /**
  * @brief Exibe representação visual do mapa com antenas e efeitos
@@ -50,7 +141,75 @@ Antena* carregarAntenasDoMapa(const char* filename, int* linhas, int* colunas);
  *       1. Antenas normais
  *       2. Efeitos nefastos
  *       3. Espaços vazios ('.')
+ * @note Cada linha é composta num buffer e escrita de uma só vez
  */
 void imprimirMapa(Antena* antenas, Antena* efeitos, int linhas, int colunas);
+
+/**
+ * @brief Exibe apenas uma janela retangular do mapa
+ * 
+ * @param[in] saida Ficheiro de destino (ex.: stdout)
+ * @param[in] antenas Lista de antenas a exibir
+ * @param[in] efeitos Lista de efeitos nefastos a exibir (pode ser NULL)
+ * @param[in] x0 Primeira coluna da janela (0-based)
+ * @param[in] y0 Primeira linha da janela (0-based)
+ * @param[in] largura Número de colunas da janela
+ * @param[in] altura Número de linhas da janela
+ * 
+ * @note Mesma prioridade de exibição que imprimirMapa
+ * @note Complexidade: O(n + m + largura*altura)
+ */
+void imprimirJanela(FILE* saida, Antena* antenas, Antena* efeitos,
+                    int x0, int y0, int largura, int altura);
+
+/**
+ * @brief Exibe o mapa reduzido, com um carácter por bloco de fator x fator células
+ * 
+ * @param[in] saida Ficheiro de destino (ex.: stdout)
+ * @param[in] antenas Lista de antenas a exibir
+ * @param[in] efeitos Lista de efeitos nefastos a exibir (pode ser NULL)
+ * @param[in] linhas Número total de linhas do mapa
+ * @param[in] colunas Número total de colunas do mapa
+ * @param[in] fator Lado do bloco em células (1 equivale a imprimirMapa)
+ * 
+ * @note Um bloco com antenas mostra a frequência da última antena da lista
+ *       nesse bloco; sem antenas mostra '#' se tiver algum efeito
+ */
+void imprimirMapaReduzido(FILE* saida, Antena* antenas, Antena* efeitos,
+                          int linhas, int colunas, int fator);
  
+/**
+ * @brief Guarda antenas e efeitos num snapshot binário versionado
+ * 
+ * @param[in] filename Caminho do ficheiro a escrever
+ * @param[in] antenas Conjunto de antenas (define as dimensões do mapa)
+ * @param[in] efeitos Conjunto de efeitos (pode ser NULL)
+ * @param[in] marcas Combinação de SNAPSHOT_BITMAP_* a incluir
+ * @return int 1 em caso de sucesso, 0 em caso de erro
+ * 
+ * @note Formato: cabeçalho fixo, limites dos grupos de frequência, vetores
+ *       x/y/frequencia das antenas e dos efeitos e, opcionalmente, os
+ *       bitmaps de ocupação; todas as secções alinhadas a 8 bytes
+ */
+int guardarSnapshot(const char* filename, const AntenaSet* antenas,
+                    const AntenaSet* efeitos, unsigned marcas);
+
+/**
+ * @brief Abre um snapshot binário mapeando-o em memória
+ * 
+ * @param[in] filename Caminho do ficheiro de snapshot
+ * @return SnapshotMapa* Snapshot aberto ou NULL se inválido
+ * 
+ * @note Sem bitmaps no ficheiro, os índices são construídos em memória (hash)
+ * @note Complexidade: O(1) com bitmaps, O(n + m) sem bitmaps
+ */
+SnapshotMapa* abrirSnapshot(const char* filename);
+
+/**
+ * @brief Fecha um snapshot, desfazendo o mapeamento
+ * 
+ * @param[in] snapshot Snapshot a fechar (pode ser NULL)
+ */
+void fecharSnapshot(SnapshotMapa* snapshot);
+
  #endif // UTIL_H
\ No newline at end of file
@@ -0,0 +1,112 @@
+/**
+ * @file arena.c
+ * @brief Implementação do alocador por blocos para nós de antenas
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include "arena.h"
+ #include "memoria.h"
+
+/**
+ * @brief Aloca um novo bloco e coloca-o à cabeça da lista de blocos
+ */
+static void novoBloco(ArenaAntenas* arena) {
+    size_t capacidade = arena->proximaCapacidade;
+    BlocoAntenas* bloco = (BlocoAntenas*)realocar(NULL, 1, sizeof(BlocoAntenas) + capacidade * sizeof(Antena));
+    bloco->capacidade = capacidade;
+    bloco->usados = 0;
+    bloco->prox = arena->blocos;
+    arena->blocos = bloco;
+    if (capacidade < ARENA_BLOCO_MAXIMO)
+        arena->proximaCapacidade = capacidade * 2;
+}
+
+ArenaAntenas* criarArena(size_t nosIniciais) {
+    ArenaAntenas* arena = (ArenaAntenas*)realocar(NULL, 1, sizeof(ArenaAntenas));
+    arena->blocos = NULL;
+    arena->livres = NULL;
+    arena->ativos = 0;
+    arena->proximaCapacidade = nosIniciais ? nosIniciais : ARENA_BLOCO_INICIAL;
+    return arena;
+}
+
+void libertarArena(ArenaAntenas* arena) {
+    if (arena == NULL) return;
+    BlocoAntenas* bloco = arena->blocos;
+    while (bloco != NULL) {
+        BlocoAntenas* seguinte = bloco->prox;
+        free(bloco);
+        bloco = seguinte;
+    }
+    free(arena);
+}
+
+void reiniciarArena(ArenaAntenas* arena) {
+    // O bloco mais recente é o maior; os anteriores são libertados
+    BlocoAntenas* bloco = arena->blocos;
+    if (bloco != NULL) {
+        BlocoAntenas* antigo = bloco->prox;
+        while (antigo != NULL) {
+            BlocoAntenas* seguinte = antigo->prox;
+            free(antigo);
+            antigo = seguinte;
+        }
+        bloco->prox = NULL;
+        bloco->usados = 0;
+    }
+    arena->livres = NULL;
+    arena->ativos = 0;
+}
+
+Antena* arenaCriarAntena(ArenaAntenas* arena, char frequencia, int x, int y) {
+    Antena* nova;
+    if (arena->livres != NULL) {
+        nova = arena->livres;
+        arena->livres = nova->prox;
+    } else {
+        if (arena->blocos == NULL || arena->blocos->usados == arena->blocos->capacidade)
+            novoBloco(arena);
+        nova = &arena->blocos->nos[arena->blocos->usados++];
+    }
+    nova->frequencia = frequencia;
+    nova->x = x;
+    nova->y = y;
+    nova->prox = NULL;
+    arena->ativos++;
+    return nova;
+}
+
+void arenaLibertarAntena(ArenaAntenas* arena, Antena* no) {
+    no->prox = arena->livres;
+    arena->livres = no;
+    arena->ativos--;
+}
+
+Antena* arenaInserirAntena(ArenaAntenas* arena, Antena* head, char frequencia, int x, int y) {
+    if (existeNaLista(head, x, y)) return head;
+    return ligarOrdenado(head, arenaCriarAntena(arena, frequencia, x, y));
+}
+
+Antena* arenaRemoverAntena(ArenaAntenas* arena, Antena* head, int x, int y) {
+    Antena *temp = head, *prev = NULL;
+    while (temp != NULL && (temp->x != x || temp->y != y)) {
+        prev = temp;
+        temp = temp->prox;
+    }
+    if (temp == NULL) return head;
+
+    if (prev == NULL) head = temp->prox;
+    else prev->prox = temp->prox;
+    arenaLibertarAntena(arena, temp);
+    return head;
+}
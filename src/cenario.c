@@ -0,0 +1,516 @@
+/**
+ * @file cenario.c
+ * @brief Implementação dos cenários com camadas de cópia na escrita
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdint.h>
+ #include "cenario.h"
+ #include "memoria.h"
+
+/**
+ * @brief Marca de célula cuja antena foi removida nesta camada
+ */
+ #define CENARIO_LIVRE '.'
+
+/**
+ * @brief Valor devolvido por procurarNaCamada quando a célula não foi alterada
+ */
+ #define CENARIO_AUSENTE ((size_t)-1)
+
+/**
+ * @brief Camada de alterações: tabela de hash (x,y) -> (antena, variação)
+ *
+ * @note Só a camada de topo de um cenário é escrita; as restantes estão
+ *       congeladas e podem ser partilhadas por vários ramos
+ */
+struct Camada {
+    Camada* pai;            ///< Camada de baixo (NULL na raiz)
+    EstadoEfeitos* base;    ///< Estado base partilhado (pertence à raiz)
+    size_t referencias;     ///< Cenários e camadas filhas que apontam para esta
+    size_t profundidade;    ///< Número de camadas abaixo desta
+    uint64_t* chaves;       ///< Chaves (x,y) compactadas
+    char* antenas;          ///< '\0' se inalterada, CENARIO_LIVRE se removida, ou a frequência
+    int* deltas;            ///< Variação da contagem de efeitos da célula
+    uint8_t* usados;        ///< Marca de posição ocupada
+    size_t capacidade;      ///< Número de posições (potência de 2, 0 se vazia)
+    size_t tamanho;         ///< Número de células alteradas
+};
+
+/**
+ * @brief Cria uma camada vazia por cima de pai
+ */
+static Camada* novaCamada(Camada* pai, EstadoEfeitos* base) {
+    Camada* camada = (Camada*)alocarZeros(1, sizeof(Camada));
+    camada->pai = pai;
+    camada->base = base;
+    camada->referencias = 1;
+    camada->profundidade = pai ? pai->profundidade + 1 : 0;
+    if (pai) pai->referencias++;
+    return camada;
+}
+
+/**
+ * @brief Larga uma referência e liberta as camadas que deixam de ser usadas
+ */
+static void largarCamada(Camada* camada) {
+    while (camada != NULL && --camada->referencias == 0) {
+        Camada* pai = camada->pai;
+        if (pai == NULL) libertarEstadoEfeitos(camada->base);
+        free(camada->chaves);
+        free(camada->antenas);
+        free(camada->deltas);
+        free(camada->usados);
+        free(camada);
+        camada = pai;
+    }
+}
+
+/**
+ * @brief Procura a posição da chave ou da primeira posição livre
+ */
+static size_t posicaoNaCamada(const Camada* camada, uint64_t chave) {
+    size_t mascara = camada->capacidade - 1;
+    size_t i = dispersarChave(chave) & mascara;
+    while (camada->usados[i] && camada->chaves[i] != chave)
+        i = (i + 1) & mascara;
+    return i;
+}
+
+/**
+ * @brief Devolve a posição de uma célula alterada na camada
+ */
+static size_t procurarNaCamada(const Camada* camada, uint64_t chave) {
+    if (camada->capacidade == 0) return CENARIO_AUSENTE;
+    size_t i = posicaoNaCamada(camada, chave);
+    return camada->usados[i] ? i : CENARIO_AUSENTE;
+}
+
+/**
+ * @brief Duplica a capacidade da tabela da camada
+ */
+static void crescerCamada(Camada* camada) {
+    Camada antiga = *camada;
+    camada->capacidade = antiga.capacidade ? antiga.capacidade * 2 : 16;
+    camada->chaves = (uint64_t*)alocarZeros(camada->capacidade, sizeof(uint64_t));
+    camada->antenas = (char*)alocarZeros(camada->capacidade, sizeof(char));
+    camada->deltas = (int*)alocarZeros(camada->capacidade, sizeof(int));
+    camada->usados = (uint8_t*)alocarZeros(camada->capacidade, sizeof(uint8_t));
+    for (size_t i = 0; i < antiga.capacidade; i++) {
+        if (!antiga.usados[i]) continue;
+        size_t j = posicaoNaCamada(camada, antiga.chaves[i]);
+        camada->usados[j] = 1;
+        camada->chaves[j] = antiga.chaves[i];
+        camada->antenas[j] = antiga.antenas[i];
+        camada->deltas[j] = antiga.deltas[i];
+    }
+    free(antiga.chaves);
+    free(antiga.antenas);
+    free(antiga.deltas);
+    free(antiga.usados);
+}
+
+/**
+ * @brief Devolve a posição de uma célula na camada, criando-a se necessário
+ */
+static size_t entradaNaCamada(Camada* camada, uint64_t chave) {
+    if (2 * (camada->tamanho + 1) > camada->capacidade) crescerCamada(camada);
+    size_t i = posicaoNaCamada(camada, chave);
+    if (!camada->usados[i]) {
+        camada->usados[i] = 1;
+        camada->chaves[i] = chave;
+        camada->tamanho++;
+    }
+    return i;
+}
+
+/**
+ * @brief Junta a destino as alterações de uma camada que está abaixo dela
+ *
+ * @note A antena de destino prevalece, por estar mais acima; as variações
+ *       das contagens somam-se
+ */
+static void acumularCamada(Camada* destino, const Camada* abaixo) {
+    for (size_t j = 0; j < abaixo->capacidade; j++) {
+        if (!abaixo->usados[j]) continue;
+        size_t i = entradaNaCamada(destino, abaixo->chaves[j]);
+        if (!destino->antenas[i]) destino->antenas[i] = abaixo->antenas[j];
+        destino->deltas[i] += abaixo->deltas[j];
+    }
+}
+
+/**
+ * @brief Limita o número de camadas por baixo do topo de um cenário
+ *
+ * @details Uma camada congelada que já só é usada pelo topo (os outros ramos
+ * foram descartados) é fundida nele. Se mesmo assim a cadeia exceder
+ * CENARIO_PROFUNDIDADE_MAXIMA, o topo é substituído por uma camada privada,
+ * diretamente sobre a raiz, com todas as alterações visíveis.
+ */
+static void compactarCenario(Cenario* cenario) {
+    Camada* topo = cenario->topo;
+    // A raiz (sem pai) é a dona do estado base e nunca é fundida
+    while (topo->pai != NULL && topo->pai->pai != NULL && topo->pai->referencias == 1) {
+        Camada* pai = topo->pai;
+        acumularCamada(topo, pai);
+        topo->pai = pai->pai;  // A referência do pai ao avô passa para o topo
+        topo->profundidade = pai->profundidade;
+        free(pai->chaves);
+        free(pai->antenas);
+        free(pai->deltas);
+        free(pai->usados);
+        free(pai);
+    }
+    if (topo->profundidade <= CENARIO_PROFUNDIDADE_MAXIMA) return;
+
+    Camada* raiz = topo;
+    while (raiz->pai != NULL) raiz = raiz->pai;
+    Camada* plana = novaCamada(raiz, topo->base);
+    for (const Camada* c = topo; c != raiz; c = c->pai) acumularCamada(plana, c);
+    cenario->topo = plana;
+    largarCamada(topo);
+}
+
+/**
+ * @brief Verifica se alguma camada em [de, ate) altera a antena da célula
+ */
+static int sombreada(const Camada* de, const Camada* ate, uint64_t chave) {
+    for (; de != ate; de = de->pai) {
+        size_t i = procurarNaCamada(de, chave);
+        if (i != CENARIO_AUSENTE && de->antenas[i]) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Frequência da antena visível numa célula, ou '\0' se livre
+ */
+static char antenaVisivel(const Camada* topo, int x, int y) {
+    uint64_t chave = chaveOrdenada(x, y);
+    for (const Camada* c = topo; c != NULL; c = c->pai) {
+        size_t i = procurarNaCamada(c, chave);
+        if (i != CENARIO_AUSENTE && c->antenas[i])
+            return c->antenas[i] == CENARIO_LIVRE ? '\0' : c->antenas[i];
+    }
+    const AntenaSet* conjunto = topo->base->antenas;
+    size_t pos = procurarNoConjunto(conjunto, x, y);
+    return pos == CONJUNTO_NAO_ENCONTRADO ? '\0' : conjunto->frequencia[pos];
+}
+
+/**
+ * @brief Contagem de efeitos visível numa célula: base mais as variações
+ */
+static long long contagemVisivel(const Camada* topo, int x, int y) {
+    uint64_t chave = chaveOrdenada(x, y);
+    long long total = contagemValor(topo->base->efeitos, x, y);
+    for (const Camada* c = topo; c != NULL; c = c->pai) {
+        size_t i = procurarNaCamada(c, chave);
+        if (i != CENARIO_AUSENTE) total += c->deltas[i];
+    }
+    return total;
+}
+
+/**
+ * @brief Verifica se um ponto calculado em 64 bits está ocupado por uma antena
+ */
+static int ocupado(const Camada* topo, long long x, long long y) {
+    return coordenadaRepresentavel(x, y) && antenaVisivel(topo, (int)x, (int)y) != '\0';
+}
+
+/**
+ * @brief Contexto comum às visitas das antenas visíveis
+ *
+ * @note As contribuições ficam pendentes até ao fim da visita: escrevê-las
+ *       logo poderia redimensionar a tabela do topo enquanto é percorrida
+ */
+typedef struct {
+    Camada* topo;         ///< Camada a escrever
+    int px;               ///< Coluna da antena alterada
+    int py;               ///< Linha da antena alterada
+    int delta;            ///< +1 para ativar, -1 para anular
+    uint64_t* pendentes;  ///< Chaves das contribuições ainda por aplicar
+    size_t numPendentes;  ///< Número de contribuições pendentes
+    size_t capacidade;    ///< Capacidade de pendentes
+} Visita;
+
+/**
+ * @brief Regista delta num ponto de efeito dentro do mapa
+ */
+static void contribuir(Visita* v, long long x, long long y) {
+    Mapa mapa = {v->topo->base->linhas, v->topo->base->colunas};
+    if (!pontoNoMapa(&mapa, x, y)) return;
+    if (v->numPendentes == v->capacidade) {
+        v->capacidade = v->capacidade ? v->capacidade * 2 : 64;
+        v->pendentes = (uint64_t*)realocar(v->pendentes, v->capacidade, sizeof(uint64_t));
+    }
+    v->pendentes[v->numPendentes++] = chaveOrdenada((int)x, (int)y);
+}
+
+/**
+ * @brief Soma delta às contagens pendentes na camada de topo
+ */
+static void aplicarPendentes(Visita* v) {
+    for (size_t k = 0; k < v->numPendentes; k++) {
+        size_t i = entradaNaCamada(v->topo, v->pendentes[k]);
+        v->topo->deltas[i] += v->delta;
+    }
+    v->numPendentes = 0;
+}
+
+/**
+ * @brief Função chamada para cada antena visível
+ */
+typedef void (*Visitante)(Visita* visita, char frequencia, int x, int y);
+
+/**
+ * @brief Visita as antenas visíveis no cenário, opcionalmente de um só grupo
+ *
+ * @details Percorre o grupo do estado base e as antenas acrescentadas em
+ * cada camada, ignorando as que uma camada mais acima removeu ou substituiu.
+ */
+static void visitarAntenas(Visita* visita, int grupo, Visitante visitante) {
+    const Camada* topo = visita->topo;
+    const AntenaSet* conjunto = topo->base->antenas;
+    size_t inicio = grupo < 0 ? 0 : conjunto->inicio[grupo];
+    size_t fim = grupo < 0 ? conjunto->tamanho : conjunto->inicio[grupo + 1];
+    for (size_t i = inicio; i < fim; i++) {
+        if (sombreada(topo, NULL, chaveOrdenada(conjunto->x[i], conjunto->y[i]))) continue;
+        visitante(visita, conjunto->frequencia[i], conjunto->x[i], conjunto->y[i]);
+    }
+    for (const Camada* c = topo; c != NULL; c = c->pai) {
+        for (size_t i = 0; i < c->capacidade; i++) {
+            char f = c->antenas[i];
+            if (!c->usados[i] || f == '\0' || f == CENARIO_LIVRE) continue;
+            if (grupo >= 0 && (unsigned char)f != grupo) continue;
+            if (sombreada(topo, c, c->chaves[i])) continue;
+            visitante(visita, f, xDaChave(c->chaves[i]), yDaChave(c->chaves[i]));
+        }
+    }
+    aplicarPendentes(visita);
+}
+
+/**
+ * @brief Avalia o par (P,B) e, se válido, soma delta aos seus dois pontos
+ */
+static void visitarPar(Visita* v, char frequencia, int bx, int by) {
+    (void)frequencia;
+    if (bx == v->px && by == v->py) return;
+    long long dx = (long long)bx - v->px, dy = (long long)by - v->py;
+    if (!antenasAlinhadas(dx, dy)) return;
+
+    long long x1 = v->px - dx, y1 = v->py - dy;
+    long long x2 = bx + dx, y2 = by + dy;
+    if (ocupado(v->topo, x1, y1) || ocupado(v->topo, x2, y2)) return;
+    contribuir(v, x1, y1);
+    contribuir(v, x2, y2);
+}
+
+/**
+ * @brief Ativa ou anula o par (B,C) com ponto de efeito em P, se existir
+ */
+static void visitarBloqueio(Visita* v, char frequencia, int bx, int by) {
+    long long cx = 2LL * bx - v->px, cy = 2LL * by - v->py;
+    if (!coordenadaRepresentavel(cx, cy)) return;
+    if (antenaVisivel(v->topo, (int)cx, (int)cy) != frequencia) return;
+
+    long long dx = cx - bx, dy = cy - by;
+    if (!antenasAlinhadas(dx, dy)) return;
+    if (ocupado(v->topo, cx + dx, cy + dy)) return;
+    contribuir(v, v->px, v->py);
+    contribuir(v, cx + dx, cy + dy);
+}
+
+/**
+ * @brief Marca a antena de uma célula na camada de topo
+ */
+static void marcarAntena(Camada* topo, int x, int y, char frequencia) {
+    size_t i = entradaNaCamada(topo, chaveOrdenada(x, y));
+    topo->antenas[i] = frequencia;
+}
+
+Cenario* criarCenario(EstadoEfeitos* base) {
+    Cenario* cenario = (Cenario*)alocarZeros(1, sizeof(Cenario));
+    Camada* raiz = novaCamada(NULL, base);
+    cenario->topo = novaCamada(raiz, base);
+    largarCamada(raiz);
+    return cenario;
+}
+
+Cenario* ramificarCenario(Cenario* cenario) {
+    Cenario* ramo = (Cenario*)alocarZeros(1, sizeof(Cenario));
+    compactarCenario(cenario);
+    Camada* topo = cenario->topo;
+
+    // Um topo sem alterações não precisa de ser congelado: partilha-se o pai
+    if (topo->tamanho == 0) {
+        ramo->topo = novaCamada(topo->pai, topo->base);
+        return ramo;
+    }
+    cenario->topo = novaCamada(topo, topo->base);
+    ramo->topo = novaCamada(topo, topo->base);
+    largarCamada(topo);
+    return ramo;
+}
+
+void libertarCenario(Cenario* cenario) {
+    if (cenario == NULL) return;
+    largarCamada(cenario->topo);
+    free(cenario);
+}
+
+int cenarioInserirAntena(Cenario* cenario, char frequencia, int x, int y) {
+    compactarCenario(cenario);
+    Visita v = {cenario->topo, x, y, -1, NULL, 0, 0};
+    if (antenaVisivel(v.topo, x, y) != '\0') return 0;
+
+    // Só há pares a anular se a célula for hoje um efeito; fora do mapa as
+    // contagens não são guardadas, pelo que o varrimento é sempre feito
+    Mapa mapa = {v.topo->base->linhas, v.topo->base->colunas};
+    if (!pontoNoMapa(&mapa, x, y) || contagemVisivel(v.topo, x, y) > 0)
+        visitarAntenas(&v, -1, visitarBloqueio);
+    marcarAntena(v.topo, x, y, frequencia);
+    v.delta = 1;
+    visitarAntenas(&v, (unsigned char)frequencia, visitarPar);
+    free(v.pendentes);
+    return 1;
+}
+
+int cenarioRemoverAntena(Cenario* cenario, int x, int y) {
+    compactarCenario(cenario);
+    Visita v = {cenario->topo, x, y, -1, NULL, 0, 0};
+    char frequencia = antenaVisivel(v.topo, x, y);
+    if (frequencia == '\0') return 0;
+
+    visitarAntenas(&v, (unsigned char)frequencia, visitarPar);
+    marcarAntena(v.topo, x, y, CENARIO_LIVRE);
+    v.delta = 1;
+    visitarAntenas(&v, -1, visitarBloqueio);
+    free(v.pendentes);
+    return 1;
+}
+
+char cenarioAntena(const Cenario* cenario, int x, int y) {
+    return antenaVisivel(cenario->topo, x, y);
+}
+
+int cenarioTemEfeito(const Cenario* cenario, int x, int y) {
+    return contagemVisivel(cenario->topo, x, y) > 0;
+}
+
+/**
+ * @brief Vetor de nós usado para construir as listas de diferenças
+ */
+typedef struct {
+    Antena* dados;     ///< Elementos
+    size_t tamanho;    ///< Elementos usados
+    size_t capacidade; ///< Elementos reservados
+} VetorNos;
+
+/**
+ * @brief Acrescenta um nó ao vetor
+ */
+static void acrescentarNo(VetorNos* v, char frequencia, int x, int y) {
+    if (v->tamanho == v->capacidade) {
+        v->capacidade = v->capacidade ? v->capacidade * 2 : 16;
+        v->dados = (Antena*)realocar(v->dados, v->capacidade, sizeof(Antena));
+    }
+    v->dados[v->tamanho].frequencia = frequencia;
+    v->dados[v->tamanho].x = x;
+    v->dados[v->tamanho].y = y;
+    v->tamanho++;
+}
+
+/**
+ * @brief Compara dois nós por (x,y)
+ */
+static int compararNos(const void* a, const void* b) {
+    const Antena* p = (const Antena*)a;
+    const Antena* q = (const Antena*)b;
+    if (p->x != q->x) return (p->x > q->x) - (p->x < q->x);
+    return (p->y > q->y) - (p->y < q->y);
+}
+
+/**
+ * @brief Ordena o vetor e converte-o numa lista ligada, libertando-o
+ */
+static Antena* vetorParaLista(VetorNos* v) {
+    Antena* lista = NULL;
+    if (v->tamanho > 1) qsort(v->dados, v->tamanho, sizeof(Antena), compararNos);
+    for (size_t i = v->tamanho; i-- > 0; ) {
+        Antena* nova = criarAntena(v->dados[i].frequencia, v->dados[i].x, v->dados[i].y);
+        nova->prox = lista;
+        lista = nova;
+    }
+    free(v->dados);
+    return lista;
+}
+
+/**
+ * @brief Antepassado comum mais próximo de duas camadas
+ */
+static const Camada* antepassadoComum(const Camada* a, const Camada* b) {
+    while (a != NULL && b != NULL && a != b) {
+        if (a->profundidade >= b->profundidade) a = a->pai;
+        else b = b->pai;
+    }
+    return a == b ? a : NULL;
+}
+
+DiferencaCenarios diferencaCenarios(const Cenario* a, const Cenario* b) {
+    DiferencaCenarios d = {NULL, NULL, NULL, NULL};
+    VetorNos antenasA = {NULL, 0, 0}, antenasB = {NULL, 0, 0};
+    VetorNos efeitosA = {NULL, 0, 0}, efeitosB = {NULL, 0, 0};
+    const Camada* comum = antepassadoComum(a->topo, b->topo);
+    if (comum == NULL) {
+        fprintf(stderr, "Erro: Cenários com estados base diferentes\n");
+        return d;
+    }
+
+    // As células alteradas só abaixo do antepassado comum são iguais nos dois ramos
+    IndiceCoord* vistos = criarIndiceCoord(0, 0, 64);
+    const Camada* ramos[2] = {a->topo, b->topo};
+    for (int r = 0; r < 2; r++) {
+        for (const Camada* c = ramos[r]; c != comum; c = c->pai) {
+            for (size_t i = 0; i < c->capacidade; i++) {
+                if (!c->usados[i]) continue;
+                int x = xDaChave(c->chaves[i]), y = yDaChave(c->chaves[i]);
+                if (!indiceInserir(vistos, x, y)) continue;
+
+                char fa = antenaVisivel(a->topo, x, y), fb = antenaVisivel(b->topo, x, y);
+                if (fa != fb && fa != '\0') acrescentarNo(&antenasA, fa, x, y);
+                if (fa != fb && fb != '\0') acrescentarNo(&antenasB, fb, x, y);
+
+                int ea = contagemVisivel(a->topo, x, y) > 0, eb = contagemVisivel(b->topo, x, y) > 0;
+                if (ea && !eb) acrescentarNo(&efeitosA, '#', x, y);
+                if (eb && !ea) acrescentarNo(&efeitosB, '#', x, y);
+            }
+        }
+    }
+    libertarIndiceCoord(vistos);
+
+    d.antenasSoEmA = vetorParaLista(&antenasA);
+    d.antenasSoEmB = vetorParaLista(&antenasB);
+    d.efeitosSoEmA = vetorParaLista(&efeitosA);
+    d.efeitosSoEmB = vetorParaLista(&efeitosB);
+    return d;
+}
+
+void libertarDiferenca(DiferencaCenarios* diferenca) {
+    if (diferenca == NULL) return;
+    libertarLista(diferenca->antenasSoEmA);
+    libertarLista(diferenca->antenasSoEmB);
+    libertarLista(diferenca->efeitosSoEmA);
+    libertarLista(diferenca->efeitosSoEmB);
+    diferenca->antenasSoEmA = diferenca->antenasSoEmB = NULL;
+    diferenca->efeitosSoEmA = diferenca->efeitosSoEmB = NULL;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file conjunto.c
+ * @brief Implementação do conjunto de antenas em estrutura de vetores
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <stdint.h>
+ #include "conjunto.h"
+ #include "memoria.h"
+ #include "kernel.h"
+ #include "estatisticas.h"
+
+/**
+ * @brief Garante capacidade para pelo menos n elementos
+ */
+static void reservar(AntenaSet* conjunto, size_t n) {
+    if (n <= conjunto->capacidade) return;
+    size_t capacidade = conjunto->capacidade ? conjunto->capacidade : 16;
+    while (capacidade < n) capacidade *= 2;
+    conjunto->x = (int*)realocar(conjunto->x, capacidade, sizeof(int));
+    conjunto->y = (int*)realocar(conjunto->y, capacidade, sizeof(int));
+    conjunto->frequencia = (char*)realocar(conjunto->frequencia, capacidade, sizeof(char));
+    conjunto->capacidade = capacidade;
+}
+
+/**
+ * @brief Chave (x,y) acompanhada da posição original nos vetores
+ */
+typedef struct {
+    uint64_t chave;  ///< Chave de ordenação (ver chaveOrdenada)
+    size_t posicao;  ///< Posição do elemento no conjunto
+} ChavePosicao;
+
+/**
+ * @brief Primeira posição do grupo [ini,fim) com (x,y) >= (px,py)
+ */
+static size_t limiteInferior(const AntenaSet* c, size_t ini, size_t fim, int px, int py) {
+    while (ini < fim) {
+        size_t meio = ini + (fim - ini) / 2;
+        if (c->x[meio] < px || (c->x[meio] == px && c->y[meio] < py))
+            ini = meio + 1;
+        else
+            fim = meio;
+    }
+    return ini;
+}
+
+AntenaSet* criarConjunto(int linhas, int colunas, size_t capacidade) {
+    AntenaSet* conjunto = (AntenaSet*)alocarZeros(1, sizeof(AntenaSet));
+    conjunto->linhas = linhas;
+    conjunto->colunas = colunas;
+    conjunto->ocupadas = criarIndiceCoord(linhas, colunas, capacidade);
+    reservar(conjunto, capacidade);
+    return conjunto;
+}
+
+void libertarConjunto(AntenaSet* conjunto) {
+    if (conjunto == NULL) return;
+    free(conjunto->x);
+    free(conjunto->y);
+    free(conjunto->frequencia);
+    libertarIndiceCoord(conjunto->ocupadas);
+    free(conjunto);
+}
+
+int inserirNoConjunto(AntenaSet* conjunto, char frequencia, int x, int y) {
+    if (!indiceInserir(conjunto->ocupadas, x, y)) return 0;
+
+    int f = (unsigned char)frequencia;
+    size_t pos = limiteInferior(conjunto, conjunto->inicio[f], conjunto->inicio[f + 1], x, y);
+    size_t resto = conjunto->tamanho - pos;
+
+    reservar(conjunto, conjunto->tamanho + 1);
+    memmove(conjunto->x + pos + 1, conjunto->x + pos, resto * sizeof(int));
+    memmove(conjunto->y + pos + 1, conjunto->y + pos, resto * sizeof(int));
+    memmove(conjunto->frequencia + pos + 1, conjunto->frequencia + pos, resto);
+    conjunto->x[pos] = x;
+    conjunto->y[pos] = y;
+    conjunto->frequencia[pos] = frequencia;
+    conjunto->tamanho++;
+    for (int g = f + 1; g <= 256; g++) conjunto->inicio[g]++;
+    return 1;
+}
+
+int removerDoConjunto(AntenaSet* conjunto, int x, int y) {
+    size_t pos = procurarNoConjunto(conjunto, x, y);
+    if (pos == CONJUNTO_NAO_ENCONTRADO) return 0;
+
+    int f = (unsigned char)conjunto->frequencia[pos];
+    size_t resto = conjunto->tamanho - pos - 1;
+    memmove(conjunto->x + pos, conjunto->x + pos + 1, resto * sizeof(int));
+    memmove(conjunto->y + pos, conjunto->y + pos + 1, resto * sizeof(int));
+    memmove(conjunto->frequencia + pos, conjunto->frequencia + pos + 1, resto);
+    conjunto->tamanho--;
+    for (int g = f + 1; g <= 256; g++) conjunto->inicio[g]--;
+    indiceRemover(conjunto->ocupadas, x, y);
+    return 1;
+}
+
+int existeNoConjunto(const AntenaSet* conjunto, int x, int y) {
+    return existeNoIndice(conjunto->ocupadas, x, y);
+}
+
+size_t procurarNoConjunto(const AntenaSet* conjunto, int x, int y) {
+    if (!existeNoIndice(conjunto->ocupadas, x, y)) return CONJUNTO_NAO_ENCONTRADO;
+    for (int f = 0; f < 256; f++) {
+        size_t ini = conjunto->inicio[f], fim = conjunto->inicio[f + 1];
+        if (ini == fim) continue;
+        size_t pos = limiteInferior(conjunto, ini, fim, x, y);
+        if (pos < fim && conjunto->x[pos] == x && conjunto->y[pos] == y)
+            return pos;
+    }
+    return CONJUNTO_NAO_ENCONTRADO;
+}
+
+size_t procurarNoGrupo(const AntenaSet* conjunto, char frequencia, int x, int y) {
+    int f = (unsigned char)frequencia;
+    size_t fim = conjunto->inicio[f + 1];
+    size_t pos = limiteInferior(conjunto, conjunto->inicio[f], fim, x, y);
+    if (pos < fim && conjunto->x[pos] == x && conjunto->y[pos] == y)
+        return pos;
+    return CONJUNTO_NAO_ENCONTRADO;
+}
+
+AntenaSet* calcularEfeitoNefastoConjunto(const AntenaSet* conjunto) {
+    const int *xs = conjunto->x, *ys = conjunto->y;
+    KernelAlinhamento kernel = escolherKernelPara(xs, ys, conjunto->tamanho);
+    uint32_t alinhados[KERNEL_BLOCO];
+    uint8_t marcas[KERNEL_BLOCO];
+    uint64_t* pontos = NULL;
+    size_t total = 0, capacidade = 0;
+    unsigned long long paresAlinhados = 0;
+
+    for (int f = 0; f < 256; f++) {
+        size_t fim = conjunto->inicio[f + 1];
+        unsigned long long tamanhoGrupo = fim - conjunto->inicio[f];
+        ESTAT_SOMAR(paresComparados, tamanhoGrupo * (tamanhoGrupo - 1) / 2);
+        for (size_t i = conjunto->inicio[f]; i < fim; i++) {
+            for (size_t j0 = i + 1; j0 < fim; j0 += KERNEL_BLOCO) {
+                size_t n = fim - j0 < KERNEL_BLOCO ? fim - j0 : KERNEL_BLOCO;
+                size_t h = kernel(xs + j0, ys + j0, n, xs[i], ys[i],
+                                  conjunto->colunas, conjunto->linhas, alinhados, marcas);
+                paresAlinhados += h;
+                for (size_t k = 0; k < h; k++) {
+                    size_t j = j0 + alinhados[k];
+                    long long dx = (long long)xs[j] - xs[i];
+                    long long dy = (long long)ys[j] - ys[i];
+                    long long x1 = xs[i] - dx, y1 = ys[i] - dy;
+                    long long x2 = xs[j] + dx, y2 = ys[j] + dy;
+                    int valido1 = coordenadaRepresentavel(x1, y1);
+                    int valido2 = coordenadaRepresentavel(x2, y2);
+                    if ((valido1 && existeNoIndice(conjunto->ocupadas, (int)x1, (int)y1)) ||
+                        (valido2 && existeNoIndice(conjunto->ocupadas, (int)x2, (int)y2)))
+                        continue;
+
+                    if (total + 2 > capacidade) {
+                        capacidade = capacidade ? capacidade * 2 : 64;
+                        pontos = (uint64_t*)realocar(pontos, capacidade, sizeof(uint64_t));
+                    }
+                    if (valido1 && (marcas[k] & KERNEL_PONTO1))
+                        pontos[total++] = chaveOrdenada((int)x1, (int)y1);
+                    if (valido2 && (marcas[k] & KERNEL_PONTO2))
+                        pontos[total++] = chaveOrdenada((int)x2, (int)y2);
+                }
+            }
+        }
+    }
+
+    ESTAT_SOMAR(paresPossiveis, (unsigned long long)conjunto->tamanho * (conjunto->tamanho - 1) / 2);
+    ESTAT_SOMAR(paresAlinhados, paresAlinhados);
+    ESTAT_SOMAR(verificacoesColisao, 2 * paresAlinhados);
+    ESTAT_SOMAR(efeitosEmitidos, total);
+
+    // Ordenação e deduplicação; todos os efeitos formam o grupo '#'
+    if (total > 0) qsort(pontos, total, sizeof(uint64_t), compararChaves);
+    AntenaSet* efeitos = criarConjunto(conjunto->linhas, conjunto->colunas, total);
+    for (size_t i = 0; i < total; i++) {
+        if (i > 0 && pontos[i] == pontos[i - 1]) continue;
+        size_t k = efeitos->tamanho++;
+        efeitos->x[k] = xDaChave(pontos[i]);
+        efeitos->y[k] = yDaChave(pontos[i]);
+        efeitos->frequencia[k] = '#';
+        indiceInserir(efeitos->ocupadas, efeitos->x[k], efeitos->y[k]);
+    }
+    for (int g = (unsigned char)'#' + 1; g <= 256; g++) efeitos->inicio[g] = efeitos->tamanho;
+    ESTAT_SOMAR(efeitosUnicos, efeitos->tamanho);
+    free(pontos);
+    return efeitos;
+}
+
+AntenaSet* conjuntoDeLista(Antena* lista, int linhas, int colunas) {
+    size_t n = 0;
+    size_t contagem[257] = {0};
+    for (Antena* a = lista; a != NULL; a = a->prox) {
+        contagem[(unsigned char)a->frequencia + 1]++;
+        n++;
+    }
+
+    AntenaSet* conjunto = criarConjunto(linhas, colunas, n);
+    for (int f = 0; f < 256; f++) contagem[f + 1] += contagem[f];
+    memcpy(conjunto->inicio, contagem, sizeof(contagem));
+
+    // Distribuição estável: dentro de cada grupo mantém-se a ordem (x,y) da lista
+    for (Antena* a = lista; a != NULL; a = a->prox) {
+        indiceInserir(conjunto->ocupadas, a->x, a->y);
+        size_t k = contagem[(unsigned char)a->frequencia]++;
+        conjunto->x[k] = a->x;
+        conjunto->y[k] = a->y;
+        conjunto->frequencia[k] = a->frequencia;
+    }
+    conjunto->tamanho = n;
+    return conjunto;
+}
+
+Antena* conjuntoParaLista(const AntenaSet* conjunto) {
+    size_t n = conjunto->tamanho;
+    if (n == 0) return NULL;
+
+    // Ordena as posições pela chave (x,y), juntando os grupos de frequência
+    ChavePosicao* ordem = (ChavePosicao*)realocar(NULL, n, sizeof(ChavePosicao));
+    for (size_t i = 0; i < n; i++) {
+        ordem[i].chave = chaveOrdenada(conjunto->x[i], conjunto->y[i]);
+        ordem[i].posicao = i;
+    }
+    qsort(ordem, n, sizeof(ChavePosicao), compararChaves);
+
+    Antena* lista = NULL;
+    for (size_t i = n; i-- > 0; ) {
+        size_t k = ordem[i].posicao;
+        Antena* no = criarAntena(conjunto->frequencia[k], conjunto->x[k], conjunto->y[k]);
+        no->prox = lista;
+        lista = no;
+    }
+    free(ordem);
+    return lista;
+}
\ No newline at end of file
@@ -0,0 +1,573 @@
+/**
+ * @file consulta.c
+ * @brief Implementação das consultas preguiçosas de efeitos por região
+ *
+ * @details Um ladrilho em falta é calculado isoladamente (pesquisa binária
+ * dos parceiros possíveis de cada antena). Quando faltam tantos ladrilhos
+ * de uma frequência que isso sairia mais caro do que percorrer todos os
+ * pares do grupo, os pares são percorridos uma vez com o núcleo de
+ * alinhamento e todos os ladrilhos da frequência ficam preenchidos.
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <limits.h>
+ #include "consulta.h"
+ #include "memoria.h"
+ #include "kernel.h"
+
+/**
+ * @brief Ladrilho calculado de uma frequência
+ */
+struct EntradaLadrilho {
+    uint64_t chave;       ///< Frequência e coordenadas do ladrilho (ver chaveLadrilho)
+    uint64_t versao;      ///< Versão da frequência no cálculo (0: inválido)
+    Coordenada* pontos;   ///< Efeitos do ladrilho, ordenados por (x,y)
+    size_t n;             ///< Número de efeitos
+    int usada;            ///< 1 se a posição está ocupada
+};
+
+/**
+ * @brief Ladrilho de um ponto projetado, com a sua frequência
+ */
+typedef struct {
+    uint64_t chave; ///< Chave do ladrilho
+    Coordenada p;   ///< Ponto de efeito
+} PontoLadrilho;
+
+/**
+ * @brief Direções das linhas de alinhamento (as de antenasAlinhadas)
+ *
+ * @note Cada par alinhado está numa única linha de uma destas direções
+ */
+static const int DIRECOES[CONSULTA_DIRECOES][2] = {
+    {1, 0}, {0, 1}, {1, 1}, {1, -1}, {1, 2}, {1, -2},
+    {2, 1}, {2, -1}, {1, 3}, {1, -3}, {3, 1}, {3, -1}
+};
+
+/**
+ * @brief Antena de um grupo vista numa direção: linha e posição na linha
+ */
+typedef struct {
+    long long c; ///< Linha (b·x - a·y)
+    long long s; ///< Posição ao longo da linha (a·x + b·y)
+} PosicaoLinha;
+
+/**
+ * @brief Índice de linhas de uma frequência: para cada direção, as antenas ordenadas por (c,s)
+ */
+struct LinhasFrequencia {
+    uint64_t versao;                              ///< Versão da frequência indexada
+    size_t n;                                     ///< Antenas do grupo
+    PosicaoLinha* posicoes[CONSULTA_DIRECOES];    ///< Um vetor por direção
+};
+
+/**
+ * @brief Divisão inteira arredondada para baixo pelo lado do ladrilho
+ */
+static long long ladrilho(long long v) {
+    return v >= 0 ? v / CONSULTA_LADRILHO : -((-v + CONSULTA_LADRILHO - 1) / CONSULTA_LADRILHO);
+}
+
+/**
+ * @brief Chave de 64 bits de (frequência, tx, ty)
+ *
+ * @note Com coordenadas int, |tx| e |ty| ficam abaixo de 2^26
+ */
+static uint64_t chaveLadrilho(int f, long long tx, long long ty) {
+    return ((uint64_t)(unsigned)f << 56) |
+           ((uint64_t)(tx + (1LL << 27)) << 28) |
+           (uint64_t)(ty + (1LL << 27));
+}
+
+/**
+ * @brief Comparação de coordenadas por (x,y) para qsort
+ */
+static int compararCoordenadas(const void* a, const void* b) {
+    const Coordenada* p = (const Coordenada*)a;
+    const Coordenada* q = (const Coordenada*)b;
+    if (p->x != q->x) return (p->x > q->x) - (p->x < q->x);
+    return (p->y > q->y) - (p->y < q->y);
+}
+
+/**
+ * @brief Comparação por ladrilho e depois por (x,y) para qsort
+ */
+static int compararPontosLadrilho(const void* a, const void* b) {
+    const PontoLadrilho* p = (const PontoLadrilho*)a;
+    const PontoLadrilho* q = (const PontoLadrilho*)b;
+    if (p->chave != q->chave) return (p->chave > q->chave) - (p->chave < q->chave);
+    return compararCoordenadas(&p->p, &q->p);
+}
+
+/**
+ * @brief Ordena e remove repetições de um vetor de coordenadas
+ *
+ * @return size_t Novo número de elementos
+ */
+static size_t ordenarSemRepetidos(Coordenada* v, size_t n) {
+    if (n < 2) return n;
+    qsort(v, n, sizeof(Coordenada), compararCoordenadas);
+    size_t k = 1;
+    for (size_t i = 1; i < n; i++)
+        if (v[i].x != v[k - 1].x || v[i].y != v[k - 1].y) v[k++] = v[i];
+    return k;
+}
+
+/**
+ * @brief Procura a posição de uma chave (ou a posição livre onde ficaria)
+ */
+static EntradaLadrilho* posicao(ConsultaEfeitos* consulta, uint64_t chave) {
+    size_t mascara = consulta->capacidade - 1;
+    size_t i = dispersarChave(chave) & mascara;
+    while (consulta->entradas[i].usada && consulta->entradas[i].chave != chave)
+        i = (i + 1) & mascara;
+    return &consulta->entradas[i];
+}
+
+/**
+ * @brief Reserva a tabela com a capacidade indicada, mantendo as entradas
+ */
+static void redimensionar(ConsultaEfeitos* consulta, size_t capacidade) {
+    EntradaLadrilho* antigas = consulta->entradas;
+    size_t capacidadeAntiga = consulta->capacidade;
+    consulta->entradas = (EntradaLadrilho*)alocarZeros(capacidade, sizeof(EntradaLadrilho));
+    consulta->capacidade = capacidade;
+    for (size_t i = 0; i < capacidadeAntiga; i++)
+        if (antigas[i].usada) *posicao(consulta, antigas[i].chave) = antigas[i];
+    free(antigas);
+}
+
+/**
+ * @brief Devolve a entrada de uma chave, criando-a (inválida) se não existir
+ */
+static EntradaLadrilho* entrada(ConsultaEfeitos* consulta, uint64_t chave) {
+    EntradaLadrilho* e = posicao(consulta, chave);
+    if (e->usada) return e;
+    if ((consulta->usadas + 1) * 10 > consulta->capacidade * 7) {
+        redimensionar(consulta, consulta->capacidade * 2);
+        e = posicao(consulta, chave);
+    }
+    e->usada = 1;
+    e->chave = chave;
+    consulta->usadas++;
+    return e;
+}
+
+/**
+ * @brief Substitui os efeitos guardados de uma entrada
+ */
+static void guardar(EntradaLadrilho* e, uint64_t versao, Coordenada* pontos, size_t n) {
+    free(e->pontos);
+    e->pontos = pontos;
+    e->n = n;
+    e->versao = versao;
+}
+
+/**
+ * @brief Ordenação por (linha, posição) para qsort
+ */
+static int compararPosicoes(const void* a, const void* b) {
+    const PosicaoLinha* p = (const PosicaoLinha*)a;
+    const PosicaoLinha* q = (const PosicaoLinha*)b;
+    if (p->c != q->c) return (p->c > q->c) - (p->c < q->c);
+    return (p->s > q->s) - (p->s < q->s);
+}
+
+/**
+ * @brief Devolve o índice de linhas de uma frequência, reconstruindo-o se desatualizado
+ *
+ * @details Para a direção (a,b), a antena (x,y) fica na linha c = b·x - a·y
+ * na posição s = a·x + b·y; (x,y) recupera-se de (c,s) dividindo
+ * a·s + b·c e b·s - a·c por a² + b². Com coordenadas abaixo de
+ * KERNEL_COORD_MAXIMA, c e s cabem em 32 bits e a ordenação é um radix
+ * sort da chave (c,s); caso contrário usa-se qsort.
+ */
+static const LinhasFrequencia* linhasDe(ConsultaEfeitos* consulta, int f) {
+    LinhasFrequencia* l = consulta->linhas[f];
+    if (l != NULL && l->versao == consulta->versoes[f]) return l;
+    if (l == NULL) {
+        l = (LinhasFrequencia*)alocarZeros(1, sizeof(LinhasFrequencia));
+        consulta->linhas[f] = l;
+    }
+
+    const AntenaSet* s = consulta->conjunto;
+    size_t ini = s->inicio[f], n = s->inicio[f + 1] - ini;
+    int compacto = 1;
+    for (size_t i = 0; compacto && i < n; i++)
+        compacto = s->x[ini + i] > -KERNEL_COORD_MAXIMA && s->x[ini + i] < KERNEL_COORD_MAXIMA &&
+                   s->y[ini + i] > -KERNEL_COORD_MAXIMA && s->y[ini + i] < KERNEL_COORD_MAXIMA;
+    uint64_t* chaves = compacto ? (uint64_t*)realocar(NULL, n, sizeof(uint64_t)) : NULL;
+
+    for (int d = 0; d < CONSULTA_DIRECOES; d++) {
+        long long a = DIRECOES[d][0], b = DIRECOES[d][1];
+        PosicaoLinha* v = (PosicaoLinha*)realocar(l->posicoes[d], n, sizeof(PosicaoLinha));
+        l->posicoes[d] = v;
+        for (size_t i = 0; i < n; i++) {
+            v[i].c = b * s->x[ini + i] - a * s->y[ini + i];
+            v[i].s = a * s->x[ini + i] + b * s->y[ini + i];
+        }
+        if (!compacto) {
+            qsort(v, n, sizeof(PosicaoLinha), compararPosicoes);
+            continue;
+        }
+        for (size_t i = 0; i < n; i++)
+            chaves[i] = chaveOrdenada((int)v[i].c, (int)v[i].s);
+        ordenarPorChave(chaves, NULL, n);
+        for (size_t i = 0; i < n; i++) {
+            v[i].c = xDaChave(chaves[i]);
+            v[i].s = yDaChave(chaves[i]);
+        }
+    }
+    free(chaves);
+    l->n = n;
+    l->versao = consulta->versoes[f];
+    return l;
+}
+
+/**
+ * @brief Primeira posição de v[0,n) com c >= valor
+ */
+static size_t primeiraLinha(const PosicaoLinha* v, size_t n, long long valor) {
+    size_t ini = 0, fim = n;
+    while (ini < fim) {
+        size_t meio = ini + (fim - ini) / 2;
+        if (v[meio].c < valor) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini;
+}
+
+/**
+ * @brief Primeira posição de v[ini,fim) com s >= valor (dentro de uma linha)
+ */
+static size_t primeiraPosicao(const PosicaoLinha* v, size_t ini, size_t fim, long long valor) {
+    while (ini < fim) {
+        size_t meio = ini + (fim - ini) / 2;
+        if (v[meio].s < valor) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini;
+}
+
+/**
+ * @brief Calcula os efeitos de uma frequência num ladrilho
+ *
+ * @details Cada ponto de efeito é p = 2u - v, com u, v e p na mesma linha
+ * de uma das direções; na posição ao longo da linha, s(v) = 2·s(u) - s(p).
+ * Só são visitadas as linhas que atravessam o ladrilho e, em cada uma, os
+ * v cuja posição põe p dentro do intervalo de posições do ladrilho.
+ */
+static void calcularLadrilho(ConsultaEfeitos* consulta, int f, long long tx, long long ty,
+                             EntradaLadrilho* e, uint64_t versao) {
+    const AntenaSet* s = consulta->conjunto;
+    long long X0 = tx * CONSULTA_LADRILHO, X1 = X0 + CONSULTA_LADRILHO - 1;
+    long long Y0 = ty * CONSULTA_LADRILHO, Y1 = Y0 + CONSULTA_LADRILHO - 1;
+    // Mesmo domínio que pontoNoMapa: x, y >= 0 e cada eixo limitado se a dimensão for positiva
+    if (X0 < 0) X0 = 0;
+    if (Y0 < 0) Y0 = 0;
+    if (s->colunas > 0 && X1 > s->colunas - 1) X1 = s->colunas - 1;
+    if (s->linhas > 0 && Y1 > s->linhas - 1) Y1 = s->linhas - 1;
+    if (X1 > INT_MAX) X1 = INT_MAX;
+    if (Y1 > INT_MAX) Y1 = INT_MAX;
+    if (X0 > X1 || Y0 > Y1 || s->inicio[f + 1] - s->inicio[f] < 2) {
+        guardar(e, versao, NULL, 0);
+        return;
+    }
+
+    const LinhasFrequencia* l = linhasDe(consulta, f);
+    Coordenada* pontos = NULL;
+    size_t n = 0, capacidade = 0;
+
+    for (int d = 0; d < CONSULTA_DIRECOES; d++) {
+        long long a = DIRECOES[d][0], b = DIRECOES[d][1], norma = a * a + b * b;
+        const PosicaoLinha* v = l->posicoes[d];
+        // c e s são lineares: os extremos no ladrilho estão nos cantos
+        long long c0 = b * X0 - a * Y0, c1 = b * X1 - a * Y1, c2 = b * X0 - a * Y1, c3 = b * X1 - a * Y0;
+        long long s0 = a * X0 + b * Y0, s1 = a * X1 + b * Y1, s2 = a * X0 + b * Y1, s3 = a * X1 + b * Y0;
+        long long cMin = c0 < c1 ? c0 : c1, cMax = c0 < c1 ? c1 : c0;
+        long long sMin = s0 < s1 ? s0 : s1, sMax = s0 < s1 ? s1 : s0;
+        if (c2 < cMin) cMin = c2;
+        if (c3 < cMin) cMin = c3;
+        if (c2 > cMax) cMax = c2;
+        if (c3 > cMax) cMax = c3;
+        if (s2 < sMin) sMin = s2;
+        if (s3 < sMin) sMin = s3;
+        if (s2 > sMax) sMax = s2;
+        if (s3 > sMax) sMax = s3;
+
+        for (size_t i = primeiraLinha(v, l->n, cMin); i < l->n && v[i].c <= cMax; ) {
+            size_t fimLinha = i + 1;
+            while (fimLinha < l->n && v[fimLinha].c == v[i].c) fimLinha++;
+            long long c = v[i].c;
+            for (size_t u = i; u < fimLinha; u++) {
+                long long sLimite = 2 * v[u].s - sMin;
+                for (size_t w = primeiraPosicao(v, i, fimLinha, 2 * v[u].s - sMax);
+                     w < fimLinha && v[w].s <= sLimite; w++) {
+                    if (w == u) continue;
+                    long long sp = 2 * v[u].s - v[w].s, sq = 2 * v[w].s - v[u].s;
+                    long long px = (a * sp + b * c) / norma, py = (b * sp - a * c) / norma;
+                    if (px < X0 || px > X1 || py < Y0 || py > Y1) continue;
+                    long long qx = (a * sq + b * c) / norma, qy = (b * sq - a * c) / norma;
+                    if (existeNoIndice(s->ocupadas, (int)px, (int)py) ||
+                        (coordenadaRepresentavel(qx, qy) && existeNoIndice(s->ocupadas, (int)qx, (int)qy)))
+                        continue;
+                    if (n == capacidade) {
+                        capacidade = capacidade ? capacidade * 2 : 16;
+                        pontos = (Coordenada*)realocar(pontos, capacidade, sizeof(Coordenada));
+                    }
+                    pontos[n].x = (int)px;
+                    pontos[n].y = (int)py;
+                    n++;
+                }
+            }
+            i = fimLinha;
+        }
+    }
+    guardar(e, versao, pontos, ordenarSemRepetidos(pontos, n));
+}
+
+/**
+ * @brief Percorre todos os pares de uma frequência e preenche todos os seus ladrilhos
+ */
+static void preencherFrequencia(ConsultaEfeitos* consulta, int f) {
+    const AntenaSet* s = consulta->conjunto;
+    const int *xs = s->x, *ys = s->y;
+    size_t ini = s->inicio[f], fim = s->inicio[f + 1];
+    uint64_t versao = consulta->versoes[f];
+    KernelAlinhamento kernel = escolherKernelPara(xs + ini, ys + ini, fim - ini);
+    uint32_t alinhados[KERNEL_BLOCO];
+    uint8_t marcas[KERNEL_BLOCO];
+    PontoLadrilho* pontos = NULL;
+    size_t total = 0, capacidade = 0;
+
+    for (size_t i = ini; i < fim; i++) {
+        for (size_t j0 = i + 1; j0 < fim; j0 += KERNEL_BLOCO) {
+            size_t n = fim - j0 < KERNEL_BLOCO ? fim - j0 : KERNEL_BLOCO;
+            size_t h = kernel(xs + j0, ys + j0, n, xs[i], ys[i], s->colunas, s->linhas, alinhados, marcas);
+            for (size_t k = 0; k < h; k++) {
+                size_t j = j0 + alinhados[k];
+                long long dx = (long long)xs[j] - xs[i];
+                long long dy = (long long)ys[j] - ys[i];
+                long long x1 = xs[i] - dx, y1 = ys[i] - dy;
+                long long x2 = xs[j] + dx, y2 = ys[j] + dy;
+                int valido1 = coordenadaRepresentavel(x1, y1);
+                int valido2 = coordenadaRepresentavel(x2, y2);
+                if ((valido1 && existeNoIndice(s->ocupadas, (int)x1, (int)y1)) ||
+                    (valido2 && existeNoIndice(s->ocupadas, (int)x2, (int)y2)))
+                    continue;
+                if (total + 2 > capacidade) {
+                    capacidade = capacidade ? capacidade * 2 : 64;
+                    pontos = (PontoLadrilho*)realocar(pontos, capacidade, sizeof(PontoLadrilho));
+                }
+                if (valido1 && (marcas[k] & KERNEL_PONTO1)) {
+                    pontos[total].chave = chaveLadrilho(f, ladrilho(x1), ladrilho(y1));
+                    pontos[total].p.x = (int)x1;
+                    pontos[total++].p.y = (int)y1;
+                }
+                if (valido2 && (marcas[k] & KERNEL_PONTO2)) {
+                    pontos[total].chave = chaveLadrilho(f, ladrilho(x2), ladrilho(y2));
+                    pontos[total].p.x = (int)x2;
+                    pontos[total++].p.y = (int)y2;
+                }
+            }
+        }
+    }
+
+    if (total > 1) qsort(pontos, total, sizeof(PontoLadrilho), compararPontosLadrilho);
+    for (size_t i = 0; i < total; ) {
+        size_t j = i;
+        while (j < total && pontos[j].chave == pontos[i].chave) j++;
+        Coordenada* v = (Coordenada*)realocar(NULL, j - i, sizeof(Coordenada));
+        size_t n = 0;
+        for (size_t k = i; k < j; k++)
+            if (n == 0 || pontos[k].p.x != v[n - 1].x || pontos[k].p.y != v[n - 1].y) v[n++] = pontos[k].p;
+        guardar(entrada(consulta, pontos[i].chave), versao, v, n);
+        i = j;
+    }
+    free(pontos);
+    consulta->completas[f] = versao;
+}
+
+/**
+ * @brief Devolve os efeitos guardados de um ladrilho, calculando-os se preciso
+ */
+static const EntradaLadrilho* obterLadrilho(ConsultaEfeitos* consulta, int f, long long tx, long long ty) {
+    static const EntradaLadrilho vazio = {0, 0, NULL, 0, 0};
+    uint64_t chave = chaveLadrilho(f, tx, ty);
+    uint64_t versao = consulta->versoes[f];
+    EntradaLadrilho* e = posicao(consulta, chave);
+    if (e->usada && e->versao == versao) {
+        consulta->acertos++;
+        return e;
+    }
+    if (!e->usada && consulta->completas[f] == versao) {
+        consulta->acertos++;  // Frequência preenchida por inteiro: ladrilho sem efeitos
+        return &vazio;
+    }
+    consulta->falhas++;
+    e = entrada(consulta, chave);
+    calcularLadrilho(consulta, f, tx, ty, e, versao);
+    return e;
+}
+
+/**
+ * @brief Conta os ladrilhos de uma frequência que ainda não estão guardados
+ */
+static size_t ladrilhosEmFalta(ConsultaEfeitos* consulta, int f, long long tx0, long long ty0,
+                               long long tx1, long long ty1) {
+    uint64_t versao = consulta->versoes[f];
+    if (consulta->completas[f] == versao) return 0;
+    size_t falta = 0;
+    for (long long tx = tx0; tx <= tx1; tx++) {
+        for (long long ty = ty0; ty <= ty1; ty++) {
+            const EntradaLadrilho* e = posicao(consulta, chaveLadrilho(f, tx, ty));
+            if (!e->usada || e->versao != versao) falta++;
+        }
+    }
+    return falta;
+}
+
+ConsultaEfeitos* criarConsulta(AntenaSet* conjunto) {
+    ConsultaEfeitos* consulta = (ConsultaEfeitos*)alocarZeros(1, sizeof(ConsultaEfeitos));
+    consulta->conjunto = conjunto;
+    for (int f = 0; f < 256; f++) consulta->versoes[f] = 1;
+    redimensionar(consulta, 256);
+    return consulta;
+}
+
+void libertarConsulta(ConsultaEfeitos* consulta) {
+    if (consulta == NULL) return;
+    for (size_t i = 0; i < consulta->capacidade; i++) free(consulta->entradas[i].pontos);
+    free(consulta->entradas);
+    for (int f = 0; f < 256; f++) {
+        if (consulta->linhas[f] == NULL) continue;
+        for (int d = 0; d < CONSULTA_DIRECOES; d++) free(consulta->linhas[f]->posicoes[d]);
+        free(consulta->linhas[f]);
+    }
+    libertarConjunto(consulta->conjunto);
+    free(consulta);
+}
+
+Coordenada* consultarEfeitos(ConsultaEfeitos* consulta, const char* frequencias,
+                             int x0, int y0, int x1, int y1, size_t* n) {
+    const AntenaSet* s = consulta->conjunto;
+    long long X0 = x0, Y0 = y0, X1 = x1, Y1 = y1;
+    *n = 0;
+    if (X0 < 0) X0 = 0;
+    if (Y0 < 0) Y0 = 0;
+    if (s->colunas > 0 && X1 > s->colunas - 1) X1 = s->colunas - 1;
+    if (s->linhas > 0 && Y1 > s->linhas - 1) Y1 = s->linhas - 1;
+    if (X0 > X1 || Y0 > Y1) return NULL;
+
+    int pedidas[256];
+    int todas = frequencias == NULL || frequencias[0] == '\0';
+    memset(pedidas, 0, sizeof(pedidas));
+    for (const char* p = todas ? "" : frequencias; *p != '\0'; p++) pedidas[(unsigned char)*p] = 1;
+
+    long long tx0 = ladrilho(X0), tx1 = ladrilho(X1), ty0 = ladrilho(Y0), ty1 = ladrilho(Y1);
+    Coordenada* resultado = NULL;
+    size_t total = 0, capacidade = 0, partes = 0;
+
+    for (int f = 0; f < 256; f++) {
+        size_t k = s->inicio[f + 1] - s->inicio[f];
+        if ((!todas && !pedidas[f]) || k < 2) continue;
+
+        // Cada ladrilho custa, por direção, duas pesquisas e as antenas das
+        // linhas que o atravessam; o grupo todo custa k²/2 testes vetoriais
+        size_t falta = ladrilhosEmFalta(consulta, f, tx0, ty0, tx1, ty1);
+        if (falta > 0) {
+            double extensao = s->colunas > 0 && s->linhas > 0
+                ? (double)(s->colunas > s->linhas ? s->colunas : s->linhas)
+                : (double)s->x[s->inicio[f + 1] - 1] - s->x[s->inicio[f]] + 1.0;
+            double logk = 1.0;
+            while ((double)((size_t)1 << (size_t)logk) < (double)k) logk += 1.0;
+            double porLadrilho = CONSULTA_DIRECOES * (2.0 * logk + (double)k * CONSULTA_LADRILHO / extensao);
+            if ((double)falta * porLadrilho > (double)k * (double)k / 16.0) preencherFrequencia(consulta, f);
+        }
+
+        for (long long tx = tx0; tx <= tx1; tx++) {
+            for (long long ty = ty0; ty <= ty1; ty++) {
+                const EntradaLadrilho* e = obterLadrilho(consulta, f, tx, ty);
+                if (e->n == 0) continue;
+                partes++;
+                if (total + e->n > capacidade) {
+                    while (total + e->n > capacidade) capacidade = capacidade ? capacidade * 2 : 64;
+                    resultado = (Coordenada*)realocar(resultado, capacidade, sizeof(Coordenada));
+                }
+                for (size_t i = 0; i < e->n; i++) {
+                    if (e->pontos[i].x < X0 || e->pontos[i].x > X1 ||
+                        e->pontos[i].y < Y0 || e->pontos[i].y > Y1)
+                        continue;
+                    resultado[total++] = e->pontos[i];
+                }
+            }
+        }
+    }
+    *n = partes > 1 ? ordenarSemRepetidos(resultado, total) : total;
+    if (*n == 0) {
+        free(resultado);
+        return NULL;
+    }
+    return resultado;
+}
+
+/**
+ * @brief Invalida um ladrilho de uma frequência (a passagem completa deixa de valer)
+ */
+static void invalidarLadrilho(ConsultaEfeitos* consulta, int f, long long x, long long y) {
+    consulta->completas[f] = 0;
+    if (!coordenadaRepresentavel(x, y)) return;
+    EntradaLadrilho* e = posicao(consulta, chaveLadrilho(f, ladrilho(x), ladrilho(y)));
+    if (e->usada) e->versao = 0;
+}
+
+/**
+ * @brief Invalida o que depende da célula (px,py) após uma alteração na frequência f
+ *
+ * @details A frequência f muda de versão. Nas outras, ocupar ou libertar a
+ * célula só afeta os pares com um ponto projetado nela: para cada antena u
+ * o parceiro seria v = 2u - p, procurado no índice e no grupo.
+ */
+static void invalidarCelula(ConsultaEfeitos* consulta, int f, int px, int py) {
+    const AntenaSet* s = consulta->conjunto;
+    consulta->versoes[f]++;
+    for (int g = 0; g < 256; g++) {
+        size_t ini = s->inicio[g], fim = s->inicio[g + 1];
+        if (g == f || fim - ini < 2) continue;
+        for (size_t u = ini; u < fim; u++) {
+            long long vx = 2LL * s->x[u] - px, vy = 2LL * s->y[u] - py;
+            if (!coordenadaRepresentavel(vx, vy) || (vx == s->x[u] && vy == s->y[u])) continue;
+            if (!existeNoIndice(s->ocupadas, (int)vx, (int)vy)) continue;
+            if (procurarNoGrupo(s, (char)g, (int)vx, (int)vy) == CONJUNTO_NAO_ENCONTRADO) continue;
+            if (!antenasAlinhadas(vx - s->x[u], vy - s->y[u])) continue;
+            invalidarLadrilho(consulta, g, px, py);
+            invalidarLadrilho(consulta, g, 2 * vx - s->x[u], 2 * vy - s->y[u]);
+        }
+    }
+}
+
+int consultaInserirAntena(ConsultaEfeitos* consulta, char frequencia, int x, int y) {
+    if (!inserirNoConjunto(consulta->conjunto, frequencia, x, y)) return 0;
+    invalidarCelula(consulta, (unsigned char)frequencia, x, y);
+    return 1;
+}
+
+int consultaRemoverAntena(ConsultaEfeitos* consulta, int x, int y) {
+    size_t pos = procurarNoConjunto(consulta->conjunto, x, y);
+    if (pos == CONJUNTO_NAO_ENCONTRADO) return 0;
+    int f = (unsigned char)consulta->conjunto->frequencia[pos];
+    removerDoConjunto(consulta->conjunto, x, y);
+    invalidarCelula(consulta, f, x, y);
+    return 1;
+}
@@ -0,0 +1,228 @@
+/**
+ * @file esparso.c
+ * @brief Implementação da representação comprimida por linhas (CSR)
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <stdint.h>
+ #include "esparso.h"
+ #include "memoria.h"
+
+MapaEsparso* esparsoOrdenado(int linhas, int colunas, int* coluna, char* carac, const int* y, size_t n) {
+    MapaEsparso* mapa = (MapaEsparso*)alocarZeros(1, sizeof(MapaEsparso));
+    mapa->linhas = linhas;
+    mapa->colunas = colunas;
+    mapa->coluna = coluna != NULL ? coluna : (int*)realocar(NULL, 0, sizeof(int));
+    mapa->carac = carac != NULL ? carac : (char*)realocar(NULL, 0, sizeof(char));
+    mapa->tamanho = n;
+
+    size_t r = 0;
+    for (size_t k = 0; k < n; k++)
+        if (k == 0 || y[k] != y[k - 1]) r++;
+    mapa->numLinhas = r;
+    mapa->linha = (int*)realocar(NULL, r, sizeof(int));
+    mapa->inicio = (size_t*)realocar(NULL, r + 1, sizeof(size_t));
+    r = 0;
+    for (size_t k = 0; k < n; k++) {
+        if (k > 0 && y[k] == y[k - 1]) continue;
+        mapa->linha[r] = y[k];
+        mapa->inicio[r++] = k;
+    }
+    mapa->inicio[r] = n;
+    return mapa;
+}
+
+/**
+ * @brief Cria um mapa a partir de vetores de coordenadas e caracteres
+ */
+static MapaEsparso* construir(const int* xs, const int* ys, const char* caracs, size_t n,
+                              int linhas, int colunas) {
+    uint64_t* chaves = (uint64_t*)realocar(NULL, n, sizeof(uint64_t));
+    size_t* posicoes = (size_t*)realocar(NULL, n, sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        chaves[i] = chaveOrdenada(ys[i], xs[i]);
+        posicoes[i] = i;
+    }
+    ordenarPorChave(chaves, posicoes, n);
+
+    // Ordenação estável: numa célula repetida fica o primeiro elemento
+    int* coluna = (int*)realocar(NULL, n, sizeof(int));
+    char* carac = (char*)realocar(NULL, n, sizeof(char));
+    int* y = (int*)realocar(NULL, n, sizeof(int));
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (i > 0 && chaves[i] == chaves[i - 1]) continue;
+        coluna[k] = xs[posicoes[i]];
+        y[k] = ys[posicoes[i]];
+        carac[k] = caracs[posicoes[i]];
+        k++;
+    }
+    free(chaves);
+    free(posicoes);
+
+    MapaEsparso* mapa = esparsoOrdenado(linhas, colunas, (int*)realocar(coluna, k, sizeof(int)),
+                                        (char*)realocar(carac, k, sizeof(char)), y, k);
+    free(y);
+    return mapa;
+}
+
+MapaEsparso* esparsoDeLista(Antena* lista, int linhas, int colunas) {
+    size_t n = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox) n++;
+
+    int* xs = (int*)realocar(NULL, n, sizeof(int));
+    int* ys = (int*)realocar(NULL, n, sizeof(int));
+    char* caracs = (char*)realocar(NULL, n, sizeof(char));
+    size_t i = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox, i++) {
+        xs[i] = a->x;
+        ys[i] = a->y;
+        caracs[i] = a->frequencia;
+    }
+    MapaEsparso* mapa = construir(xs, ys, caracs, n, linhas, colunas);
+    free(xs);
+    free(ys);
+    free(caracs);
+    return mapa;
+}
+
+MapaEsparso* esparsoDeConjunto(const AntenaSet* conjunto) {
+    return construir(conjunto->x, conjunto->y, conjunto->frequencia, conjunto->tamanho,
+                     conjunto->linhas, conjunto->colunas);
+}
+
+AntenaSet* conjuntoDeEsparso(const MapaEsparso* mapa) {
+    size_t n = mapa->tamanho;
+    AntenaSet* conjunto = criarConjunto(mapa->linhas, mapa->colunas, n);
+
+    // (x,y) por radix sort e depois frequência por counting sort estável
+    uint64_t* chaves = (uint64_t*)realocar(NULL, n, sizeof(uint64_t));
+    size_t* posicoes = (size_t*)realocar(NULL, n, sizeof(size_t));
+    int* ys = (int*)realocar(NULL, n, sizeof(int));
+    for (size_t r = 0; r < mapa->numLinhas; r++) {
+        for (size_t k = mapa->inicio[r]; k < mapa->inicio[r + 1]; k++) {
+            chaves[k] = chaveOrdenada(mapa->coluna[k], mapa->linha[r]);
+            posicoes[k] = k;
+            ys[k] = mapa->linha[r];
+        }
+    }
+    ordenarPorChave(chaves, posicoes, n);
+    free(chaves);
+
+    size_t pos[257] = {0};
+    for (size_t k = 0; k < n; k++) pos[(unsigned char)mapa->carac[k] + 1]++;
+    for (int f = 0; f < 256; f++) pos[f + 1] += pos[f];
+    memcpy(conjunto->inicio, pos, sizeof(pos));
+
+    for (size_t i = 0; i < n; i++) {
+        size_t k = posicoes[i];
+        size_t destino = pos[(unsigned char)mapa->carac[k]]++;
+        conjunto->x[destino] = mapa->coluna[k];
+        conjunto->y[destino] = ys[k];
+        conjunto->frequencia[destino] = mapa->carac[k];
+        indiceInserir(conjunto->ocupadas, mapa->coluna[k], ys[k]);
+    }
+    conjunto->tamanho = n;
+    free(posicoes);
+    free(ys);
+    return conjunto;
+}
+
+void libertarEsparso(MapaEsparso* mapa) {
+    if (mapa == NULL) return;
+    free(mapa->linha);
+    free(mapa->inicio);
+    free(mapa->coluna);
+    free(mapa->carac);
+    free(mapa);
+}
+
+/**
+ * @brief Primeira linha não vazia r com linha[r] >= y
+ */
+static size_t primeiraLinha(const MapaEsparso* mapa, int y) {
+    size_t inf = 0, sup = mapa->numLinhas;
+    while (inf < sup) {
+        size_t meio = inf + (sup - inf) / 2;
+        if (mapa->linha[meio] < y) inf = meio + 1;
+        else sup = meio;
+    }
+    return inf;
+}
+
+/**
+ * @brief Primeira célula k em [inf, sup) com coluna[k] >= x
+ */
+static size_t primeiraColuna(const MapaEsparso* mapa, size_t inf, size_t sup, int x) {
+    while (inf < sup) {
+        size_t meio = inf + (sup - inf) / 2;
+        if (mapa->coluna[meio] < x) inf = meio + 1;
+        else sup = meio;
+    }
+    return inf;
+}
+
+size_t procurarEsparso(const MapaEsparso* mapa, int x, int y) {
+    size_t r = primeiraLinha(mapa, y);
+    if (r == mapa->numLinhas || mapa->linha[r] != y) return ESPARSO_NAO_ENCONTRADO;
+    size_t k = primeiraColuna(mapa, mapa->inicio[r], mapa->inicio[r + 1], x);
+    if (k == mapa->inicio[r + 1] || mapa->coluna[k] != x) return ESPARSO_NAO_ENCONTRADO;
+    return k;
+}
+
+size_t memoriaEsparso(const MapaEsparso* mapa) {
+    return sizeof(MapaEsparso) +
+           mapa->numLinhas * sizeof(int) + (mapa->numLinhas + 1) * sizeof(size_t) +
+           mapa->tamanho * (sizeof(int) + sizeof(char));
+}
+
+/**
+ * @brief Escreve numa linha de saída as células de uma linha do mapa dentro da janela
+ *
+ * @param[in,out] r Próxima linha não vazia a considerar (avança quando usada)
+ * @param[in] carac Carácter fixo (ex.: '#') ou '\0' para usar o da célula
+ */
+static void pintarLinha(const MapaEsparso* mapa, size_t* r, int y, int x0, int largura,
+                        char* linha, char carac) {
+    if (mapa == NULL || *r >= mapa->numLinhas || mapa->linha[*r] != y) return;
+    size_t fim = mapa->inicio[*r + 1];
+    long long limite = (long long)x0 + largura;
+    for (size_t k = primeiraColuna(mapa, mapa->inicio[*r], fim, x0);
+         k < fim && mapa->coluna[k] < limite; k++)
+        linha[mapa->coluna[k] - x0] = carac ? carac : mapa->carac[k];
+    (*r)++;
+}
+
+void imprimirJanelaEsparsa(FILE* saida, const MapaEsparso* antenas, const MapaEsparso* efeitos,
+                           int x0, int y0, int largura, int altura) {
+    if (largura <= 0 || altura <= 0 ||
+        (long long)x0 + largura - 1 > 0x7fffffffLL || (long long)y0 + altura - 1 > 0x7fffffffLL) {
+        fprintf(stderr, "Erro: Dimensões inválidas da janela\n");
+        return;
+    }
+    size_t ra = antenas != NULL ? primeiraLinha(antenas, y0) : 0;
+    size_t re = efeitos != NULL ? primeiraLinha(efeitos, y0) : 0;
+
+    // Efeitos primeiro, antenas por cima, uma escrita por linha
+    char* linha = (char*)realocar(NULL, (size_t)largura + 1, sizeof(char));
+    linha[largura] = '\n';
+    for (int d = 0; d < altura; d++) {
+        int y = y0 + d;
+        memset(linha, '.', (size_t)largura);
+        pintarLinha(efeitos, &re, y, x0, largura, linha, '#');
+        pintarLinha(antenas, &ra, y, x0, largura, linha, '\0');
+        fwrite(linha, 1, (size_t)largura + 1, saida);
+    }
+    free(linha);
+}
@@ -0,0 +1,119 @@
+/**
+ * @file estatisticas.c
+ * @brief Implementação dos contadores e do relatório de estatísticas
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <string.h>
+ #include <time.h>
+ #include "estatisticas.h"
+
+ #ifdef _WIN32
+ #include <windows.h>
+ #endif
+
+Estatisticas estatisticas;
+
+_Thread_local Estatisticas* estatisticasDaThread = NULL;
+
+/**
+ * @brief Relógio monotónico em segundos
+ */
+static double agora(void) {
+ #ifdef _WIN32
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart / (double)f.QuadPart;
+ #else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+ #endif
+}
+
+/**
+ * @brief Instante de início da fase em curso (< 0 se nenhuma)
+ */
+static double inicioFase = -1.0;
+
+void registarFase(const char* nome) {
+    double t = agora();
+    if (inicioFase >= 0.0 && estatisticas.numFases > 0)
+        estatisticas.segundosFase[estatisticas.numFases - 1] = t - inicioFase;
+    inicioFase = -1.0;
+    if (nome == NULL || estatisticas.numFases >= ESTAT_MAX_FASES) return;
+
+    estatisticas.nomeFase[estatisticas.numFases++] = nome;
+    inicioFase = agora();
+}
+
+void desviarEstatisticas(Estatisticas* destino) {
+    estatisticasDaThread = destino;
+}
+
+void juntarEstatisticas(const Estatisticas* parciais) {
+    estatisticas.paresPossiveis += parciais->paresPossiveis;
+    estatisticas.paresComparados += parciais->paresComparados;
+    estatisticas.paresAlinhados += parciais->paresAlinhados;
+    estatisticas.verificacoesColisao += parciais->verificacoesColisao;
+    estatisticas.efeitosEmitidos += parciais->efeitosEmitidos;
+    estatisticas.efeitosUnicos += parciais->efeitosUnicos;
+    estatisticas.nosPercorridos += parciais->nosPercorridos;
+    estatisticas.antenasCriadas += parciais->antenasCriadas;
+}
+
+void reiniciarEstatisticas(void) {
+    memset(&estatisticas, 0, sizeof(estatisticas));
+    inicioFase = -1.0;
+}
+
+void imprimirEstatisticas(FILE* saida, int json) {
+    const char* nomes[] = {
+        "pares_possiveis", "pares_comparados", "pares_alinhados", "verificacoes_colisao",
+        "efeitos_emitidos", "efeitos_unicos", "nos_percorridos", "antenas_criadas"
+    };
+    const unsigned long long valores[] = {
+        estatisticas.paresPossiveis, estatisticas.paresComparados, estatisticas.paresAlinhados,
+        estatisticas.verificacoesColisao, estatisticas.efeitosEmitidos, estatisticas.efeitosUnicos,
+        estatisticas.nosPercorridos, estatisticas.antenasCriadas
+    };
+    const int numContadores = (int)(sizeof(valores) / sizeof(valores[0]));
+
+    if (!ESTAT_ATIVAS) {
+        if (json) fputs("{\"ativas\":false}\n", saida);
+        else fputs("Estatísticas desativadas nesta compilação (EDA_SEM_ESTATISTICAS)\n", saida);
+        return;
+    }
+
+    if (json) {
+        fputs("{\"ativas\":true,\"contadores\":{", saida);
+        for (int i = 0; i < numContadores; i++)
+            fprintf(saida, "%s\"%s\":%llu", i ? "," : "", nomes[i], valores[i]);
+        fputs("},\"fases\":[", saida);
+        for (int i = 0; i < estatisticas.numFases; i++)
+            fprintf(saida, "%s{\"nome\":\"%s\",\"segundos\":%.9f}", i ? "," : "",
+                    estatisticas.nomeFase[i], estatisticas.segundosFase[i]);
+        fputs("]}\n", saida);
+        return;
+    }
+
+    fputs("\nEstatísticas:\n", saida);
+    for (int i = 0; i < numContadores; i++)
+        fprintf(saida, "  %-22s %20llu\n", nomes[i], valores[i]);
+    if (estatisticas.numFases > 0) {
+        fputs("\nTempo por fase:\n", saida);
+        for (int i = 0; i < estatisticas.numFases; i++)
+            fprintf(saida, "  %-40s %12.3f ms\n", estatisticas.nomeFase[i],
+                    estatisticas.segundosFase[i] * 1e3);
+    }
+}
@@ -0,0 +1,507 @@
+/**
+ * @file faixas.c
+ * @brief Implementação do cálculo de efeitos fora de memória
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdint.h>
+ #include "faixas.h"
+ #include "memoria.h"
+ #include "funcoes.h"
+ #include "indice.h"
+ #include "kernel.h"
+
+ #ifdef _WIN32
+ #define posicionar(f, pos) _fseeki64((f), (long long)(pos), SEEK_SET)
+ #else
+ #define posicionar(f, pos) fseeko((f), (off_t)(pos), SEEK_SET)
+ #endif
+
+/**
+ * @brief Coordenada guardada nos ficheiros temporários
+ */
+typedef struct {
+    int x; ///< Coluna
+    int y; ///< Linha
+} PontoFaixa;
+
+/**
+ * @brief Par alinhado: os dois pontos de efeito (x = -1 se fora do mapa)
+ */
+typedef struct {
+    int x1, y1; ///< Ponto a1 - d
+    int x2, y2; ///< Ponto a2 + d
+} ParFaixa;
+
+/**
+ * @brief Antenas de uma frequência: prefixo em disco, sufixo em memória
+ */
+typedef struct {
+    FILE* disco;          ///< Ficheiro temporário (NULL até ao primeiro despejo)
+    size_t emDisco;       ///< Antenas já escritas no ficheiro
+    PontoFaixa* memoria;  ///< Antenas ainda em memória
+    size_t emMemoria;     ///< Número de antenas em memória
+    size_t capacidade;    ///< Capacidade de memoria
+} GrupoFaixa;
+
+/**
+ * @brief Ficheiros temporários indexados por faixa de colunas
+ */
+typedef struct {
+    FILE* ficheiros[FAIXAS_MAXIMO]; ///< Um ficheiro por faixa (NULL se vazio)
+    size_t tamanhos[FAIXAS_MAXIMO]; ///< Registos escritos em cada faixa
+} Baldes;
+
+/**
+ * @brief Estado partilhado pelas várias fases
+ */
+typedef struct {
+    int linhas;               ///< Número de linhas do mapa
+    int colunas;              ///< Número de colunas do mapa
+    size_t memoria;           ///< Orçamento de memória em bytes
+    GrupoFaixa grupos[256];   ///< Resumo por frequência
+    size_t emMemoria;         ///< Antenas do resumo ainda em memória
+    size_t antenas;           ///< Total de antenas
+    int faixas;               ///< Número de faixas
+    int largura;              ///< Colunas por faixa
+    Baldes ocupadas;          ///< Antenas de cada faixa
+    Baldes primeiros;         ///< Pares por confirmar no primeiro ponto
+    Baldes segundos;          ///< Pares por confirmar no segundo ponto
+    Baldes efeitos;           ///< Pontos de efeito dos pares válidos
+} ProcessoFaixas;
+
+/**
+ * @brief Cria um ficheiro temporário ou termina o programa
+ */
+static FILE* abrirTemporario(void) {
+    FILE* f = tmpfile();
+    if (f == NULL) {
+        fprintf(stderr, "Erro: Não foi possível criar um ficheiro temporário\n");
+        exit(EXIT_FAILURE);
+    }
+    return f;
+}
+
+/**
+ * @brief Escreve n registos num ficheiro temporário ou termina o programa
+ */
+static void escrever(const void* dados, size_t tamanho, size_t n, FILE* f) {
+    if (n > 0 && fwrite(dados, tamanho, n, f) != n) {
+        fprintf(stderr, "Erro de escrita num ficheiro temporário\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Lê n registos de um ficheiro temporário ou termina o programa
+ */
+static void ler(void* dados, size_t tamanho, size_t n, FILE* f) {
+    if (n > 0 && fread(dados, tamanho, n, f) != n) {
+        fprintf(stderr, "Erro de leitura num ficheiro temporário\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Acrescenta um registo ao balde de uma faixa
+ */
+static void acrescentarBalde(Baldes* b, int faixa, const void* registo, size_t tamanho) {
+    if (b->ficheiros[faixa] == NULL) b->ficheiros[faixa] = abrirTemporario();
+    escrever(registo, tamanho, 1, b->ficheiros[faixa]);
+    b->tamanhos[faixa]++;
+}
+
+/**
+ * @brief Fecha (e apaga) o ficheiro de uma faixa
+ */
+static void fecharBalde(Baldes* b, int faixa) {
+    if (b->ficheiros[faixa] != NULL) fclose(b->ficheiros[faixa]);
+    b->ficheiros[faixa] = NULL;
+    b->tamanhos[faixa] = 0;
+}
+
+/**
+ * @brief Faixa a que pertence uma coluna
+ */
+static int faixaDe(const ProcessoFaixas* p, int x) {
+    return x / p->largura;
+}
+
+/**
+ * @brief Escreve em disco as antenas do resumo que estão em memória
+ */
+static void despejarResumo(ProcessoFaixas* p) {
+    for (int f = 0; f < 256; f++) {
+        GrupoFaixa* g = &p->grupos[f];
+        if (g->emMemoria == 0) continue;
+        if (g->disco == NULL) g->disco = abrirTemporario();
+        escrever(g->memoria, sizeof(PontoFaixa), g->emMemoria, g->disco);
+        g->emDisco += g->emMemoria;
+        free(g->memoria);
+        g->memoria = NULL;
+        g->emMemoria = g->capacidade = 0;
+    }
+    p->emMemoria = 0;
+}
+
+/**
+ * @brief Regista uma antena no resumo da sua frequência
+ */
+static void registarAntena(ProcessoFaixas* p, char frequencia, int x, int y) {
+    GrupoFaixa* g = &p->grupos[(unsigned char)frequencia];
+    if (g->emMemoria == g->capacidade) {
+        g->capacidade = g->capacidade ? g->capacidade * 2 : 256;
+        g->memoria = (PontoFaixa*)realocar(g->memoria, g->capacidade, sizeof(PontoFaixa));
+    }
+    g->memoria[g->emMemoria].x = x;
+    g->memoria[g->emMemoria].y = y;
+    g->emMemoria++;
+    p->antenas++;
+    if (++p->emMemoria * sizeof(PontoFaixa) * 2 > p->memoria / 2) despejarResumo(p);
+}
+
+/**
+ * @brief Indica se o carácter é um separador (mesmo critério que "%s" no fscanf)
+ */
+static int separador(int c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Lê o mapa em blocos e constrói o resumo por frequência
+ *
+ * @details Cada sequência de caracteres não separadores é uma linha do
+ * mapa, como em carregarAntenasDoMapa; o estado da linha atual passa de um
+ * bloco para o seguinte, pelo que as linhas podem ter qualquer largura.
+ */
+static int lerResumo(ProcessoFaixas* p, const char* filename) {
+    FILE* f = fopen(filename, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "Erro: Não foi possível abrir o ficheiro %s\n", filename);
+        return 0;
+    }
+    if (fscanf(f, "%d %d", &p->linhas, &p->colunas) != 2 || p->linhas < 0 || p->colunas < 0) {
+        fprintf(stderr, "Erro: Formato inválido no ficheiro %s\n", filename);
+        fclose(f);
+        return 0;
+    }
+
+    char* bloco = (char*)realocar(NULL, FAIXAS_BLOCO_LEITURA, 1);
+    int y = 0, x = 0, naLinha = 0;
+    size_t lidos;
+    while (y < p->linhas && (lidos = fread(bloco, 1, FAIXAS_BLOCO_LEITURA, f)) > 0) {
+        for (size_t i = 0; i < lidos && y < p->linhas; i++) {
+            char c = bloco[i];
+            if (separador((unsigned char)c)) {
+                if (naLinha) { naLinha = 0; y++; }
+                continue;
+            }
+            if (!naLinha) { naLinha = 1; x = 0; }
+            if (c != '.' && x < p->colunas) registarAntena(p, c, x, y);
+            if (x < p->colunas) x++;
+        }
+    }
+    free(bloco);
+    fclose(f);
+    return 1;
+}
+
+/**
+ * @brief Lê as antenas [inicio, inicio + n) de um grupo para xs/ys
+ */
+static void lerGrupo(GrupoFaixa* g, size_t inicio, size_t n, int* xs, int* ys, PontoFaixa* tampao) {
+    size_t k = 0;
+    if (inicio < g->emDisco) {
+        size_t doDisco = g->emDisco - inicio < n ? g->emDisco - inicio : n;
+        posicionar(g->disco, inicio * sizeof(PontoFaixa));
+        ler(tampao, sizeof(PontoFaixa), doDisco, g->disco);
+        for (; k < doDisco; k++) { xs[k] = tampao[k].x; ys[k] = tampao[k].y; }
+    }
+    for (; k < n; k++) {
+        const PontoFaixa* q = &g->memoria[inicio + k - g->emDisco];
+        xs[k] = q->x;
+        ys[k] = q->y;
+    }
+}
+
+/**
+ * @brief Distribui as antenas de todos os grupos pelas faixas de colunas
+ */
+static void distribuirAntenas(ProcessoFaixas* p, size_t bloco, int* xs, int* ys, PontoFaixa* tampao) {
+    for (int f = 0; f < 256; f++) {
+        GrupoFaixa* g = &p->grupos[f];
+        size_t total = g->emDisco + g->emMemoria;
+        for (size_t inicio = 0; inicio < total; inicio += bloco) {
+            size_t n = total - inicio < bloco ? total - inicio : bloco;
+            lerGrupo(g, inicio, n, xs, ys, tampao);
+            for (size_t k = 0; k < n; k++) {
+                PontoFaixa q = {xs[k], ys[k]};
+                acrescentarBalde(&p->ocupadas, faixaDe(p, q.x), &q, sizeof(q));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Encaminha um par alinhado para a faixa do seu primeiro ponto no mapa
+ */
+static void encaminharPar(ProcessoFaixas* p, int x0, int y0, int x, int y, uint8_t marcas) {
+    // Os pontos marcados estão dentro do mapa, pelo que cabem num int
+    ParFaixa par;
+    par.x1 = (marcas & KERNEL_PONTO1) ? (int)(2LL * x0 - x) : -1;
+    par.y1 = (marcas & KERNEL_PONTO1) ? (int)(2LL * y0 - y) : -1;
+    par.x2 = (marcas & KERNEL_PONTO2) ? (int)(2LL * x - x0) : -1;
+    par.y2 = (marcas & KERNEL_PONTO2) ? (int)(2LL * y - y0) : -1;
+    if (par.x1 >= 0) acrescentarBalde(&p->primeiros, faixaDe(p, par.x1), &par, sizeof(par));
+    else acrescentarBalde(&p->segundos, faixaDe(p, par.x2), &par, sizeof(par));
+}
+
+/**
+ * @brief Avalia a antena (x0,y0) contra n parceiros, bloco a bloco
+ */
+static void avaliarParceiros(ProcessoFaixas* p, KernelAlinhamento kernel, int x0, int y0,
+                             const int* xs, const int* ys, size_t n) {
+    uint32_t alinhados[KERNEL_BLOCO];
+    uint8_t marcas[KERNEL_BLOCO];
+    for (size_t j0 = 0; j0 < n; j0 += KERNEL_BLOCO) {
+        size_t m = n - j0 < KERNEL_BLOCO ? n - j0 : KERNEL_BLOCO;
+        size_t h = kernel(xs + j0, ys + j0, m, x0, y0, p->colunas, p->linhas, alinhados, marcas);
+        for (size_t k = 0; k < h; k++) {
+            if (!(marcas[k] & (KERNEL_PONTO1 | KERNEL_PONTO2))) continue;
+            size_t j = j0 + alinhados[k];
+            encaminharPar(p, x0, y0, xs[j], ys[j], marcas[k]);
+        }
+    }
+}
+
+/**
+ * @brief Gera os pares alinhados de cada grupo em blocos de tamanho fixo
+ *
+ * @details Para cada bloco A do grupo avaliam-se os pares internos de A e,
+ * depois, os pares com cada bloco B seguinte: com dois blocos em memória,
+ * o grupo é relido O(k / bloco) vezes.
+ */
+static void gerarPares(ProcessoFaixas* p, size_t bloco, int* xs, int* ys, PontoFaixa* tampao) {
+    int maior = p->linhas > p->colunas ? p->linhas : p->colunas;
+    KernelAlinhamento kernel = maior < KERNEL_COORD_MAXIMA ? escolherKernel() : kernelEscalar;
+    int* xb = xs + bloco;
+    int* yb = ys + bloco;
+
+    for (int f = 0; f < 256; f++) {
+        GrupoFaixa* g = &p->grupos[f];
+        size_t total = g->emDisco + g->emMemoria;
+        for (size_t a0 = 0; a0 < total; a0 += bloco) {
+            size_t na = total - a0 < bloco ? total - a0 : bloco;
+            lerGrupo(g, a0, na, xs, ys, tampao);
+            for (size_t i = 0; i + 1 < na; i++)
+                avaliarParceiros(p, kernel, xs[i], ys[i], xs + i + 1, ys + i + 1, na - i - 1);
+
+            for (size_t b0 = a0 + na; b0 < total; b0 += bloco) {
+                size_t nb = total - b0 < bloco ? total - b0 : bloco;
+                lerGrupo(g, b0, nb, xb, yb, tampao);
+                for (size_t i = 0; i < na; i++)
+                    avaliarParceiros(p, kernel, xs[i], ys[i], xb, yb, nb);
+            }
+        }
+        if (g->disco != NULL) fclose(g->disco);
+        free(g->memoria);
+        g->disco = NULL;
+        g->memoria = NULL;
+    }
+}
+
+/**
+ * @brief Carrega as antenas de uma faixa num índice de hash
+ */
+static IndiceCoord* indexarFaixa(ProcessoFaixas* p, int faixa) {
+    size_t n = p->ocupadas.tamanhos[faixa];
+    IndiceCoord* indice = criarIndiceCoord(0, 0, n);
+    FILE* f = p->ocupadas.ficheiros[faixa];
+    if (f == NULL) return indice;
+
+    PontoFaixa q;
+    rewind(f);
+    for (size_t k = 0; k < n; k++) {
+        ler(&q, sizeof(q), 1, f);
+        indiceInserir(indice, q.x, q.y);
+    }
+    return indice;
+}
+
+/**
+ * @brief Acrescenta um ponto de efeito ao balde da sua faixa
+ */
+static void emitirEfeito(ProcessoFaixas* p, int x, int y) {
+    PontoFaixa q = {x, y};
+    acrescentarBalde(&p->efeitos, faixaDe(p, x), &q, sizeof(q));
+}
+
+/**
+ * @brief Confirma os pares de uma faixa contra as antenas dessa faixa
+ *
+ * @param[in] segundo 0 para confirmar o primeiro ponto, 1 para o segundo
+ *
+ * @details Um par que passa no primeiro ponto segue para a faixa do
+ * segundo; um par que passa em ambos (ou cujo outro ponto está fora do
+ * mapa) emite os seus pontos de efeito.
+ */
+static void confirmarFaixa(ProcessoFaixas* p, int faixa, int segundo) {
+    Baldes* origem = segundo ? &p->segundos : &p->primeiros;
+    FILE* f = origem->ficheiros[faixa];
+    if (f == NULL) return;
+
+    IndiceCoord* indice = indexarFaixa(p, faixa);
+    ParFaixa par;
+    rewind(f);
+    for (size_t k = origem->tamanhos[faixa]; k > 0; k--) {
+        ler(&par, sizeof(par), 1, f);
+        if (!segundo) {
+            if (existeNoIndice(indice, par.x1, par.y1)) continue;
+            if (par.x2 >= 0) acrescentarBalde(&p->segundos, faixaDe(p, par.x2), &par, sizeof(par));
+            else emitirEfeito(p, par.x1, par.y1);
+        } else {
+            if (existeNoIndice(indice, par.x2, par.y2)) continue;
+            if (par.x1 >= 0) emitirEfeito(p, par.x1, par.y1);
+            emitirEfeito(p, par.x2, par.y2);
+        }
+    }
+    libertarIndiceCoord(indice);
+    fecharBalde(origem, faixa);
+}
+
+/**
+ * @brief Escreve os efeitos distintos de um ficheiro com colunas em [x0, x1)
+ *
+ * @details Se os pontos cabem no orçamento (ou o intervalo é uma só
+ * coluna) são ordenados; senão, se o bitmap das colunas cabe, é usado o
+ * bitmap; senão o intervalo é dividido ao meio e cada metade é tratada
+ * separadamente.
+ *
+ * @return long long Número de efeitos escritos
+ */
+static long long escreverEfeitos(const ProcessoFaixas* p, FILE* f, size_t n, int x0, int x1,
+                                 FILE* saida) {
+    long long escritos = 0;
+    uint64_t linhas = (uint64_t)p->linhas;
+    rewind(f);
+
+    if (n * sizeof(uint64_t) <= p->memoria || x1 - x0 <= 1) {
+        uint64_t* chaves = (uint64_t*)realocar(NULL, n, sizeof(uint64_t));
+        PontoFaixa q;
+        for (size_t k = 0; k < n; k++) {
+            ler(&q, sizeof(q), 1, f);
+            chaves[k] = chaveOrdenada(q.x, q.y);
+        }
+        if (n > 1) qsort(chaves, n, sizeof(uint64_t), compararChaves);
+        for (size_t k = 0; k < n; k++) {
+            if (k > 0 && chaves[k] == chaves[k - 1]) continue;
+            fprintf(saida, "%d %d\n", xDaChave(chaves[k]), yDaChave(chaves[k]));
+            escritos++;
+        }
+        free(chaves);
+    } else if (((uint64_t)(x1 - x0) * linhas + 7) / 8 <= p->memoria) {
+        // Bitmap por colunas: o percurso sai já ordenado por (x,y)
+        uint8_t* bits = (uint8_t*)alocarZeros(((size_t)(x1 - x0) * linhas + 7) / 8, 1);
+        PontoFaixa q;
+        for (size_t k = 0; k < n; k++) {
+            ler(&q, sizeof(q), 1, f);
+            uint64_t b = (uint64_t)(q.x - x0) * linhas + (uint64_t)q.y;
+            bits[b >> 3] |= (uint8_t)(1u << (b & 7));
+        }
+        for (uint64_t b = 0; b < (uint64_t)(x1 - x0) * linhas; b++) {
+            if (!(bits[b >> 3] & (1u << (b & 7)))) continue;
+            fprintf(saida, "%d %d\n", x0 + (int)(b / linhas), (int)(b % linhas));
+            escritos++;
+        }
+        free(bits);
+    } else {
+        int meio = x0 + (x1 - x0) / 2;
+        FILE* metades[2] = {abrirTemporario(), abrirTemporario()};
+        size_t tamanhos[2] = {0, 0};
+        PontoFaixa q;
+        for (size_t k = 0; k < n; k++) {
+            ler(&q, sizeof(q), 1, f);
+            int lado = q.x >= meio;
+            escrever(&q, sizeof(q), 1, metades[lado]);
+            tamanhos[lado]++;
+        }
+        escritos += escreverEfeitos(p, metades[0], tamanhos[0], x0, meio, saida);
+        fclose(metades[0]);
+        escritos += escreverEfeitos(p, metades[1], tamanhos[1], meio, x1, saida);
+        fclose(metades[1]);
+    }
+    return escritos;
+}
+
+long long calcularEfeitosPorFaixas(const char* filename, FILE* saida, size_t memoria) {
+    ProcessoFaixas* p = (ProcessoFaixas*)alocarZeros(1, sizeof(ProcessoFaixas));
+    p->memoria = memoria ? memoria : FAIXAS_MEMORIA_OMISSAO;
+
+    // 1. Resumo por frequência, lido em blocos
+    if (!lerResumo(p, filename)) {
+        for (int f = 0; f < 256; f++) {
+            if (p->grupos[f].disco != NULL) fclose(p->grupos[f].disco);
+            free(p->grupos[f].memoria);
+        }
+        free(p);
+        return -1;
+    }
+
+    // Faixas suficientes para o índice de antenas de cada uma caber em metade do orçamento
+    size_t faixas = (p->antenas * 32) / (p->memoria / 2) + 1;
+    if (faixas > FAIXAS_MAXIMO) faixas = FAIXAS_MAXIMO;
+
+    // Ficheiros abertos: os grupos despejados mais três por faixa na geração
+    // dos pares e quatro por faixa na confirmação
+    size_t despejados = 0;
+    for (int f = 0; f < 256; f++)
+        if (p->grupos[f].disco != NULL) despejados++;
+    size_t livres = FAIXAS_FICHEIROS_MAXIMO - FAIXAS_FICHEIROS_RESERVA - despejados;
+    if (faixas > livres / 4) faixas = livres / 4;
+    if (p->colunas > 0 && faixas > (size_t)p->colunas) faixas = (size_t)p->colunas;
+    p->faixas = (int)faixas;
+    p->largura = p->colunas > 0 ? (int)(((size_t)p->colunas + faixas - 1) / faixas) : 1;
+
+    // Dois blocos de antenas (x,y) e um tampão de leitura em metade do orçamento
+    size_t bloco = p->memoria / (2 * 3 * sizeof(PontoFaixa));
+    if (bloco < KERNEL_BLOCO) bloco = KERNEL_BLOCO;
+    int* xs = (int*)realocar(NULL, 2 * bloco, sizeof(int));
+    int* ys = (int*)realocar(NULL, 2 * bloco, sizeof(int));
+    PontoFaixa* tampao = (PontoFaixa*)realocar(NULL, bloco, sizeof(PontoFaixa));
+
+    // 2. Antenas por faixa e pares alinhados por faixa do primeiro ponto
+    distribuirAntenas(p, bloco, xs, ys, tampao);
+    gerarPares(p, bloco, xs, ys, tampao);
+    free(xs);
+    free(ys);
+    free(tampao);
+
+    // 3. Confirmação dos dois pontos de cada par, faixa a faixa
+    for (int b = 0; b < p->faixas; b++) confirmarFaixa(p, b, 0);
+    for (int b = 0; b < p->faixas; b++) confirmarFaixa(p, b, 1);
+
+    // 4. Efeitos ordenados e deduplicados, faixa a faixa
+    long long total = 0;
+    for (int b = 0; b < p->faixas; b++) {
+        if (p->efeitos.ficheiros[b] != NULL) {
+            int x0 = b * p->largura;
+            int x1 = x0 + p->largura < p->colunas ? x0 + p->largura : p->colunas;
+            total += escreverEfeitos(p, p->efeitos.ficheiros[b], p->efeitos.tamanhos[b],
+                                     x0, x1, saida);
+        }
+        fecharBalde(&p->efeitos, b);
+        fecharBalde(&p->ocupadas, b);
+    }
+    free(p);
+    return total;
+}
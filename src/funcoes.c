@@ -19,7 +19,12 @@
 
  #include <stdio.h>
  #include <stdlib.h>
+ #include <limits.h>
  #include "funcoes.h"
+ #include "memoria.h"
+ #include "indice.h"
+ #include "arena.h"
+ #include "estatisticas.h"
  #include <math.h>
  
 /**
@@ -34,15 +39,12 @@
  * @note Complexidade: O(1)
  */
 Antena* criarAntena(char frequencia, int x, int y) {
-    Antena* nova = (Antena*)malloc(sizeof(Antena));
-    if(nova == NULL) {
-        fprintf(stderr, "Erro de alocação de memória\n");
-        exit(EXIT_FAILURE);
-    }
+    Antena* nova = (Antena*)realocar(NULL, 1, sizeof(Antena));
     nova->frequencia = frequencia;
     nova->x = x;
     nova->y = y;
     nova->prox = NULL;
+    ESTAT_SOMAR(antenasCriadas, 1);
     return nova;
 }
  
@@ -60,14 +62,30 @@ Antena* criarAntena(char frequencia, int x, int y) {
  */
 Antena* inserirAntena(Antena* head, char frequencia, int x, int y) {
     // Verificação de duplicados
-    for (Antena* temp = head; temp != NULL; temp = temp->prox) {
+    size_t percorridos = 0;
+    for (Antena* temp = head; temp != NULL; temp = temp->prox, percorridos++) {
         if (temp->x == x && temp->y == y) {
+            ESTAT_SOMAR(nosPercorridos, percorridos + 1);
             return head;
         }
     }
+    ESTAT_SOMAR(nosPercorridos, percorridos);
     
-    Antena* nova = criarAntena(frequencia, x, y);
-    
+    return ligarOrdenado(head, criarAntena(frequencia, x, y));
+}
+
+/**
+ * @brief Implementação da ligação ordenada de um nó já criado
+ * 
+ * @param[in] head Cabeça da lista
+ * @param[in] nova Nó a ligar
+ * @return Antena* Nova cabeça da lista
+ * 
+ * @note Complexidade: O(n) para encontrar a posição
+ */
+Antena* ligarOrdenado(Antena* head, Antena* nova) {
+    int x = nova->x, y = nova->y;
+
     // Caso especial: lista vazia ou inserção no início
     if (head == NULL || (x < head->x) || (x == head->x && y < head->y)) {
         nova->prox = head;
@@ -76,11 +94,14 @@ Antena* inserirAntena(Antena* head, char frequencia, int x, int y) {
     
     // Procura a posição correta para inserção
     Antena* atual = head;
+    size_t percorridos = 1;
     while (atual->prox != NULL && 
            ((atual->prox->x < x) || 
             (atual->prox->x == x && atual->prox->y < y))) {
         atual = atual->prox;
+        percorridos++;
     }
+    ESTAT_SOMAR(nosPercorridos, percorridos);
     
     // Insere o novo nó na posição encontrada
     nova->prox = atual->prox;
@@ -119,6 +140,15 @@ Antena* inserirAntena(Antena* head, char frequencia, int x, int y) {
     }
  }
  
+/**
+ * @brief Callback que reproduz o relatório de remoção no terminal
+ */
+static void relatarNoTerminal(const Antena* removida, void* contexto) {
+    (void)contexto;
+    printf("[REMOVIDO] Antena %c em (%d,%d) em localizacao de efeito nefasto\n", 
+           removida->frequencia, removida->x, removida->y);
+}
+
 /**
  * @brief Remove antenas em zonas de efeito nefasto
  * 
@@ -127,6 +157,7 @@ Antena* inserirAntena(Antena* head, char frequencia, int x, int y) {
  * @return Antena* Lista filtrada
  * 
  * @note Mantém os nós de efeito na lista original
+ * @note Indexa os efeitos e delega em filtrarAntenasEmEfeitos
  */
  Antena* removerAntenasEmEfeitos(Antena* lista, Antena* efeitos) {
 
@@ -136,21 +167,66 @@ Antena* inserirAntena(Antena* head, char frequencia, int x, int y) {
         return lista;
     }
 
-    Antena* ant = lista;
-    while (ant != NULL) {
-        if (ant->frequencia != '#' && existeNaLista(efeitos, ant->x, ant->y)) {
-            printf("[REMOVIDO] Antena %c em (%d,%d) em localizacao de efeito nefasto\n", 
-                   ant->frequencia, ant->x, ant->y);
-            Antena* proximo = ant->prox;
-            lista = removerAntena(lista, ant->x, ant->y);
-            ant = proximo;
+    IndiceCoord* zonas = indexarLista(efeitos, 0, 0);
+    lista = filtrarAntenasEmEfeitos(lista, zonas, relatarNoTerminal, NULL);
+    libertarIndiceCoord(zonas);
+    return lista;
+}
+
+/**
+ * @brief Implementação da remoção numa só passagem contra um índice de efeitos
+ * 
+ * @param[in] lista Lista de antenas
+ * @param[in] efeitos Índice das zonas de efeito
+ * @param[in] relatar Callback chamado para cada antena removida (pode ser NULL)
+ * @param[in] contexto Apontador entregue ao callback
+ * @return Antena* Lista filtrada
+ * 
+ * @note Os nós são desligados no próprio percurso, sem voltar à cabeça da lista
+ * @note Complexidade: O(n)
+ */
+Antena* filtrarAntenasEmEfeitos(Antena* lista, const struct IndiceCoord* efeitos,
+                                CallbackRemocao relatar, void* contexto) {
+    Antena** ligacao = &lista;
+    while (*ligacao != NULL) {
+        Antena* ant = *ligacao;
+        if (ant->frequencia != '#' && existeNoIndice(efeitos, ant->x, ant->y)) {
+            if (relatar != NULL) relatar(ant, contexto);
+            *ligacao = ant->prox;
+            free(ant);
         } else {
-            ant = ant->prox;
+            ligacao = &ant->prox;
         }
     }
     return lista;
 }
 
+/**
+ * @brief Implementação do callback que acumula o relatório num buffer
+ * 
+ * @param[in] removida Antena removida
+ * @param[in] contexto Apontador para um BufferRemocoes
+ */
+void relatarNoBuffer(const Antena* removida, void* contexto) {
+    BufferRemocoes* buffer = (BufferRemocoes*)contexto;
+    buffer->removidas++;
+    if (buffer->dados == NULL || buffer->usado + 1 >= buffer->capacidade) {
+        buffer->truncado = 1;
+        return;
+    }
+
+    int escritos = snprintf(buffer->dados + buffer->usado, buffer->capacidade - buffer->usado,
+                            "[REMOVIDO] Antena %c em (%d,%d) em localizacao de efeito nefasto\n",
+                            removida->frequencia, removida->x, removida->y);
+    if (escritos < 0) return;
+    if ((size_t)escritos >= buffer->capacidade - buffer->usado) {
+        buffer->usado = buffer->capacidade - 1;
+        buffer->truncado = 1;
+    } else {
+        buffer->usado += (size_t)escritos;
+    }
+}
+
  /**
   * @brief Imprime todas as antenas da lista no terminal
   * 
@@ -181,83 +257,256 @@ Antena* inserirAntena(Antena* head, char frequencia, int x, int y) {
  * 
  */
  int existeNaLista(Antena* lista, int x, int y) {
-     for (Antena* temp = lista; temp != NULL; temp = temp->prox) {
-         if (temp->x == x && temp->y == y)
+     size_t percorridos = 0;
+     for (Antena* temp = lista; temp != NULL; temp = temp->prox, percorridos++) {
+         if (temp->x == x && temp->y == y) {
+             ESTAT_SOMAR(nosPercorridos, percorridos + 1);
              return 1;
+         }
      }
+     ESTAT_SOMAR(nosPercorridos, percorridos);
      return 0;
  }
  
+/**
+ * @brief Liberta todos os nós de uma lista criada com criarAntena
+ * 
+ * @param[in] head Cabeça da lista (pode ser NULL)
+ * 
+ * @note Complexidade: O(n)
+ */
+void libertarLista(Antena* head) {
+    while (head != NULL) {
+        Antena* seguinte = head->prox;
+        free(head);
+        head = seguinte;
+    }
+}
+
+/**
+ * @brief Ponto auxiliar usado para acumular efeitos antes de criar a lista
+ */
+typedef struct {
+    int x; ///< Coordenada horizontal (0-based)
+    int y; ///< Coordenada vertical (0-based)
+} Ponto;
+
+/**
+ * @brief Vetor dinâmico de pontos de efeito
+ */
+typedef struct {
+    Ponto* dados;     ///< Pontos acumulados
+    size_t tamanho;   ///< Número de pontos em uso
+    size_t capacidade;///< Capacidade alocada
+} VetorPontos;
+
+/**
+ * @brief Acrescenta um ponto ao vetor, crescendo-o geometricamente
+ *
+ * @param[in,out] v Vetor de pontos
+ * @param[in] x Coordenada X (0-based)
+ * @param[in] y Coordenada Y (0-based)
+ */
+static void acrescentarPonto(VetorPontos* v, int x, int y) {
+    if (v->tamanho == v->capacidade) {
+        size_t nova = v->capacidade ? v->capacidade * 2 : 64;
+        v->dados = (Ponto*)realocar(v->dados, nova, sizeof(Ponto));
+        v->capacidade = nova;
+    }
+    v->dados[v->tamanho].x = x;
+    v->dados[v->tamanho].y = y;
+    v->tamanho++;
+}
+
+/**
+ * @brief Ordenação de pontos por (x,y) crescente, compatível com qsort
+ */
+static int compararPontos(const void* a, const void* b) {
+    const Ponto* p = (const Ponto*)a;
+    const Ponto* q = (const Ponto*)b;
+    if (p->x != q->x) return (p->x > q->x) - (p->x < q->x);
+    return (p->y > q->y) - (p->y < q->y);
+}
+
+/**
+ * @brief Implementação do teste de alinhamento entre duas antenas
+ *
+ * @param[in] dx Diferença horizontal entre as antenas
+ * @param[in] dy Diferença vertical entre as antenas
+ * @return int 1 se alinhadas, 0 caso contrário
+ *
+ * @note Horizontal, vertical, diagonal e declives 1:2, 2:1, 1:3 e 3:1
+ */
+int antenasAlinhadas(long long dx, long long dy) {
+    long long adx = llabs(dx), ady = llabs(dy);
+    return dx == 0 || dy == 0 || adx == ady ||
+           adx == 2*ady || 2*adx == ady ||
+           adx == 3*ady || 3*adx == ady;
+}
+
+/**
+ * @brief Implementação do teste de representabilidade de um ponto
+ * 
+ * @param[in] x Coordenada horizontal
+ * @param[in] y Coordenada vertical
+ * @return int 1 se x e y cabem num int
+ */
+int coordenadaRepresentavel(long long x, long long y) {
+    return x >= INT_MIN && x <= INT_MAX && y >= INT_MIN && y <= INT_MAX;
+}
+
+/**
+ * @brief Implementação do teste de pertença ao mapa
+ * 
+ * @param[in] mapa Dimensões do mapa (NULL para mapa ilimitado)
+ * @param[in] x Coordenada horizontal
+ * @param[in] y Coordenada vertical
+ * @return int 1 se o ponto pertence ao mapa
+ */
+int pontoNoMapa(const Mapa* mapa, long long x, long long y) {
+    if (x < 0 || y < 0 || !coordenadaRepresentavel(x, y)) return 0;
+    if (mapa == NULL) return 1;
+    return (mapa->colunas <= 0 || x < mapa->colunas) &&
+           (mapa->linhas <= 0 || y < mapa->linhas);
+}
+
+/**
+ * @brief Motor de cálculo de efeitos agrupado por frequência
+ * 
+ * @param[in] lista Lista de antenas
+ * @param[in] mapa Dimensões do mapa (NULL para mapa ilimitado)
+ * @param[in] arena Arena de onde retirar os nós '#' (NULL para usar malloc)
+ * @return Antena* Lista de efeitos nefastos ordenada por (x,y)
+ * 
+ * @note As projeções são calculadas em 64 bits: com coordenadas até 2^31
+ *       o ponto a2 + (a2 - a1) pode sair do intervalo de int. Um ponto não
+ *       representável não pode estar ocupado nem pertencer ao mapa.
+ */
+static Antena* motorEfeitos(Antena* lista, const Mapa* mapa, ArenaAntenas* arena) {
+    size_t n = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox) n++;
+    if (n == 0) return NULL;
+
+    // Agrupamento por frequência (estável, mantém a ordem (x,y) da lista)
+    size_t inicio[257] = {0};
+    for (Antena* a = lista; a != NULL; a = a->prox)
+        inicio[(unsigned char)a->frequencia + 1]++;
+    for (int f = 0; f < 256; f++)
+        inicio[f + 1] += inicio[f];
+
+    Antena** grupos = (Antena**)realocar(NULL, n, sizeof(Antena*));
+    size_t pos[256];
+    for (int f = 0; f < 256; f++) pos[f] = inicio[f];
+    for (Antena* a = lista; a != NULL; a = a->prox)
+        grupos[pos[(unsigned char)a->frequencia]++] = a;
+
+    ESTAT_SOMAR(paresPossiveis, (unsigned long long)n * (n - 1) / 2);
+    for (int f = 0; f < 256; f++) {
+        unsigned long long k = inicio[f + 1] - inicio[f];
+        ESTAT_SOMAR(paresComparados, k * (k - 1) / 2);
+    }
+
+    VetorPontos pontos = {NULL, 0, 0};
+    size_t alinhados = 0;
+    IndiceCoord* ocupadas = mapa != NULL
+        ? indexarLista(lista, mapa->linhas, mapa->colunas)
+        : indexarLista(lista, 0, 0);
+
+    // Pares apenas dentro de cada grupo de frequência
+    for (int f = 0; f < 256; f++) {
+        for (size_t i = inicio[f]; i < inicio[f + 1]; i++) {
+            Antena* a1 = grupos[i];
+            for (size_t j = i + 1; j < inicio[f + 1]; j++) {
+                Antena* a2 = grupos[j];
+                long long dx = (long long)a2->x - a1->x;
+                long long dy = (long long)a2->y - a1->y;
+                if (!antenasAlinhadas(dx, dy)) continue;
+                alinhados++;
+
+                // Calcular pontos de efeito
+                long long x1 = a1->x - dx;
+                long long y1 = a1->y - dy;
+                long long x2 = a2->x + dx;
+                long long y2 = a2->y + dy;
+
+                // Verificar colisão com antenas existentes
+                if ((coordenadaRepresentavel(x1, y1) &&
+                     existeNoIndice(ocupadas, (int)x1, (int)y1)) ||
+                    (coordenadaRepresentavel(x2, y2) &&
+                     existeNoIndice(ocupadas, (int)x2, (int)y2)))
+                    continue;
+
+                // Adicionar pontos válidos
+                if (pontoNoMapa(mapa, x1, y1))
+                    acrescentarPonto(&pontos, (int)x1, (int)y1);
+                if (pontoNoMapa(mapa, x2, y2))
+                    acrescentarPonto(&pontos, (int)x2, (int)y2);
+            }
+        }
+    }
+    free(grupos);
+    libertarIndiceCoord(ocupadas);
+    ESTAT_SOMAR(paresAlinhados, alinhados);
+    ESTAT_SOMAR(verificacoesColisao, 2 * alinhados);
+    ESTAT_SOMAR(efeitosEmitidos, pontos.tamanho);
+
+    // Ordenação e deduplicação, construindo a lista do fim para o início
+    Antena* efeitos = NULL;
+    if (pontos.tamanho > 0) {
+        qsort(pontos.dados, pontos.tamanho, sizeof(Ponto), compararPontos);
+        for (size_t i = pontos.tamanho; i-- > 0; ) {
+            if (efeitos != NULL && efeitos->x == pontos.dados[i].x &&
+                efeitos->y == pontos.dados[i].y)
+                continue;
+            Antena* novo = arena != NULL
+                ? arenaCriarAntena(arena, '#', pontos.dados[i].x, pontos.dados[i].y)
+                : criarAntena('#', pontos.dados[i].x, pontos.dados[i].y);
+            novo->prox = efeitos;
+            efeitos = novo;
+            ESTAT_SOMAR(efeitosUnicos, 1);
+        }
+    }
+    free(pontos.dados);
+    
+    return efeitos;
+}
+
 /**
  * @brief Implementação do cálculo de efeitos nefastos
  * 
  * @param[in] lista Lista de antenas
+ * @param[in] mapa Dimensões do mapa (NULL para mapa ilimitado)
  * @return Antena* Lista de efeitos nefastos
  * 
  * @details Detecta interferência quando:
  * - Mesma frequência
  * - Alinhamento perfeito (H/V/Diagonal)
  * - Proporção de distância 1:2 ou 1:3
+ *
+ * As antenas são primeiro agrupadas por frequência (counting sort estável
+ * sobre o carácter da frequência), pelo que apenas os pares dentro de cada
+ * grupo são comparados. Cada par não ordenado é avaliado uma única vez, já
+ * que o par (a2,a1) produz exatamente os mesmos dois pontos que (a1,a2).
+ * Os pontos resultantes são ordenados e deduplicados no fim, construindo a
+ * lista de efeitos de uma só vez.
  * 
  * @note Pontos de efeito marcados com '#'
+ * A verificação de colisão usa um índice de coordenadas em O(1).
+ * 
+ * @note Complexidade: O(n + Σk²) para grupos de tamanho k
  */
- Antena* calcularEfeitoNefasto(Antena* lista) {
-    Antena* efeitos = NULL;
-    const int max_x = 12, max_y = 12;
+ Antena* calcularEfeitoNefasto(Antena* lista, const Mapa* mapa) {
+    return motorEfeitos(lista, mapa, NULL);
+}
 
-    // Primeira antena para comparação
-    Antena* a1 = lista;
-    while (a1 != NULL) {
-        // Segunda antena para comparação
-        Antena* a2 = lista;
-        while (a2 != NULL) {
-            // Não comparar a mesma antena
-            if (a1 != a2 && a1->frequencia == a2->frequencia) {
-                int dx = a2->x - a1->x;
-                int dy = a2->y - a1->y;
-                
-                // Verificar 8 tipos de alinhamento válidos
-                if (dx == 0 || dy == 0 || abs(dx) == abs(dy) || 
-                   (abs(dx) == 2*abs(dy)) || (2*abs(dx) == abs(dy)) ||
-                   (abs(dx) == 3*abs(dy)) || (3*abs(dx) == abs(dy))) {
-                    
-                    // Calcular pontos de efeito
-                    int x1 = a1->x - dx;
-                    int y1 = a1->y - dy;
-                    int x2 = a2->x + dx;
-                    int y2 = a2->y + dy;
-                    
-                    // Verificar colisão com antenas existentes
-                    int sobrescreve_antena = 0;
-                    Antena* temp = lista;
-                    while (temp != NULL) {
-                        if ((temp->x == x1 && temp->y == y1) ||
-                            (temp->x == x2 && temp->y == y2)) {
-                            sobrescreve_antena = 1;
-                            break;
-                        }
-                        temp = temp->prox;
-                    }
-                    
-                    // Adicionar pontos válidos
-                    if (!sobrescreve_antena) {
-                        if (x1 >= 0 && x1 < max_x && y1 >= 0 && y1 < max_y) {
-                            if (!existeNaLista(efeitos, x1, y1)) {
-                                efeitos = inserirAntena(efeitos, '#', x1, y1);
-                            }
-                        }
-                        if (x2 >= 0 && x2 < max_x && y2 >= 0 && y2 < max_y) {
-                            if (!existeNaLista(efeitos, x2, y2)) {
-                                efeitos = inserirAntena(efeitos, '#', x2, y2);
-                            }
-                        }
-                    }
-                }
-            }
-            a2 = a2->prox;
-        }
-        a1 = a1->prox;
-    }
-    
-    return efeitos;
+/**
+ * @brief Implementação do cálculo de efeitos com nós retirados de uma arena
+ * 
+ * @param[in] arena Arena onde é construída a lista de efeitos
+ * @param[in] lista Lista de antenas
+ * @param[in] mapa Dimensões do mapa (NULL para mapa ilimitado)
+ * @return Antena* Lista de efeitos nefastos
+ */
+Antena* calcularEfeitoNefastoNaArena(ArenaAntenas* arena, Antena* lista, const Mapa* mapa) {
+    return motorEfeitos(lista, mapa, arena);
 }
\ No newline at end of file
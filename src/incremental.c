@@ -0,0 +1,198 @@
+/**
+ * @file incremental.c
+ * @brief Implementação da manutenção incremental dos efeitos nefastos
+ * 
+ * @details Um par (a,b) da mesma frequência e alinhado produz os pontos
+ * p1 = 2a - b e p2 = 2b - a, e é válido se nenhum deles estiver ocupado.
+ * Como p1 = 2a - b, os pares que têm uma célula P como ponto de efeito são
+ * exatamente (a, 2a - P) para cada antena a, o que permite encontrá-los
+ * com uma consulta ao índice por antena.
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include "incremental.h"
+ #include "memoria.h"
+ #include "estatisticas.h"
+
+/**
+ * @brief Soma delta à contagem de um ponto de efeito dentro do mapa
+ */
+static void contribuir(EstadoEfeitos* estado, long long x, long long y, int delta) {
+    Mapa mapa = {estado->linhas, estado->colunas};
+    if (pontoNoMapa(&mapa, x, y)) {
+        contagemSomar(estado->efeitos, (int)x, (int)y, delta);
+        ESTAT_SOMAR(efeitosEmitidos, 1);
+    }
+}
+
+/**
+ * @brief Verifica se um ponto calculado em 64 bits está ocupado por uma antena
+ */
+static int ocupado(const AntenaSet* c, long long x, long long y) {
+    return coordenadaRepresentavel(x, y) && existeNoConjunto(c, (int)x, (int)y);
+}
+
+/**
+ * @brief Avalia o par (a,b) e, se válido, soma delta aos seus dois pontos
+ */
+static void avaliarPar(EstadoEfeitos* estado, int ax, int ay, int bx, int by, int delta) {
+    long long dx = (long long)bx - ax, dy = (long long)by - ay;
+    ESTAT_SOMAR(paresComparados, 1);
+    if (!antenasAlinhadas(dx, dy)) return;
+    ESTAT_SOMAR(paresAlinhados, 1);
+    ESTAT_SOMAR(verificacoesColisao, 2);
+
+    long long x1 = ax - dx, y1 = ay - dy;
+    long long x2 = bx + dx, y2 = by + dy;
+    if (ocupado(estado->antenas, x1, y1) || ocupado(estado->antenas, x2, y2))
+        return;
+    contribuir(estado, x1, y1, delta);
+    contribuir(estado, x2, y2, delta);
+}
+
+/**
+ * @brief Avalia todos os pares entre (x,y) e o grupo da frequência indicada
+ */
+static void avaliarGrupo(EstadoEfeitos* estado, char frequencia, int x, int y, int delta) {
+    const AntenaSet* c = estado->antenas;
+    int f = (unsigned char)frequencia;
+    ESTAT_SOMAR(paresPossiveis, c->tamanho - 1);
+    for (size_t i = c->inicio[f]; i < c->inicio[f + 1]; i++) {
+        if (c->x[i] == x && c->y[i] == y) continue;
+        avaliarPar(estado, x, y, c->x[i], c->y[i], delta);
+    }
+}
+
+const int DIRECOES_ALINHAMENTO[24][2] = {
+    {1, 0}, {-1, 0}, {0, 1}, {0, -1},
+    {1, 1}, {1, -1}, {-1, 1}, {-1, -1},
+    {2, 1}, {2, -1}, {-2, 1}, {-2, -1}, {1, 2}, {1, -2}, {-1, 2}, {-1, -2},
+    {3, 1}, {3, -1}, {-3, 1}, {-3, -1}, {1, 3}, {1, -3}, {-1, 3}, {-1, -3}
+};
+
+/**
+ * @brief Ativa ou anula o par (B,C) com ponto de efeito em P, se for válido
+ *
+ * @details C = 2B - P tem de ser uma antena do grupo de B, o par tem de
+ * estar alinhado e o outro ponto C + (C - B) tem de estar livre.
+ */
+static void atualizarPar(EstadoEfeitos* estado, int px, int py, size_t b, int delta) {
+    const AntenaSet* c = estado->antenas;
+    long long cx = 2LL * c->x[b] - px, cy = 2LL * c->y[b] - py;
+    if (!ocupado(c, cx, cy)) return;
+    if (procurarNoGrupo(c, c->frequencia[b], (int)cx, (int)cy) == CONJUNTO_NAO_ENCONTRADO) return;
+
+    long long dx = cx - c->x[b], dy = cy - c->y[b];
+    if (!antenasAlinhadas(dx, dy)) return;
+    if (ocupado(c, cx + dx, cy + dy)) return;
+    contribuir(estado, px, py, delta);
+    contribuir(estado, cx + dx, cy + dy, delta);
+}
+
+/**
+ * @brief Ativa (delta > 0) ou anula (delta < 0) os pares com ponto de efeito em P
+ * 
+ * @details Com o mapa limitado, P e todas as antenas dentro dele, B e C
+ * percorrem-se ao longo das 24 direções enquanto C = P + 2t·u estiver no
+ * mapa: O(lado do mapa) consultas em vez de O(n). Caso contrário, ou
+ * quando n é menor do que 12 lados, percorrem-se todas as antenas.
+ * 
+ * @note Deve ser chamada com P desocupada: antes de ocupar (anular) ou
+ *       depois de libertar (ativar) a célula
+ */
+static void atualizarBloqueios(EstadoEfeitos* estado, int px, int py, int delta) {
+    const AntenaSet* c = estado->antenas;
+    const Mapa mapa = {estado->linhas, estado->colunas};
+    size_t lado = (size_t)(estado->linhas > estado->colunas ? estado->linhas : estado->colunas);
+    int raios = estado->linhas > 0 && estado->colunas > 0 && estado->foraDoMapa == 0 &&
+                pontoNoMapa(&mapa, px, py) && 12 * lado < c->tamanho;
+
+    if (!raios) {
+        for (size_t i = 0; i < c->tamanho; i++) atualizarPar(estado, px, py, i, delta);
+        return;
+    }
+    for (int d = 0; d < 24; d++) {
+        long long ux = DIRECOES_ALINHAMENTO[d][0], uy = DIRECOES_ALINHAMENTO[d][1];
+        for (long long t = 1; pontoNoMapa(&mapa, px + 2 * t * ux, py + 2 * t * uy); t++) {
+            // B e C ocupadas e o outro ponto livre antes de procurar o grupo de B
+            int bx = (int)(px + t * ux), by = (int)(py + t * uy);
+            long long cx = px + 2 * t * ux, cy = py + 2 * t * uy;
+            if (!existeNoConjunto(c, bx, by) || !existeNoConjunto(c, (int)cx, (int)cy) ||
+                ocupado(c, cx + t * ux, cy + t * uy)) continue;
+            atualizarPar(estado, px, py, procurarNoConjunto(c, bx, by), delta);
+        }
+    }
+}
+
+EstadoEfeitos* criarEstadoEfeitos(Antena* lista, int linhas, int colunas) {
+    EstadoEfeitos* estado = (EstadoEfeitos*)realocar(NULL, 1, sizeof(EstadoEfeitos));
+    estado->linhas = linhas;
+    estado->colunas = colunas;
+    estado->antenas = conjuntoDeLista(lista, linhas, colunas);
+    estado->efeitos = criarContagemCoord(estado->antenas->tamanho);
+    estado->foraDoMapa = 0;
+
+    const AntenaSet* c = estado->antenas;
+    const Mapa mapa = {linhas, colunas};
+    for (size_t i = 0; i < c->tamanho; i++)
+        if (!pontoNoMapa(&mapa, c->x[i], c->y[i])) estado->foraDoMapa++;
+    ESTAT_SOMAR(paresPossiveis, (unsigned long long)c->tamanho * (c->tamanho - 1) / 2);
+    for (int f = 0; f < 256; f++)
+        for (size_t i = c->inicio[f]; i < c->inicio[f + 1]; i++)
+            for (size_t j = i + 1; j < c->inicio[f + 1]; j++)
+                avaliarPar(estado, c->x[i], c->y[i], c->x[j], c->y[j], 1);
+    return estado;
+}
+
+void libertarEstadoEfeitos(EstadoEfeitos* estado) {
+    if (estado == NULL) return;
+    libertarConjunto(estado->antenas);
+    libertarContagemCoord(estado->efeitos);
+    free(estado);
+}
+
+int estadoInserirAntena(EstadoEfeitos* estado, char frequencia, int x, int y) {
+    if (existeNoConjunto(estado->antenas, x, y)) return 0;
+
+    // Um par válido com ponto de efeito no mapa está contado nesse ponto;
+    // fora do mapa não há contagem e o outro ponto pode estar dentro
+    const Mapa mapa = {estado->linhas, estado->colunas};
+    int dentro = pontoNoMapa(&mapa, x, y);
+    if (!dentro || contagemValor(estado->efeitos, x, y) > 0)
+        atualizarBloqueios(estado, x, y, -1);
+    inserirNoConjunto(estado->antenas, frequencia, x, y);
+    if (!dentro) estado->foraDoMapa++;
+    avaliarGrupo(estado, frequencia, x, y, 1);
+    return 1;
+}
+
+int estadoRemoverAntena(EstadoEfeitos* estado, int x, int y) {
+    size_t pos = procurarNoConjunto(estado->antenas, x, y);
+    if (pos == CONJUNTO_NAO_ENCONTRADO) return 0;
+
+    char frequencia = estado->antenas->frequencia[pos];
+    avaliarGrupo(estado, frequencia, x, y, -1);
+    removerDoConjunto(estado->antenas, x, y);
+    const Mapa mapa = {estado->linhas, estado->colunas};
+    if (!pontoNoMapa(&mapa, x, y)) estado->foraDoMapa--;
+    atualizarBloqueios(estado, x, y, 1);
+    return 1;
+}
+
+int estadoTemEfeito(const EstadoEfeitos* estado, int x, int y) {
+    return contagemValor(estado->efeitos, x, y) > 0;
+}
+
+Antena* estadoListaEfeitos(const EstadoEfeitos* estado) {
+    return contagemParaLista(estado->efeitos, '#');
+}
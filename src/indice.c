@@ -0,0 +1,319 @@
+/**
+ * @file indice.c
+ * @brief Implementação do índice de coordenadas (bitmap ou hash)
+ * 
+ * @details A tabela de hash usa sondagem linear com remoção por
+ * deslocamento para trás (sem marcas de remoção), mantendo o fator de
+ * carga abaixo de 0.5.
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include "indice.h"
+ #include "memoria.h"
+
+/**
+ * @brief Indica se (x,y) está dentro da área coberta pelo bitmap
+ */
+static int dentroDoBitmap(const IndiceCoord* indice, int x, int y) {
+    return x >= 0 && x < indice->colunas && y >= 0 && y < indice->linhas;
+}
+
+/**
+ * @brief Posição do bit de (x,y) no bitmap (ordem por linhas)
+ */
+static size_t posicaoBit(const IndiceCoord* indice, int x, int y) {
+    return (size_t)y * (size_t)indice->colunas + (size_t)x;
+}
+
+/**
+ * @brief Procura a posição da chave ou da primeira posição livre
+ */
+static size_t procurarPosicao(const IndiceCoord* indice, uint64_t chave) {
+    size_t mascara = indice->capacidade - 1;
+    size_t i = dispersarChave(chave) & mascara;
+    while (indice->usados[i] && indice->chaves[i] != chave)
+        i = (i + 1) & mascara;
+    return i;
+}
+
+/**
+ * @brief Inicializa a tabela de hash com a capacidade indicada
+ */
+static void iniciarHash(IndiceCoord* indice, size_t previstos) {
+    size_t capacidade = 16;
+    while (capacidade < previstos * 2) capacidade <<= 1;
+    indice->modo = INDICE_HASH;
+    indice->capacidade = capacidade;
+    indice->chaves = (uint64_t*)alocarZeros(capacidade, sizeof(uint64_t));
+    indice->usados = (uint8_t*)alocarZeros(capacidade, sizeof(uint8_t));
+}
+
+/**
+ * @brief Insere uma chave na tabela sem verificar a carga
+ */
+static int inserirChave(IndiceCoord* indice, uint64_t chave) {
+    size_t i = procurarPosicao(indice, chave);
+    if (indice->usados[i]) return 0;
+    indice->usados[i] = 1;
+    indice->chaves[i] = chave;
+    indice->tamanho++;
+    return 1;
+}
+
+/**
+ * @brief Duplica a capacidade da tabela de hash
+ */
+static void crescerHash(IndiceCoord* indice) {
+    uint64_t* chaves = indice->chaves;
+    uint8_t* usados = indice->usados;
+    size_t capacidade = indice->capacidade;
+
+    indice->tamanho = 0;
+    iniciarHash(indice, capacidade);
+    for (size_t i = 0; i < capacidade; i++)
+        if (usados[i]) inserirChave(indice, chaves[i]);
+    free(chaves);
+    free(usados);
+}
+
+/**
+ * @brief Converte um índice em bitmap para o modo hash
+ */
+static void converterParaHash(IndiceCoord* indice) {
+    uint8_t* bits = indice->bits;
+    size_t total = (size_t)indice->linhas * (size_t)indice->colunas;
+
+    indice->bits = NULL;
+    indice->tamanho = 0;
+    iniciarHash(indice, total / INDICE_RACIO_DENSO + 1);
+    for (size_t p = 0; p < total; p++) {
+        if (bits[p >> 3] & (1u << (p & 7))) {
+            if (indice->tamanho * 2 >= indice->capacidade) crescerHash(indice);
+            inserirChave(indice, chaveOrdenada((int)(p % (size_t)indice->colunas),
+                                            (int)(p / (size_t)indice->colunas)));
+        }
+    }
+    free(bits);
+}
+
+IndiceCoord* criarIndiceCoord(int linhas, int colunas, size_t previstos) {
+    IndiceCoord* indice = (IndiceCoord*)alocarZeros(1, sizeof(IndiceCoord));
+    size_t base = previstos < 4096 ? 4096 : previstos;
+
+    if (linhas > 0 && colunas > 0 &&
+        (size_t)linhas <= (base * INDICE_RACIO_DENSO) / (size_t)colunas) {
+        size_t total = (size_t)linhas * (size_t)colunas;
+        indice->modo = INDICE_BITMAP;
+        indice->linhas = linhas;
+        indice->colunas = colunas;
+        indice->bits = (uint8_t*)alocarZeros((total + 7) / 8, sizeof(uint8_t));
+    } else {
+        iniciarHash(indice, previstos);
+    }
+    return indice;
+}
+
+IndiceCoord* indexarLista(Antena* lista, int linhas, int colunas) {
+    size_t n = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox) n++;
+
+    IndiceCoord* indice = criarIndiceCoord(linhas, colunas, n);
+    for (Antena* a = lista; a != NULL; a = a->prox)
+        indiceInserir(indice, a->x, a->y);
+    return indice;
+}
+
+void libertarIndiceCoord(IndiceCoord* indice) {
+    if (indice == NULL) return;
+    free(indice->bits);
+    free(indice->chaves);
+    free(indice->usados);
+    free(indice);
+}
+
+int existeNoIndice(const IndiceCoord* indice, int x, int y) {
+    if (indice->modo == INDICE_BITMAP) {
+        if (!dentroDoBitmap(indice, x, y)) return 0;
+        size_t p = posicaoBit(indice, x, y);
+        return (indice->bits[p >> 3] >> (p & 7)) & 1;
+    }
+    return indice->usados[procurarPosicao(indice, chaveOrdenada(x, y))];
+}
+
+int indiceInserir(IndiceCoord* indice, int x, int y) {
+    if (indice->modo == INDICE_BITMAP) {
+        if (dentroDoBitmap(indice, x, y)) {
+            size_t p = posicaoBit(indice, x, y);
+            if (indice->bits[p >> 3] & (1u << (p & 7))) return 0;
+            indice->bits[p >> 3] |= (uint8_t)(1u << (p & 7));
+            indice->tamanho++;
+            return 1;
+        }
+        converterParaHash(indice);
+    }
+    if ((indice->tamanho + 1) * 2 > indice->capacidade) crescerHash(indice);
+    return inserirChave(indice, chaveOrdenada(x, y));
+}
+
+int indiceRemover(IndiceCoord* indice, int x, int y) {
+    if (indice->modo == INDICE_BITMAP) {
+        if (!dentroDoBitmap(indice, x, y)) return 0;
+        size_t p = posicaoBit(indice, x, y);
+        if (!(indice->bits[p >> 3] & (1u << (p & 7)))) return 0;
+        indice->bits[p >> 3] &= (uint8_t)~(1u << (p & 7));
+        indice->tamanho--;
+        return 1;
+    }
+
+    size_t mascara = indice->capacidade - 1;
+    size_t i = procurarPosicao(indice, chaveOrdenada(x, y));
+    if (!indice->usados[i]) return 0;
+
+    // Remoção por deslocamento para trás, preservando as cadeias de sondagem
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mascara;
+        if (!indice->usados[j]) break;
+        size_t ideal = dispersarChave(indice->chaves[j]) & mascara;
+        if (((j - ideal) & mascara) >= ((j - i) & mascara)) {
+            indice->chaves[i] = indice->chaves[j];
+            i = j;
+        }
+    }
+    indice->usados[i] = 0;
+    indice->tamanho--;
+    return 1;
+}
+
+ContagemCoord* criarContagemCoord(size_t previstos) {
+    ContagemCoord* contagem = (ContagemCoord*)alocarZeros(1, sizeof(ContagemCoord));
+    size_t capacidade = 16;
+    while (capacidade < previstos * 2) capacidade <<= 1;
+    contagem->capacidade = capacidade;
+    contagem->chaves = (uint64_t*)alocarZeros(capacidade, sizeof(uint64_t));
+    contagem->valores = (uint32_t*)alocarZeros(capacidade, sizeof(uint32_t));
+    return contagem;
+}
+
+void libertarContagemCoord(ContagemCoord* contagem) {
+    if (contagem == NULL) return;
+    free(contagem->chaves);
+    free(contagem->valores);
+    free(contagem);
+}
+
+/**
+ * @brief Procura a posição da chave ou da primeira posição livre
+ */
+static size_t posicaoContagem(const ContagemCoord* contagem, uint64_t chave) {
+    size_t mascara = contagem->capacidade - 1;
+    size_t i = dispersarChave(chave) & mascara;
+    while (contagem->valores[i] && contagem->chaves[i] != chave)
+        i = (i + 1) & mascara;
+    return i;
+}
+
+/**
+ * @brief Duplica a capacidade da tabela de contagens
+ */
+static void crescerContagem(ContagemCoord* contagem) {
+    uint64_t* chaves = contagem->chaves;
+    uint32_t* valores = contagem->valores;
+    size_t capacidade = contagem->capacidade;
+
+    contagem->capacidade = capacidade * 2;
+    contagem->chaves = (uint64_t*)alocarZeros(contagem->capacidade, sizeof(uint64_t));
+    contagem->valores = (uint32_t*)alocarZeros(contagem->capacidade, sizeof(uint32_t));
+    for (size_t i = 0; i < capacidade; i++) {
+        if (!valores[i]) continue;
+        size_t j = posicaoContagem(contagem, chaves[i]);
+        contagem->chaves[j] = chaves[i];
+        contagem->valores[j] = valores[i];
+    }
+    free(chaves);
+    free(valores);
+}
+
+uint32_t contagemValor(const ContagemCoord* contagem, int x, int y) {
+    return contagem->valores[posicaoContagem(contagem, chaveOrdenada(x, y))];
+}
+
+uint32_t contagemSomar(ContagemCoord* contagem, int x, int y, int delta) {
+    uint64_t chave = chaveOrdenada(x, y);
+    size_t i = posicaoContagem(contagem, chave);
+
+    if (!contagem->valores[i]) {
+        if (delta <= 0) return 0;
+        if ((contagem->tamanho + 1) * 2 > contagem->capacidade) {
+            crescerContagem(contagem);
+            i = posicaoContagem(contagem, chave);
+        }
+        contagem->chaves[i] = chave;
+        contagem->valores[i] = (uint32_t)delta;
+        contagem->tamanho++;
+        return (uint32_t)delta;
+    }
+
+    if (delta > 0 || (uint32_t)(-(int64_t)delta) < contagem->valores[i]) {
+        contagem->valores[i] = (uint32_t)((int64_t)contagem->valores[i] + delta);
+        return contagem->valores[i];
+    }
+
+    // Contador chega a zero: remoção por deslocamento para trás
+    size_t mascara = contagem->capacidade - 1;
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & mascara;
+        if (!contagem->valores[j]) break;
+        size_t ideal = dispersarChave(contagem->chaves[j]) & mascara;
+        if (((j - ideal) & mascara) >= ((j - i) & mascara)) {
+            contagem->chaves[i] = contagem->chaves[j];
+            contagem->valores[i] = contagem->valores[j];
+            i = j;
+        }
+    }
+    contagem->valores[i] = 0;
+    contagem->tamanho--;
+    return 0;
+}
+
+Antena* contagemParaLista(const ContagemCoord* contagem, char frequencia) {
+    if (contagem->tamanho == 0) return NULL;
+
+    uint64_t* chaves = (uint64_t*)alocarZeros(contagem->tamanho, sizeof(uint64_t));
+    size_t n = 0;
+    for (size_t i = 0; i < contagem->capacidade; i++)
+        if (contagem->valores[i]) chaves[n++] = contagem->chaves[i];
+    qsort(chaves, n, sizeof(uint64_t), compararChaves);
+
+    Antena* lista = NULL;
+    for (size_t i = n; i-- > 0; ) {
+        Antena* no = criarAntena(frequencia, xDaChave(chaves[i]), yDaChave(chaves[i]));
+        no->prox = lista;
+        lista = no;
+    }
+    free(chaves);
+    return lista;
+}
+
+Antena* inserirAntenaIndexada(Antena* head, IndiceCoord* indice, char frequencia, int x, int y) {
+    if (existeNoIndice(indice, x, y)) return head;
+    indiceInserir(indice, x, y);
+    return ligarOrdenado(head, criarAntena(frequencia, x, y));
+}
+
+Antena* removerAntenaIndexada(Antena* head, IndiceCoord* indice, int x, int y) {
+    if (!indiceRemover(indice, x, y)) return head;
+    return removerAntena(head, x, y);
+}
@@ -0,0 +1,301 @@
+/**
+ * @file intensidade.c
+ * @brief Implementação do mapa de intensidade da interferência
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include "intensidade.h"
+ #include "memoria.h"
+ #include "kernel.h"
+ #include "estatisticas.h"
+
+/**
+ * @brief Marca de ordem de bytes gravada no cabeçalho
+ */
+ #define INTENSIDADE_ORDEM 0x01020304u
+
+/**
+ * @brief Cabeçalho fixo do ficheiro binário de intensidade
+ */
+typedef struct {
+    char magia[8];          ///< "EDAINT" terminado em '\0'
+    uint32_t versao;        ///< INTENSIDADE_VERSAO
+    uint32_t ordem;         ///< 0x01020304 na ordem de bytes de quem escreveu
+    int32_t linhas;         ///< Número de linhas do mapa
+    int32_t colunas;        ///< Número de colunas do mapa
+    uint32_t maximo;        ///< Maior contagem de uma célula
+    uint32_t reservado;     ///< Alinhamento (zero)
+    uint64_t numCelulas;    ///< Número de células gravadas
+    uint64_t totalPontos;   ///< Soma de todas as contagens
+    uint64_t pontosPorFrequencia[256];  ///< Pontos de efeito de cada frequência
+    uint64_t celulasPorFrequencia[256]; ///< Células atingidas por cada frequência
+} CabecalhoIntensidade;
+
+/**
+ * @brief Marcas da última frequência que atingiu cada célula
+ *
+ * @details Os grupos são percorridos uma frequência de cada vez, pelo que
+ * basta guardar f+1 por célula para contar as frequências distintas.
+ */
+typedef struct {
+    uint16_t* densa;        ///< Grelha de marcas (modo denso)
+    ContagemCoord* esparsa; ///< Tabela de marcas (modo esparso)
+} Marcas;
+
+/**
+ * @brief Soma um ponto de efeito da frequência f à célula (x,y)
+ */
+static void somarPonto(MapaIntensidade* m, Marcas* marcas, int f, int x, int y) {
+    uint32_t valor;
+    int nova;
+    if (m->denso) {
+        size_t c = (size_t)y * (size_t)m->colunas + (size_t)x;
+        valor = ++m->pares[c];
+        nova = marcas->densa[c] != f + 1;
+        if (nova) {
+            marcas->densa[c] = (uint16_t)(f + 1);
+            m->frequencias[c]++;
+        }
+    } else {
+        valor = contagemSomar(m->paresEsparsos, x, y, 1);
+        uint32_t marca = contagemValor(marcas->esparsa, x, y);
+        nova = marca != (uint32_t)(f + 1);
+        if (nova) {
+            contagemSomar(marcas->esparsa, x, y, (f + 1) - (int)marca);
+            contagemSomar(m->frequenciasEsparsas, x, y, 1);
+        }
+    }
+    ESTAT_SOMAR(efeitosEmitidos, 1);
+    if (valor == 1) {
+        m->celulas++;
+        ESTAT_SOMAR(efeitosUnicos, 1);
+    }
+    if (valor > m->maximo) m->maximo = valor;
+    if (nova) m->celulasPorFrequencia[f]++;
+    m->pontosPorFrequencia[f]++;
+    m->totalPontos++;
+}
+
+MapaIntensidade* calcularIntensidade(const AntenaSet* conjunto) {
+    MapaIntensidade* m = (MapaIntensidade*)alocarZeros(1, sizeof(MapaIntensidade));
+    Marcas marcas = {NULL, NULL};
+    m->linhas = conjunto->linhas;
+    m->colunas = conjunto->colunas;
+    m->denso = m->linhas > 0 && m->colunas > 0 &&
+               (size_t)m->linhas <= INTENSIDADE_DENSO_MAXIMO / (size_t)m->colunas;
+    if (m->denso) {
+        size_t celulas = (size_t)m->linhas * (size_t)m->colunas;
+        m->pares = (uint32_t*)alocarZeros(celulas, sizeof(uint32_t));
+        m->frequencias = (uint16_t*)alocarZeros(celulas, sizeof(uint16_t));
+        marcas.densa = (uint16_t*)alocarZeros(celulas, sizeof(uint16_t));
+    } else {
+        m->paresEsparsos = criarContagemCoord(conjunto->tamanho);
+        m->frequenciasEsparsas = criarContagemCoord(conjunto->tamanho);
+        marcas.esparsa = criarContagemCoord(conjunto->tamanho);
+    }
+
+    const int *xs = conjunto->x, *ys = conjunto->y;
+    KernelAlinhamento kernel = escolherKernelPara(xs, ys, conjunto->tamanho);
+    uint32_t alinhados[KERNEL_BLOCO];
+    uint8_t marcasKernel[KERNEL_BLOCO];
+
+    for (int f = 0; f < 256; f++) {
+        size_t fim = conjunto->inicio[f + 1];
+        for (size_t i = conjunto->inicio[f]; i < fim; i++) {
+            for (size_t j0 = i + 1; j0 < fim; j0 += KERNEL_BLOCO) {
+                size_t n = fim - j0 < KERNEL_BLOCO ? fim - j0 : KERNEL_BLOCO;
+                size_t h = kernel(xs + j0, ys + j0, n, xs[i], ys[i],
+                                  conjunto->colunas, conjunto->linhas, alinhados, marcasKernel);
+                ESTAT_SOMAR(paresAlinhados, h);
+                for (size_t k = 0; k < h; k++) {
+                    size_t j = j0 + alinhados[k];
+                    long long dx = (long long)xs[j] - xs[i], dy = (long long)ys[j] - ys[i];
+                    long long x1 = xs[i] - dx, y1 = ys[i] - dy;
+                    long long x2 = xs[j] + dx, y2 = ys[j] + dy;
+                    int valido1 = coordenadaRepresentavel(x1, y1);
+                    int valido2 = coordenadaRepresentavel(x2, y2);
+                    if ((valido1 && existeNoIndice(conjunto->ocupadas, (int)x1, (int)y1)) ||
+                        (valido2 && existeNoIndice(conjunto->ocupadas, (int)x2, (int)y2)))
+                        continue;
+                    if (valido1 && (marcasKernel[k] & KERNEL_PONTO1)) somarPonto(m, &marcas, f, (int)x1, (int)y1);
+                    if (valido2 && (marcasKernel[k] & KERNEL_PONTO2)) somarPonto(m, &marcas, f, (int)x2, (int)y2);
+                }
+            }
+        }
+    }
+
+    free(marcas.densa);
+    libertarContagemCoord(marcas.esparsa);
+    return m;
+}
+
+void libertarIntensidade(MapaIntensidade* mapa) {
+    if (mapa == NULL) return;
+    free(mapa->pares);
+    free(mapa->frequencias);
+    libertarContagemCoord(mapa->paresEsparsos);
+    libertarContagemCoord(mapa->frequenciasEsparsas);
+    free(mapa);
+}
+
+/**
+ * @brief Verifica se (x,y) está dentro da grelha densa
+ */
+static int naGrelha(const MapaIntensidade* m, int x, int y) {
+    return x >= 0 && y >= 0 && x < m->colunas && y < m->linhas;
+}
+
+uint32_t intensidadePares(const MapaIntensidade* mapa, int x, int y) {
+    if (!mapa->denso) return contagemValor(mapa->paresEsparsos, x, y);
+    if (!naGrelha(mapa, x, y)) return 0;
+    return mapa->pares[(size_t)y * (size_t)mapa->colunas + (size_t)x];
+}
+
+unsigned intensidadeFrequencias(const MapaIntensidade* mapa, int x, int y) {
+    if (!mapa->denso) return contagemValor(mapa->frequenciasEsparsas, x, y);
+    if (!naGrelha(mapa, x, y)) return 0;
+    return mapa->frequencias[(size_t)y * (size_t)mapa->colunas + (size_t)x];
+}
+
+int exportarIntensidadePGM(const MapaIntensidade* mapa, const char* filename, int fator) {
+    if (mapa->linhas <= 0 || mapa->colunas <= 0 || fator <= 0) {
+        fprintf(stderr, "Erro: Dimensões inválidas do mapa\n");
+        return 0;
+    }
+    size_t largura = ((size_t)mapa->colunas + (size_t)fator - 1) / (size_t)fator;
+    size_t altura = ((size_t)mapa->linhas + (size_t)fator - 1) / (size_t)fator;
+    uint32_t* blocos = (uint32_t*)calloc(largura * altura, sizeof(uint32_t));
+    if (blocos == NULL) {
+        fprintf(stderr, "Erro de alocação de memória\n");
+        return 0;
+    }
+
+    // Máximo de cada bloco, a partir da grelha ou só das células presentes na tabela
+    if (mapa->denso) {
+        for (int y = 0; y < mapa->linhas; y++) {
+            const uint32_t* linha = mapa->pares + (size_t)y * (size_t)mapa->colunas;
+            uint32_t* destino = blocos + (size_t)(y / fator) * largura;
+            for (int x = 0; x < mapa->colunas; x++)
+                if (linha[x] > destino[x / fator]) destino[x / fator] = linha[x];
+        }
+    } else {
+        const ContagemCoord* c = mapa->paresEsparsos;
+        for (size_t i = 0; i < c->capacidade; i++) {
+            if (!c->valores[i]) continue;
+            int x = xDaChave(c->chaves[i]), y = yDaChave(c->chaves[i]);
+            if (!naGrelha(mapa, x, y)) continue;
+            uint32_t* b = &blocos[(size_t)(y / fator) * largura + (size_t)(x / fator)];
+            if (c->valores[i] > *b) *b = c->valores[i];
+        }
+    }
+
+    FILE* f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", filename);
+        free(blocos);
+        return 0;
+    }
+    int ok = fprintf(f, "P5\n%zu %zu\n255\n", largura, altura) > 0;
+    uint8_t* linha = (uint8_t*)alocarZeros(largura, 1);
+    uint64_t maximo = mapa->maximo ? mapa->maximo : 1;
+    for (size_t by = 0; ok && by < altura; by++) {
+        for (size_t bx = 0; bx < largura; bx++)
+            linha[bx] = (uint8_t)(((uint64_t)blocos[by * largura + bx] * 255 + maximo - 1) / maximo);
+        ok = fwrite(linha, 1, largura, f) == largura;
+    }
+    free(linha);
+    free(blocos);
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) fprintf(stderr, "Erro: Falha ao escrever o ficheiro %s\n", filename);
+    return ok;
+}
+
+/**
+ * @brief Escreve n bytes seguidos de enchimento até múltiplo de 8
+ */
+static int escreverSecao(FILE* f, const void* dados, size_t n) {
+    static const char zeros[8] = {0};
+    if (n > 0 && fwrite(dados, 1, n, f) != n) return 0;
+    size_t enchimento = ((n + 7) & ~(size_t)7) - n;
+    return enchimento == 0 || fwrite(zeros, 1, enchimento, f) == enchimento;
+}
+
+int exportarIntensidadeBinaria(const MapaIntensidade* mapa, const char* filename) {
+    size_t n = mapa->celulas, k = 0;
+    int32_t* xs = (int32_t*)alocarZeros(n, sizeof(int32_t));
+    int32_t* ys = (int32_t*)alocarZeros(n, sizeof(int32_t));
+    uint32_t* pares = (uint32_t*)alocarZeros(n, sizeof(uint32_t));
+    uint16_t* frequencias = (uint16_t*)alocarZeros(n, sizeof(uint16_t));
+
+    // Células por ordem (x,y): percurso por colunas da grelha ou chaves ordenadas da tabela
+    if (mapa->denso) {
+        for (int x = 0; x < mapa->colunas; x++) {
+            for (int y = 0; y < mapa->linhas; y++) {
+                size_t c = (size_t)y * (size_t)mapa->colunas + (size_t)x;
+                if (!mapa->pares[c]) continue;
+                xs[k] = x; ys[k] = y;
+                pares[k] = mapa->pares[c];
+                frequencias[k] = mapa->frequencias[c];
+                k++;
+            }
+        }
+    } else {
+        uint64_t* chaves = (uint64_t*)alocarZeros(n, sizeof(uint64_t));
+        const ContagemCoord* c = mapa->paresEsparsos;
+        for (size_t i = 0; i < c->capacidade; i++)
+            if (c->valores[i]) chaves[k++] = c->chaves[i];
+        if (k > 1) qsort(chaves, k, sizeof(uint64_t), compararChaves);
+        for (size_t i = 0; i < k; i++) {
+            xs[i] = xDaChave(chaves[i]);
+            ys[i] = yDaChave(chaves[i]);
+            pares[i] = contagemValor(mapa->paresEsparsos, xs[i], ys[i]);
+            frequencias[i] = (uint16_t)contagemValor(mapa->frequenciasEsparsas, xs[i], ys[i]);
+        }
+        free(chaves);
+    }
+
+    CabecalhoIntensidade cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magia, "EDAINT", 7);
+    cab.versao = INTENSIDADE_VERSAO;
+    cab.ordem = INTENSIDADE_ORDEM;
+    cab.linhas = mapa->linhas;
+    cab.colunas = mapa->colunas;
+    cab.maximo = mapa->maximo;
+    cab.numCelulas = k;
+    cab.totalPontos = mapa->totalPontos;
+    for (int f = 0; f < 256; f++) {
+        cab.pontosPorFrequencia[f] = mapa->pontosPorFrequencia[f];
+        cab.celulasPorFrequencia[f] = mapa->celulasPorFrequencia[f];
+    }
+
+    int ok = 0;
+    FILE* f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", filename);
+    } else {
+        ok = escreverSecao(f, &cab, sizeof(cab)) &&
+             escreverSecao(f, xs, k * sizeof(int32_t)) &&
+             escreverSecao(f, ys, k * sizeof(int32_t)) &&
+             escreverSecao(f, pares, k * sizeof(uint32_t)) &&
+             escreverSecao(f, frequencias, k * sizeof(uint16_t));
+        if (fclose(f) != 0) ok = 0;
+        if (!ok) fprintf(stderr, "Erro: Falha ao escrever o ficheiro %s\n", filename);
+    }
+    free(xs);
+    free(ys);
+    free(pares);
+    free(frequencias);
+    return ok;
+}
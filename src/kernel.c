@@ -0,0 +1,227 @@
+/**
+ * @file kernel.c
+ * @brief Implementações escalar, SSE4.1 e AVX2 do teste de alinhamento
+ * 
+ * @details As versões vetoriais são compiladas com atributos de alvo, pelo
+ * que o programa não exige flags -m específicas; só são chamadas se o
+ * processador as suportar.
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdlib.h>
+ #include <string.h>
+ #include <limits.h>
+ #include <pthread.h>
+ #include "kernel.h"
+ #include "funcoes.h"
+
+ #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+ #define KERNEL_X86 1
+ #include <immintrin.h>
+ #endif
+
+size_t kernelEscalar(const int* xs, const int* ys, size_t n,
+                     int x0, int y0, int colunas, int linhas,
+                     uint32_t* indices, uint8_t* pontos) {
+    const Mapa mapa = {linhas, colunas};
+    size_t total = 0;
+    for (size_t j = 0; j < n; j++) {
+        long long dx = (long long)xs[j] - x0;
+        long long dy = (long long)ys[j] - y0;
+        if (!antenasAlinhadas(dx, dy)) continue;
+        indices[total] = (uint32_t)j;
+        pontos[total] = (uint8_t)((pontoNoMapa(&mapa, x0 - dx, y0 - dy) ? KERNEL_PONTO1 : 0) |
+                                  (pontoNoMapa(&mapa, xs[j] + dx, ys[j] + dy) ? KERNEL_PONTO2 : 0));
+        total++;
+    }
+    return total;
+}
+
+ #ifdef KERNEL_X86
+
+/**
+ * @brief Limite de um eixo para a comparação sem sinal dos kernels vetoriais
+ * 
+ * @details Com o bit de sinal trocado, v < limite (sem sinal) equivale a
+ * 0 <= v < dimensão; um eixo sem limite aceita todo o v >= 0 (como
+ * pontoNoMapa). As coordenadas cabem em ±KERNEL_COORD_MAXIMA, pelo que
+ * os pontos projetados não transbordam em 32 bits.
+ */
+static int limiteEixo(int dimensao) {
+    return (int)((dimensao > 0 ? (unsigned)dimensao : 0x80000000u) ^ 0x80000000u);
+}
+
+/**
+ * @brief Versão SSE4.1: 4 parceiros por instrução
+ */
+__attribute__((target("sse4.1")))
+static size_t kernelSse41(const int* xs, const int* ys, size_t n,
+                          int x0, int y0, int colunas, int linhas,
+                          uint32_t* indices, uint8_t* pontos) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i sinal = _mm_set1_epi32(INT_MIN);
+    const __m128i vx0 = _mm_set1_epi32(x0), vy0 = _mm_set1_epi32(y0);
+    const __m128i limX = _mm_set1_epi32(limiteEixo(colunas));
+    const __m128i limY = _mm_set1_epi32(limiteEixo(linhas));
+    size_t total = 0, j = 0;
+
+    for (; j + 4 <= n; j += 4) {
+        __m128i xj = _mm_loadu_si128((const __m128i*)(xs + j));
+        __m128i yj = _mm_loadu_si128((const __m128i*)(ys + j));
+        __m128i dx = _mm_sub_epi32(xj, vx0), dy = _mm_sub_epi32(yj, vy0);
+        __m128i ax = _mm_abs_epi32(dx), ay = _mm_abs_epi32(dy);
+        __m128i ax2 = _mm_add_epi32(ax, ax), ay2 = _mm_add_epi32(ay, ay);
+        __m128i ax3 = _mm_add_epi32(ax2, ax), ay3 = _mm_add_epi32(ay2, ay);
+
+        __m128i m = _mm_or_si128(_mm_cmpeq_epi32(dx, zero), _mm_cmpeq_epi32(dy, zero));
+        m = _mm_or_si128(m, _mm_cmpeq_epi32(ax, ay));
+        m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi32(ax, ay2), _mm_cmpeq_epi32(ax2, ay)));
+        m = _mm_or_si128(m, _mm_or_si128(_mm_cmpeq_epi32(ax, ay3), _mm_cmpeq_epi32(ax3, ay)));
+        unsigned alinhados = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(m));
+        if (alinhados == 0) continue;
+
+        // Comparação sem sinal via xor do bit de sinal: 0 <= v < limite
+        __m128i x1 = _mm_xor_si128(_mm_sub_epi32(vx0, dx), sinal);
+        __m128i y1 = _mm_xor_si128(_mm_sub_epi32(vy0, dy), sinal);
+        __m128i x2 = _mm_xor_si128(_mm_add_epi32(xj, dx), sinal);
+        __m128i y2 = _mm_xor_si128(_mm_add_epi32(yj, dy), sinal);
+        __m128i d1 = _mm_and_si128(_mm_cmpgt_epi32(limX, x1), _mm_cmpgt_epi32(limY, y1));
+        __m128i d2 = _mm_and_si128(_mm_cmpgt_epi32(limX, x2), _mm_cmpgt_epi32(limY, y2));
+        unsigned dentro1 = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(d1));
+        unsigned dentro2 = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(d2));
+        while (alinhados) {
+            unsigned k = (unsigned)__builtin_ctz(alinhados);
+            indices[total] = (uint32_t)(j + k);
+            pontos[total] = (uint8_t)(((dentro1 >> k) & 1u) * KERNEL_PONTO1 | ((dentro2 >> k) & 1u) * KERNEL_PONTO2);
+            total++;
+            alinhados &= alinhados - 1;
+        }
+    }
+
+    size_t resto = kernelEscalar(xs + j, ys + j, n - j, x0, y0, colunas, linhas,
+                                 indices + total, pontos + total);
+    for (size_t k = total; k < total + resto; k++) indices[k] += (uint32_t)j;
+    return total + resto;
+}
+
+/**
+ * @brief Versão AVX2: 8 parceiros por instrução
+ */
+__attribute__((target("avx2")))
+static size_t kernelAvx2(const int* xs, const int* ys, size_t n,
+                         int x0, int y0, int colunas, int linhas,
+                         uint32_t* indices, uint8_t* pontos) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i sinal = _mm256_set1_epi32(INT_MIN);
+    const __m256i vx0 = _mm256_set1_epi32(x0), vy0 = _mm256_set1_epi32(y0);
+    const __m256i limX = _mm256_set1_epi32(limiteEixo(colunas));
+    const __m256i limY = _mm256_set1_epi32(limiteEixo(linhas));
+    size_t total = 0, j = 0;
+
+    for (; j + 8 <= n; j += 8) {
+        __m256i xj = _mm256_loadu_si256((const __m256i*)(xs + j));
+        __m256i yj = _mm256_loadu_si256((const __m256i*)(ys + j));
+        __m256i dx = _mm256_sub_epi32(xj, vx0), dy = _mm256_sub_epi32(yj, vy0);
+        __m256i ax = _mm256_abs_epi32(dx), ay = _mm256_abs_epi32(dy);
+        __m256i ax2 = _mm256_add_epi32(ax, ax), ay2 = _mm256_add_epi32(ay, ay);
+        __m256i ax3 = _mm256_add_epi32(ax2, ax), ay3 = _mm256_add_epi32(ay2, ay);
+
+        __m256i m = _mm256_or_si256(_mm256_cmpeq_epi32(dx, zero), _mm256_cmpeq_epi32(dy, zero));
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi32(ax, ay));
+        m = _mm256_or_si256(m, _mm256_or_si256(_mm256_cmpeq_epi32(ax, ay2), _mm256_cmpeq_epi32(ax2, ay)));
+        m = _mm256_or_si256(m, _mm256_or_si256(_mm256_cmpeq_epi32(ax, ay3), _mm256_cmpeq_epi32(ax3, ay)));
+        unsigned alinhados = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(m));
+        if (alinhados == 0) continue;
+
+        __m256i x1 = _mm256_xor_si256(_mm256_sub_epi32(vx0, dx), sinal);
+        __m256i y1 = _mm256_xor_si256(_mm256_sub_epi32(vy0, dy), sinal);
+        __m256i x2 = _mm256_xor_si256(_mm256_add_epi32(xj, dx), sinal);
+        __m256i y2 = _mm256_xor_si256(_mm256_add_epi32(yj, dy), sinal);
+        __m256i d1 = _mm256_and_si256(_mm256_cmpgt_epi32(limX, x1), _mm256_cmpgt_epi32(limY, y1));
+        __m256i d2 = _mm256_and_si256(_mm256_cmpgt_epi32(limX, x2), _mm256_cmpgt_epi32(limY, y2));
+        unsigned dentro1 = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(d1));
+        unsigned dentro2 = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(d2));
+        while (alinhados) {
+            unsigned k = (unsigned)__builtin_ctz(alinhados);
+            indices[total] = (uint32_t)(j + k);
+            pontos[total] = (uint8_t)(((dentro1 >> k) & 1u) * KERNEL_PONTO1 | ((dentro2 >> k) & 1u) * KERNEL_PONTO2);
+            total++;
+            alinhados &= alinhados - 1;
+        }
+    }
+
+    size_t resto = kernelEscalar(xs + j, ys + j, n - j, x0, y0, colunas, linhas,
+                                 indices + total, pontos + total);
+    for (size_t k = total; k < total + resto; k++) indices[k] += (uint32_t)j;
+    return total + resto;
+}
+
+ #endif // KERNEL_X86
+
+/**
+ * @brief Implementação escolhida (resolvida uma única vez)
+ */
+static KernelAlinhamento kernelAtual = kernelEscalar;
+
+/**
+ * @brief Nome da implementação escolhida
+ */
+static const char* kernelNome = "escalar";
+
+/**
+ * @brief Garante que a escolha é feita uma vez, mesmo com várias threads
+ */
+static pthread_once_t kernelEscolhido = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Escolhe a implementação pelo processador e por EDA_KERNEL
+ */
+static void resolverKernel(void) {
+    const char* pedido = getenv("EDA_KERNEL");
+ #ifdef KERNEL_X86
+    __builtin_cpu_init();
+    int avx2 = __builtin_cpu_supports("avx2");
+    int sse41 = __builtin_cpu_supports("sse4.1");
+    if (pedido != NULL && strcmp(pedido, "escalar") == 0) {
+        avx2 = sse41 = 0;
+    } else if (pedido != NULL && strcmp(pedido, "sse41") == 0) {
+        avx2 = 0;
+    }
+    if (avx2) {
+        kernelAtual = kernelAvx2;
+        kernelNome = "avx2";
+    } else if (sse41) {
+        kernelAtual = kernelSse41;
+        kernelNome = "sse41";
+    }
+ #else
+    (void)pedido;
+ #endif
+}
+
+KernelAlinhamento escolherKernel(void) {
+    pthread_once(&kernelEscolhido, resolverKernel);
+    return kernelAtual;
+}
+
+KernelAlinhamento escolherKernelPara(const int* xs, const int* ys, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (xs[i] > KERNEL_COORD_MAXIMA || xs[i] < -KERNEL_COORD_MAXIMA ||
+            ys[i] > KERNEL_COORD_MAXIMA || ys[i] < -KERNEL_COORD_MAXIMA)
+            return kernelEscalar;
+    }
+    return escolherKernel();
+}
+
+const char* nomeKernel(void) {
+    escolherKernel();
+    return kernelNome;
+}
@@ -0,0 +1,480 @@
+/**
+ * @file lote.c
+ * @brief Implementação do processamento em lote com etapas em pipeline
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include <time.h>
+ #include <pthread.h>
+ #include <dirent.h>
+ #include <sys/stat.h>
+ #include "lote.h"
+ #include "memoria.h"
+ #include "util.h"
+ #include "conjunto.h"
+ #include "paralelo.h"
+ #include "estatisticas.h"
+
+ #ifdef _WIN32
+ #include <windows.h>
+ #endif
+
+/**
+ * @brief Um mapa a atravessar o pipeline
+ */
+typedef struct {
+    const char* caminho;  ///< Ficheiro do mapa
+    const char* saida;    ///< Ficheiro de efeitos
+    AntenaSet* antenas;   ///< Antenas lidas (NULL se a leitura falhou)
+    AntenaSet* efeitos;   ///< Efeitos calculados
+} TarefaLote;
+
+/**
+ * @brief Fila limitada de tarefas entre duas etapas
+ */
+typedef struct {
+    TarefaLote** itens;       ///< Vetor circular
+    size_t capacidade;        ///< Número máximo de tarefas
+    size_t inicio;            ///< Posição da primeira tarefa
+    size_t tamanho;           ///< Tarefas na fila
+    int produtores;           ///< Threads que ainda podem acrescentar
+    size_t maxima;            ///< Maior profundidade observada
+    unsigned long long somaProfundidades; ///< Soma das profundidades após cada entrada
+    unsigned long long entradas;          ///< Número de entradas
+    pthread_mutex_t trinco;   ///< Protege a fila
+    pthread_cond_t naoVazia;  ///< Sinalizada quando entra uma tarefa ou a fila fecha
+    pthread_cond_t naoCheia;  ///< Sinalizada quando sai uma tarefa
+} FilaLote;
+
+/**
+ * @brief Estado partilhado por todas as threads do lote
+ */
+typedef struct {
+    const ParametrosLote* parametros; ///< Configuração
+    FilaLote filas[LOTE_ETAPAS];      ///< Fila de entrada de cada etapa
+    RelatorioLote relatorio;          ///< Totais (protegidos por trinco)
+    pthread_mutex_t trinco;           ///< Protege o relatório
+} Pipeline;
+
+/**
+ * @brief Argumento de cada thread: a etapa que executa
+ */
+typedef struct {
+    Pipeline* pipeline; ///< Estado partilhado
+    int etapa;          ///< 0 leitura, 1 cálculo, 2 escrita
+    Estatisticas contadores; ///< Contadores de --stats desta thread
+} TrabalhadorLote;
+
+/**
+ * @brief Relógio monotónico em segundos
+ */
+static double agora(void) {
+ #ifdef _WIN32
+    LARGE_INTEGER f, t;
+    QueryPerformanceFrequency(&f);
+    QueryPerformanceCounter(&t);
+    return (double)t.QuadPart / (double)f.QuadPart;
+ #else
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + (double)t.tv_nsec * 1e-9;
+ #endif
+}
+
+/**
+ * @brief Duplica uma cadeia de caracteres
+ */
+static char* duplicar(const char* texto) {
+    size_t n = strlen(texto) + 1;
+    char* copia = (char*)realocar(NULL, n, 1);
+    memcpy(copia, texto, n);
+    return copia;
+}
+
+/**
+ * @brief Acrescenta um caminho ao vetor de mapas
+ */
+static void acrescentarMapa(char*** mapas, size_t* numero, size_t* capacidade, char* caminho) {
+    if (*numero == *capacidade) {
+        *capacidade = *capacidade ? *capacidade * 2 : 64;
+        *mapas = (char**)realocar(*mapas, *capacidade, sizeof(char*));
+    }
+    (*mapas)[(*numero)++] = caminho;
+}
+
+/**
+ * @brief Compara dois caminhos por ordem alfabética
+ */
+static int compararCaminhos(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+char** listarMapas(const char* caminho, size_t* numero) {
+    char** mapas = NULL;
+    size_t capacidade = 0;
+    struct stat info;
+    *numero = 0;
+
+    if (stat(caminho, &info) != 0) {
+        fprintf(stderr, "Erro: Não foi possível abrir %s\n", caminho);
+        return NULL;
+    }
+
+    if (S_ISDIR(info.st_mode)) {
+        DIR* dir = opendir(caminho);
+        if (dir == NULL) {
+            fprintf(stderr, "Erro: Não foi possível abrir o diretório %s\n", caminho);
+            return NULL;
+        }
+        struct dirent* entrada;
+        while ((entrada = readdir(dir)) != NULL) {
+            if (entrada->d_name[0] == '.') continue;
+            size_t n = strlen(caminho) + strlen(entrada->d_name) + 2;
+            char* completo = (char*)realocar(NULL, n, 1);
+            snprintf(completo, n, "%s/%s", caminho, entrada->d_name);
+            if (stat(completo, &info) == 0 && S_ISREG(info.st_mode))
+                acrescentarMapa(&mapas, numero, &capacidade, completo);
+            else
+                free(completo);
+        }
+        closedir(dir);
+        if (mapas == NULL) mapas = (char**)realocar(NULL, 1, sizeof(char*));
+        if (*numero > 1) qsort(mapas, *numero, sizeof(char*), compararCaminhos);
+        return mapas;
+    }
+
+    FILE* f = fopen(caminho, "r");
+    if (f == NULL) {
+        fprintf(stderr, "Erro: Não foi possível abrir o ficheiro %s\n", caminho);
+        return NULL;
+    }
+    char linha[4096];
+    while (fgets(linha, sizeof(linha), f) != NULL) {
+        size_t n = strcspn(linha, "\r\n");
+        linha[n] = '\0';
+        char* p = linha;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '\0' || *p == '#') continue;
+        acrescentarMapa(&mapas, numero, &capacidade, duplicar(p));
+    }
+    fclose(f);
+    if (mapas == NULL) mapas = (char**)realocar(NULL, 1, sizeof(char*));
+    return mapas;
+}
+
+void libertarListaMapas(char** mapas, size_t numero) {
+    if (mapas == NULL) return;
+    for (size_t i = 0; i < numero; i++) free(mapas[i]);
+    free(mapas);
+}
+
+/**
+ * @brief Inicializa uma fila vazia
+ */
+static void iniciarFila(FilaLote* fila, size_t capacidade, int produtores) {
+    memset(fila, 0, sizeof(*fila));
+    fila->itens = (TarefaLote**)realocar(NULL, capacidade, sizeof(TarefaLote*));
+    fila->capacidade = capacidade;
+    fila->produtores = produtores;
+    pthread_mutex_init(&fila->trinco, NULL);
+    pthread_cond_init(&fila->naoVazia, NULL);
+    pthread_cond_init(&fila->naoCheia, NULL);
+}
+
+/**
+ * @brief Liberta os recursos de uma fila
+ */
+static void destruirFila(FilaLote* fila) {
+    free(fila->itens);
+    pthread_mutex_destroy(&fila->trinco);
+    pthread_cond_destroy(&fila->naoVazia);
+    pthread_cond_destroy(&fila->naoCheia);
+}
+
+/**
+ * @brief Acrescenta uma tarefa, esperando se a fila estiver cheia
+ */
+static void colocarNaFila(FilaLote* fila, TarefaLote* tarefa) {
+    pthread_mutex_lock(&fila->trinco);
+    while (fila->tamanho == fila->capacidade) pthread_cond_wait(&fila->naoCheia, &fila->trinco);
+    fila->itens[(fila->inicio + fila->tamanho) % fila->capacidade] = tarefa;
+    fila->tamanho++;
+    if (fila->tamanho > fila->maxima) fila->maxima = fila->tamanho;
+    fila->somaProfundidades += fila->tamanho;
+    fila->entradas++;
+    pthread_cond_signal(&fila->naoVazia);
+    pthread_mutex_unlock(&fila->trinco);
+}
+
+/**
+ * @brief Retira uma tarefa, esperando se a fila estiver vazia
+ *
+ * @return TarefaLote* Tarefa, ou NULL se a fila está vazia e sem produtores
+ */
+static TarefaLote* retirarDaFila(FilaLote* fila) {
+    pthread_mutex_lock(&fila->trinco);
+    while (fila->tamanho == 0 && fila->produtores > 0)
+        pthread_cond_wait(&fila->naoVazia, &fila->trinco);
+    TarefaLote* tarefa = NULL;
+    if (fila->tamanho > 0) {
+        tarefa = fila->itens[fila->inicio];
+        fila->inicio = (fila->inicio + 1) % fila->capacidade;
+        fila->tamanho--;
+        pthread_cond_signal(&fila->naoCheia);
+    }
+    pthread_mutex_unlock(&fila->trinco);
+    return tarefa;
+}
+
+/**
+ * @brief Regista que um produtor terminou; o último acorda os consumidores
+ */
+static void terminarProdutor(FilaLote* fila) {
+    pthread_mutex_lock(&fila->trinco);
+    if (--fila->produtores == 0) pthread_cond_broadcast(&fila->naoVazia);
+    pthread_mutex_unlock(&fila->trinco);
+}
+
+/**
+ * @brief Caminho do ficheiro de efeitos de um mapa
+ */
+static char* caminhoSaida(const char* diretorio, const char* mapa) {
+    const char* nome = mapa;
+    if (diretorio != NULL) {
+        const char* barra = strrchr(mapa, '/');
+ #ifdef _WIN32
+        const char* invertida = strrchr(mapa, '\\');
+        if (invertida != NULL && (barra == NULL || invertida > barra)) barra = invertida;
+ #endif
+        if (barra != NULL) nome = barra + 1;
+    }
+    size_t n = (diretorio ? strlen(diretorio) + 1 : 0) + strlen(nome) + sizeof(LOTE_EXTENSAO);
+    char* caminho = (char*)realocar(NULL, n, 1);
+    if (diretorio != NULL) snprintf(caminho, n, "%s/%s%s", diretorio, nome, LOTE_EXTENSAO);
+    else snprintf(caminho, n, "%s%s", nome, LOTE_EXTENSAO);
+    return caminho;
+}
+
+/**
+ * @brief Compara dois caminhos de saída (para qsort)
+ */
+static int compararSaidas(const void* a, const void* b) {
+    return strcmp(**(const char* const* const*)a, **(const char* const* const*)b);
+}
+
+/**
+ * @brief Caminhos de saída de todos os mapas, com os repetidos a NULL
+ *
+ * @details Com --saida só o nome do mapa é usado, pelo que a/m.txt e
+ * b/m.txt dariam o mesmo ficheiro; fica só o primeiro da lista e os
+ * restantes são recusados, em vez de se sobreporem.
+ */
+static char** caminhosSaida(char** mapas, size_t numero, const char* diretorio) {
+    char** saidas = (char**)realocar(NULL, numero, sizeof(char*));
+    char*** ordem = (char***)realocar(NULL, numero, sizeof(char**));
+    for (size_t i = 0; i < numero; i++) {
+        saidas[i] = caminhoSaida(diretorio, mapas[i]);
+        ordem[i] = &saidas[i];
+    }
+    qsort(ordem, numero, sizeof(char**), compararSaidas);
+
+    for (size_t i = 0; i < numero; ) {
+        // Em cada grupo de caminhos iguais fica o mapa que aparece primeiro na lista
+        size_t fim = i + 1;
+        while (fim < numero && strcmp(*ordem[fim], *ordem[i]) == 0) fim++;
+        char** primeiro = ordem[i];
+        for (size_t k = i + 1; k < fim; k++) if (ordem[k] < primeiro) primeiro = ordem[k];
+        for (size_t k = i; k < fim; k++) {
+            if (ordem[k] == primeiro) continue;
+            fprintf(stderr, "Erro: %s escreveria em %s, já usado por %s\n",
+                    mapas[ordem[k] - saidas], *ordem[k], mapas[primeiro - saidas]);
+            free(*ordem[k]);
+            *ordem[k] = NULL;
+        }
+        i = fim;
+    }
+    free(ordem);
+    return saidas;
+}
+
+/**
+ * @brief Escreve os efeitos de um mapa, uma linha "x y" por efeito
+ *
+ * @note Os efeitos do conjunto estão por ordem (x,y)
+ */
+static int escreverEfeitos(const TarefaLote* tarefa) {
+    const char* caminho = tarefa->saida;
+    FILE* f = fopen(caminho, "w");
+    if (f == NULL) {
+        fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", caminho);
+        return 0;
+    }
+    const AntenaSet* e = tarefa->efeitos;
+    int ok = 1;
+    for (size_t i = 0; ok && i < e->tamanho; i++)
+        ok = fprintf(f, "%d %d\n", e->x[i], e->y[i]) > 0;
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) fprintf(stderr, "Erro: Falha ao escrever o ficheiro %s\n", caminho);
+    return ok;
+}
+
+/**
+ * @brief Executa uma etapa sobre uma tarefa
+ *
+ * @return int 1 se a tarefa segue para a etapa seguinte
+ */
+static int executarEtapa(Pipeline* p, int etapa, TarefaLote* tarefa) {
+    int linhas, colunas;
+    switch (etapa) {
+    case 0:
+        // Um mapa inválido segue como tarefa sem antenas e conta como falha na escrita
+        tarefa->antenas = tentarCarregarConjuntoDoMapa(tarefa->caminho, &linhas, &colunas);
+        return 1;
+    case 1:
+        if (tarefa->antenas != NULL) tarefa->efeitos = calcularEfeitoNefastoConjunto(tarefa->antenas);
+        return 1;
+    default: {
+        int ok = tarefa->efeitos != NULL && escreverEfeitos(tarefa);
+        pthread_mutex_lock(&p->trinco);
+        if (ok) {
+            p->relatorio.mapas++;
+            p->relatorio.antenas += tarefa->antenas->tamanho;
+            p->relatorio.efeitos += tarefa->efeitos->tamanho;
+        } else {
+            p->relatorio.falhas++;
+        }
+        pthread_mutex_unlock(&p->trinco);
+        libertarConjunto(tarefa->antenas);
+        libertarConjunto(tarefa->efeitos);
+        free(tarefa);
+        return 0;
+    }
+    }
+}
+
+/**
+ * @brief Ciclo de cada thread: retira da fila da etapa, trabalha e passa à seguinte
+ */
+static void* trabalharLote(void* arg) {
+    TrabalhadorLote* t = (TrabalhadorLote*)arg;
+    Pipeline* p = t->pipeline;
+    double ocupada = 0.0;
+    size_t mapas = 0;
+    TarefaLote* tarefa;
+
+    // Os motores correm em várias threads: cada uma soma nos seus contadores
+    desviarEstatisticas(&t->contadores);
+    while ((tarefa = retirarDaFila(&p->filas[t->etapa])) != NULL) {
+        double inicio = agora();
+        int segue = executarEtapa(p, t->etapa, tarefa);
+        ocupada += agora() - inicio;
+        mapas++;
+        if (segue) colocarNaFila(&p->filas[t->etapa + 1], tarefa);
+    }
+    if (t->etapa + 1 < LOTE_ETAPAS) terminarProdutor(&p->filas[t->etapa + 1]);
+    desviarEstatisticas(NULL);
+
+    pthread_mutex_lock(&p->trinco);
+    p->relatorio.etapas[t->etapa].segundosOcupada += ocupada;
+    p->relatorio.etapas[t->etapa].mapas += mapas;
+    pthread_mutex_unlock(&p->trinco);
+    return NULL;
+}
+
+RelatorioLote processarLote(char** mapas, size_t numero, const ParametrosLote* parametros) {
+    static const char* nomes[LOTE_ETAPAS] = {"leitura", "calculo", "escrita"};
+    ParametrosLote omissao = {NULL, 0, 0, 0, 0};
+    if (parametros == NULL) parametros = &omissao;
+
+    int threads[LOTE_ETAPAS];
+    threads[0] = parametros->leitores > 0 ? parametros->leitores : 1;
+    threads[1] = parametros->calculadores > 0 ? parametros->calculadores : numeroProcessadores();
+    threads[2] = parametros->escritores > 0 ? parametros->escritores : 1;
+    size_t capacidade = parametros->capacidadeFila ? parametros->capacidadeFila : LOTE_FILA_OMISSAO;
+
+    Pipeline p;
+    memset(&p, 0, sizeof(p));
+    p.parametros = parametros;
+    pthread_mutex_init(&p.trinco, NULL);
+    iniciarFila(&p.filas[0], capacidade, 1);  // Alimentada pela thread principal
+    for (int e = 1; e < LOTE_ETAPAS; e++) iniciarFila(&p.filas[e], capacidade, threads[e - 1]);
+
+    char** saidas = caminhosSaida(mapas, numero, parametros->saida);
+    for (size_t i = 0; i < numero; i++)
+        if (saidas[i] == NULL) p.relatorio.falhas++;
+
+    int total = threads[0] + threads[1] + threads[2];
+    pthread_t* ids = (pthread_t*)realocar(NULL, (size_t)total, sizeof(pthread_t));
+    TrabalhadorLote* trabalhadores = (TrabalhadorLote*)realocar(NULL, (size_t)total, sizeof(TrabalhadorLote));
+    double inicio = agora();
+    for (int e = 0, k = 0; e < LOTE_ETAPAS; e++) {
+        for (int i = 0; i < threads[e]; i++, k++) {
+            trabalhadores[k].pipeline = &p;
+            trabalhadores[k].etapa = e;
+            memset(&trabalhadores[k].contadores, 0, sizeof(Estatisticas));
+            if (pthread_create(&ids[k], NULL, trabalharLote, &trabalhadores[k]) != 0) {
+                fprintf(stderr, "Erro: Não foi possível criar a thread %d\n", k);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    // A thread principal só alimenta a primeira fila, bloqueando quando está cheia
+    for (size_t i = 0; i < numero; i++) {
+        if (saidas[i] == NULL) continue;
+        TarefaLote* tarefa = (TarefaLote*)realocar(NULL, 1, sizeof(TarefaLote));
+        tarefa->caminho = mapas[i];
+        tarefa->saida = saidas[i];
+        tarefa->antenas = NULL;
+        tarefa->efeitos = NULL;
+        colocarNaFila(&p.filas[0], tarefa);
+    }
+    terminarProdutor(&p.filas[0]);
+    for (int k = 0; k < total; k++) pthread_join(ids[k], NULL);
+    for (int k = 0; k < total; k++) juntarEstatisticas(&trabalhadores[k].contadores);
+    p.relatorio.segundos = agora() - inicio;
+
+    for (int e = 0; e < LOTE_ETAPAS; e++) {
+        EtapaLote* etapa = &p.relatorio.etapas[e];
+        etapa->nome = nomes[e];
+        etapa->threads = threads[e];
+        etapa->filaMaxima = p.filas[e].maxima;
+        etapa->filaMedia = p.filas[e].entradas
+            ? (double)p.filas[e].somaProfundidades / (double)p.filas[e].entradas : 0.0;
+        destruirFila(&p.filas[e]);
+    }
+    for (size_t i = 0; i < numero; i++) free(saidas[i]);
+    free(saidas);
+    free(ids);
+    free(trabalhadores);
+    pthread_mutex_destroy(&p.trinco);
+    return p.relatorio;
+}
+
+void imprimirRelatorioLote(FILE* saida, const RelatorioLote* r) {
+    double segundos = r->segundos > 0.0 ? r->segundos : 1e-9;
+    fprintf(saida, "Lote: %zu mapas, %zu falhas, %llu antenas, %llu efeitos em %.3f s\n",
+            r->mapas, r->falhas, r->antenas, r->efeitos, r->segundos);
+    fprintf(saida, "Débito: %.1f mapas/s, %.0f antenas/s\n",
+            (double)(r->mapas + r->falhas) / segundos, (double)r->antenas / segundos);
+    fprintf(saida, "  %-10s %7s %7s %12s %10s %10s %10s\n",
+            "etapa", "threads", "mapas", "ocupada_s", "ocupacao", "fila_max", "fila_media");
+    for (int e = 0; e < LOTE_ETAPAS; e++) {
+        const EtapaLote* etapa = &r->etapas[e];
+        double ocupacao = etapa->segundosOcupada / (segundos * (etapa->threads > 0 ? etapa->threads : 1));
+        fprintf(saida, "  %-10s %7d %7zu %12.3f %9.1f%% %10zu %10.2f\n",
+                etapa->nome ? etapa->nome : "", etapa->threads, etapa->mapas,
+                etapa->segundosOcupada, 100.0 * ocupacao, etapa->filaMaxima, etapa->filaMedia);
+    }
+}
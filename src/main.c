@@ -21,10 +21,363 @@
  #include <stdlib.h>
  #include "funcoes.h"
  #include "util.h"
- 
+ #include <string.h>
+ #include "incremental.h"
+ #include "servidor.h"
+ #include "estatisticas.h"
+ #include "faixas.h"
+ #include "intensidade.h"
+ #include "lote.h"
+ #include "regras.h"
+ #include "consulta.h"
+ #include "esparso.h"
+
+/**
+ * @brief Indica se um argumento é uma opção --stats (tratada em main)
+ * 
+ * @param[in] argumento Argumento da linha de comandos
+ * @return int 1 se começa por "--stats", 0 caso contrário
+ */
+ static int opcaoEstatisticas(const char* argumento) {
+     return strncmp(argumento, "--stats", 7) == 0;
+ }
+
+/**
+ * @brief Modo servidor: carrega o mapa uma vez e atende comandos
+ * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos: --servidor [mapa] [--socket caminho]
+ * @return int Código de saída (0 para sucesso)
+ * 
+ * @see servidor.h para o protocolo de comandos
+ */
+ static int executarServidor(int argc, char* argv[]) {
+     const char* ficheiro = "mapa.txt";
+     const char* caminho = NULL;
+     for (int i = 2; i < argc; i++) {
+         if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) caminho = argv[++i];
+         else if (!opcaoEstatisticas(argv[i])) ficheiro = argv[i];
+     }
+
+     Servidor* servidor = criarServidor(ficheiro);
+     int ok = 1;
+     if (caminho != NULL) ok = servirSocket(servidor, caminho);
+     else servirDescritor(servidor, 0, stdout);
+     libertarServidor(servidor);
+     return ok ? 0 : 1;
+ }
+
+/**
+ * @brief Modo fora de memória: escreve os efeitos de um mapa por faixas
+ * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos: --faixas [mapa] [--memoria MiB] [--saida ficheiro]
+ * @return int Código de saída (0 para sucesso)
+ * 
+ * @see faixas.h para as fases do cálculo
+ */
+ static int executarFaixas(int argc, char* argv[]) {
+     const char* ficheiro = "mapa.txt";
+     const char* caminho = NULL;
+     size_t memoria = 0;
+     for (int i = 2; i < argc; i++) {
+         if (strcmp(argv[i], "--memoria") == 0 && i + 1 < argc) memoria = (size_t)strtoull(argv[++i], NULL, 10) << 20;
+         else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) caminho = argv[++i];
+         else if (!opcaoEstatisticas(argv[i])) ficheiro = argv[i];
+     }
+
+     FILE* saida = caminho != NULL ? fopen(caminho, "w") : stdout;
+     if (saida == NULL) {
+         fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", caminho);
+         return 1;
+     }
+     long long total = calcularEfeitosPorFaixas(ficheiro, saida, memoria);
+     if (saida != stdout) fclose(saida);
+     if (total < 0) return 1;
+     fprintf(stderr, "%lld efeitos\n", total);
+     return 0;
+ }
+
+/**
+ * @brief Modo intensidade: conta pares e frequências por célula
+ * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos: --intensidade [mapa] [--pgm ficheiro] [--fator n] [--binario ficheiro]
+ * @return int Código de saída (0 para sucesso)
+ * 
+ * @note Escreve em stdout os totais por frequência; as exportações só são
+ *       feitas quando pedidas
+ */
+ static int executarIntensidade(int argc, char* argv[]) {
+     const char* ficheiro = "mapa.txt";
+     const char* pgm = NULL;
+     const char* binario = NULL;
+     int fator = 1;
+     for (int i = 2; i < argc; i++) {
+         if (strcmp(argv[i], "--pgm") == 0 && i + 1 < argc) pgm = argv[++i];
+         else if (strcmp(argv[i], "--binario") == 0 && i + 1 < argc) binario = argv[++i];
+         else if (strcmp(argv[i], "--fator") == 0 && i + 1 < argc) fator = atoi(argv[++i]);
+         else if (!opcaoEstatisticas(argv[i])) ficheiro = argv[i];
+     }
+
+     int linhas, colunas;
+     AntenaSet* conjunto = carregarConjuntoDoMapa(ficheiro, &linhas, &colunas);
+     MapaIntensidade* mapa = calcularIntensidade(conjunto);
+     printf("Celulas com efeito: %zu, pontos: %llu, maximo por celula: %u\n",
+            mapa->celulas, mapa->totalPontos, mapa->maximo);
+     for (int f = 0; f < 256; f++) {
+         if (mapa->pontosPorFrequencia[f] == 0) continue;
+         printf("Frequencia %c: %llu pontos em %llu celulas\n", f,
+                mapa->pontosPorFrequencia[f], mapa->celulasPorFrequencia[f]);
+     }
+
+     int ok = 1;
+     if (pgm != NULL) ok = exportarIntensidadePGM(mapa, pgm, fator) && ok;
+     if (binario != NULL) ok = exportarIntensidadeBinaria(mapa, binario) && ok;
+     libertarIntensidade(mapa);
+     libertarConjunto(conjunto);
+     return ok ? 0 : 1;
+ }
+
+/**
+ * @brief Modo lote: processa vários mapas com leitura, cálculo e escrita em pipeline
+ * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos: --lote <diretorio|manifesto> [--saida diretorio] [--threads n] [--fila n]
+ * @return int Código de saída (0 se todos os mapas foram processados)
+ * 
+ * @note Cada mapa dá origem a um ficheiro <mapa>.efeitos; o relatório de
+ *       débito e das filas é escrito em stderr
+ */
+ static int executarLote(int argc, char* argv[]) {
+     const char* origem = NULL;
+     ParametrosLote parametros = {NULL, 0, 0, 0, 0};
+     for (int i = 2; i < argc; i++) {
+         if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) parametros.saida = argv[++i];
+         else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) parametros.calculadores = atoi(argv[++i]);
+         else if (strcmp(argv[i], "--fila") == 0 && i + 1 < argc) parametros.capacidadeFila = (size_t)strtoull(argv[++i], NULL, 10);
+         else if (!opcaoEstatisticas(argv[i])) origem = argv[i];
+     }
+     if (origem == NULL) {
+         fprintf(stderr, "Uso: %s --lote <diretorio|manifesto> [--saida diretorio] [--threads n] [--fila n]\n", argv[0]);
+         return 1;
+     }
+
+     size_t numero;
+     char** mapas = listarMapas(origem, &numero);
+     if (mapas == NULL) return 1;
+     RelatorioLote relatorio = processarLote(mapas, numero, &parametros);
+     imprimirRelatorioLote(stderr, &relatorio);
+     libertarListaMapas(mapas, numero);
+     return relatorio.falhas == 0 ? 0 : 1;
+ }
+
+/**
+ * @brief Modo regras: calcula os efeitos com um perfil de alinhamento configurável
+ * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos: --regras perfil [mapa] [--saida ficheiro]
+ * @return int Código de saída (0 para sucesso)
+ * 
+ * @note Os efeitos são escritos como "x y" por ordem (x,y), em stdout se
+ *       não for indicado ficheiro; o resumo vai para stderr
+ * @see regras.h para o formato do perfil
+ */
+ static int executarRegras(int argc, char* argv[]) {
+     const char* perfil = REGRAS_PERFIL_OMISSAO;
+     const char* ficheiro = "mapa.txt";
+     const char* caminho = NULL;
+     int i = 2;
+     if (i < argc && strncmp(argv[i], "--", 2) != 0) perfil = argv[i++];
+     for (; i < argc; i++) {
+         if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) caminho = argv[++i];
+         else if (!opcaoEstatisticas(argv[i])) ficheiro = argv[i];
+     }
+
+     RegrasAlinhamento* regras = (RegrasAlinhamento*)malloc(sizeof(RegrasAlinhamento));
+     if (regras == NULL) {
+         fprintf(stderr, "Erro de alocação de memória\n");
+         return 1;
+     }
+     if (!lerRegras(perfil, regras)) {
+         fprintf(stderr, "Erro: Perfil de regras inválido \"%s\"\n", perfil);
+         free(regras);
+         return 1;
+     }
+
+     int linhas, colunas;
+     AntenaSet* conjunto = carregarConjuntoDoMapa(ficheiro, &linhas, &colunas);
+     AntenaSet* efeitos = calcularEfeitosComRegras(conjunto, regras);
+     FILE* saida = caminho != NULL ? fopen(caminho, "w") : stdout;
+     int ok = saida != NULL;
+     if (!ok) fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", caminho);
+     for (size_t k = 0; ok && k < efeitos->tamanho; k++)
+         ok = fprintf(saida, "%d %d\n", efeitos->x[k], efeitos->y[k]) > 0;
+     if (saida != NULL && saida != stdout && fclose(saida) != 0) ok = 0;
+     fprintf(stderr, "Perfil \"%s\"%s: %zu antenas, %zu efeitos\n", perfil,
+             regras->classicas ? " (clássico)" : "", conjunto->tamanho, efeitos->tamanho);
+
+     libertarConjunto(efeitos);
+     libertarConjunto(conjunto);
+     free(regras);
+     return ok ? 0 : 1;
+ }
+
+/**
+ * @brief Modo consulta: efeitos de algumas frequências numa região do mapa
+ * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos: --consulta [mapa] --regiao x0 y0 x1 y1 [--frequencias lista]
+ * @return int Código de saída (0 para sucesso)
+ * 
+ * @note Só são avaliados os pares que podem projetar na região; os efeitos
+ *       são escritos em stdout como "x y"
+ * @see consulta.h
+ */
+ static int executarConsulta(int argc, char* argv[]) {
+     const char* ficheiro = "mapa.txt";
+     const char* frequencias = NULL;
+     int x0 = 0, y0 = 0, x1 = -1, y1 = -1, regiao = 0;
+     for (int i = 2; i < argc; i++) {
+         if (strcmp(argv[i], "--regiao") == 0 && i + 4 < argc) {
+             x0 = atoi(argv[++i]);
+             y0 = atoi(argv[++i]);
+             x1 = atoi(argv[++i]);
+             y1 = atoi(argv[++i]);
+             regiao = 1;
+         }
+         else if (strcmp(argv[i], "--frequencias") == 0 && i + 1 < argc) frequencias = argv[++i];
+         else if (!opcaoEstatisticas(argv[i])) ficheiro = argv[i];
+     }
+
+     int linhas, colunas;
+     ConsultaEfeitos* consulta = criarConsulta(carregarConjuntoDoMapa(ficheiro, &linhas, &colunas));
+     if (!regiao) {
+         x1 = colunas - 1;
+         y1 = linhas - 1;
+     }
+     size_t n;
+     Coordenada* efeitos = consultarEfeitos(consulta, frequencias, x0, y0, x1, y1, &n);
+     for (size_t k = 0; k < n; k++) printf("%d %d\n", efeitos[k].x, efeitos[k].y);
+     fprintf(stderr, "Regiao (%d,%d)-(%d,%d): %zu efeitos\n", x0, y0, x1, y1, n);
+     free(efeitos);
+     libertarConsulta(consulta);
+     return 0;
+ }
+
+/**
+ * @brief Modo esparso: mapa comprimido por linhas, sem grelha densa
+ * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos: --esparso [mapa] [--janela x y largura altura]
+ *                 [--efeitos] [--exportar ficheiro] [--snapshot ficheiro]
+ * @return int Código de saída (0 para sucesso)
+ * 
+ * @note O mapa pode estar em texto ou no formato comprimido; a janela (o
+ *       mapa inteiro por omissão) é escrita em stdout e a memória usada vai
+ *       para stderr. O snapshot é escrito sem bitmaps
+ * @see esparso.h
+ */
+ static int executarEsparso(int argc, char* argv[]) {
+     const char* ficheiro = "mapa.txt";
+     const char* exportar = NULL;
+     const char* snapshot = NULL;
+     int x0 = 0, y0 = 0, largura = 0, altura = 0, janela = 0, comEfeitos = 0;
+     for (int i = 2; i < argc; i++) {
+         if (strcmp(argv[i], "--janela") == 0 && i + 4 < argc) {
+             x0 = atoi(argv[++i]);
+             y0 = atoi(argv[++i]);
+             largura = atoi(argv[++i]);
+             altura = atoi(argv[++i]);
+             janela = 1;
+         }
+         else if (strcmp(argv[i], "--efeitos") == 0) comEfeitos = 1;
+         else if (strcmp(argv[i], "--exportar") == 0 && i + 1 < argc) exportar = argv[++i];
+         else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) snapshot = argv[++i];
+         else if (!opcaoEstatisticas(argv[i])) ficheiro = argv[i];
+     }
+
+     int linhas, colunas;
+     MapaEsparso* antenas = carregarEsparsoDoMapa(ficheiro, &linhas, &colunas);
+     MapaEsparso* efeitos = NULL;
+     AntenaSet* conjunto = NULL;
+     AntenaSet* conjuntoEfeitos = NULL;
+     if (comEfeitos || snapshot != NULL) conjunto = conjuntoDeEsparso(antenas);
+     if (comEfeitos) {
+         conjuntoEfeitos = calcularEfeitoNefastoConjunto(conjunto);
+         efeitos = esparsoDeConjunto(conjuntoEfeitos);
+     }
+
+     int ok = 1;
+     if (exportar != NULL) ok = guardarMapaEsparso(exportar, antenas) && ok;
+     if (snapshot != NULL) ok = guardarSnapshot(snapshot, conjunto, conjuntoEfeitos, 0) && ok;
+     if (!janela) {
+         largura = colunas;
+         altura = linhas;
+     }
+     if (largura > 0 && altura > 0) imprimirJanelaEsparsa(stdout, antenas, efeitos, x0, y0, largura, altura);
+
+     fprintf(stderr, "Mapa %dx%d: %zu antenas em %zu linhas, %zu efeitos; %zu bytes (grelha densa: %.0f bytes)\n",
+             linhas, colunas, antenas->tamanho, antenas->numLinhas,
+             efeitos != NULL ? efeitos->tamanho : 0,
+             memoriaEsparso(antenas) + (efeitos != NULL ? memoriaEsparso(efeitos) : 0),
+             (double)linhas * (double)colunas);
+
+     libertarConjunto(conjuntoEfeitos);
+     libertarConjunto(conjunto);
+     libertarEsparso(efeitos);
+     libertarEsparso(antenas);
+     return ok ? 0 : 1;
+ }
+
+/**
+ * @brief Modo de execução escolhido pelo primeiro argumento
+ */
+ typedef struct {
+     const char* opcao;                       ///< Primeiro argumento (ex.: "--servidor")
+     int (*executar)(int argc, char* argv[]); ///< Execução do modo; devolve o código de saída
+ } Modo;
+
+/**
+ * @brief Modos disponíveis; sem nenhum deles é executada a demonstração
+ */
+ static const Modo MODOS[] = {
+     {"--servidor", executarServidor},
+     {"--intensidade", executarIntensidade},
+     {"--lote", executarLote},
+     {"--regras", executarRegras},
+     {"--consulta", executarConsulta},
+     {"--esparso", executarEsparso},
+     {"--faixas", executarFaixas},
+ };
+
+/**
+ * @brief Escreve as estatísticas pedidas com --stats e devolve o código de saída
+ * 
+ * @param[in] codigo Código de saída do modo executado
+ * @param[in] stats 0: sem relatório, 1: tabela, 2: JSON
+ * @return int O próprio codigo
+ */
+ static int terminarComEstatisticas(int codigo, int stats) {
+     if (stats) {
+         fflush(stdout);
+         imprimirEstatisticas(stderr, stats == 2);
+     }
+     return codigo;
+ }
+
 /**
  * @brief Ponto de entrada do programa
  * 
+ * @param[in] argc Número de argumentos
+ * @param[in] argv Argumentos (--servidor para o modo servidor; --faixas para
+ *                 o cálculo fora de memória; --intensidade para as
+ *                 contagens por célula; --lote para vários mapas
+ *                 em pipeline; --regras para um perfil de
+ *                 alinhamento configurável; --consulta para os
+ *                 efeitos de uma região; --esparso para o mapa
+ *                 comprimido por linhas; --stats ou
+ *                 --stats=json para escrever as estatísticas em stderr no fim)
  * @return int Código de saída (0 para sucesso)
  * 
  * @note Fluxo de execução:
@@ -38,48 +391,85 @@
  * @see funcoes.h para detalhes das operações implementadas
  * @see util.h para funções auxiliares de I/O
  */
- int main() {
+ int main(int argc, char* argv[]) {
+     int stats = 0;           ///< 0: sem relatório, 1: tabela, 2: JSON
+     for (int i = 1; i < argc; i++) {
+         if (strcmp(argv[i], "--stats") == 0) stats = 1;
+         else if (strcmp(argv[i], "--stats=json") == 0) stats = 2;
+     }
+     if (argc > 1) {
+         for (size_t m = 0; m < sizeof(MODOS) / sizeof(MODOS[0]); m++) {
+             if (strcmp(argv[1], MODOS[m].opcao) == 0)
+                 return terminarComEstatisticas(MODOS[m].executar(argc, argv), stats);
+         }
+     }
+
      /* Estruturas de dados principais */
      Antena* lista = NULL;    ///< Lista principal de antenas
      Antena* efeitos = NULL;  ///< Lista de zonas de interferência
+     EstadoEfeitos* estado;   ///< Efeitos mantidos de forma incremental
      int linhas, colunas;     ///< Dimensões do mapa
+     Mapa mapa;               ///< Limites usados no cálculo dos efeitos
      
      // Fase 1: Carregamento do mapa principal
+     ESTAT_FASE("1 carregamento do mapa");
      lista = carregarAntenasDoMapa("mapa.txt", &linhas, &colunas);
+     mapa.linhas = linhas;
+     mapa.colunas = colunas;
      printf("\nMapa Carregado:\n");
      imprimirMapa(lista, NULL, linhas, colunas);
  
      // Fase 2: Extração de antenas do mapa
+     ESTAT_FASE("2 listagem das antenas");
      printf("\nAntenas Carregadas do Mapa:\n");
      imprimirAntenas(lista);
  
      // Fase 3: Cálculo de efeitos nefastos
-     efeitos = calcularEfeitoNefasto(lista);
+     ESTAT_FASE("3 calculo dos efeitos");
+     efeitos = calcularEfeitoNefasto(lista, &mapa);
      printf("\nLocalizacoes com Efeitos Nefasto:\n");
      imprimirAntenas(efeitos);
      printf("\nMapa Carregado com Efeitos Nefasto:\n");
      imprimirMapa(lista, efeitos, linhas, colunas);
+     estado = criarEstadoEfeitos(lista, linhas, colunas);
  
      // Fase 4: Inserção de Antenas
+     ESTAT_FASE("4 insercao e remocao automatica");
      lista = inserirAntena(lista, '0', 2, 3);
      lista = inserirAntena(lista, 'A', 6, 5);
      lista = inserirAntena(lista, '0', 8, 2);
      lista = inserirAntena(lista, '0', 10, 10);
+     estadoInserirAntena(estado, '0', 2, 3);
+     estadoInserirAntena(estado, 'A', 6, 5);
+     estadoInserirAntena(estado, '0', 8, 2);
+     estadoInserirAntena(estado, '0', 10, 10);
      printf("\nAntenas apos Insercao:\n");
      imprimirAntenas(lista);
 
      // 4.1: Remoção automática por efeitos
+     for (Antena* e = efeitos; e != NULL; e = e->prox) {
+         if (existeNaLista(lista, e->x, e->y)) estadoRemoverAntena(estado, e->x, e->y);
+     }
      lista = removerAntenasEmEfeitos(lista, efeitos);
  
      // Fase 5: Remoção de Antenas
+     ESTAT_FASE("5 remocao");
      lista = removerAntena(lista, 6, 5);
+     estadoRemoverAntena(estado, 6, 5);
      printf("\nAntenas apos Remocao:\n");
      imprimirAntenas(lista);
 
-     // Fase 6: Carregamento do mapa final
-     //efeitos = calcularEfeitoNefasto(lista);
+     // Fase 6: Carregamento do mapa final (efeitos mantidos pelo estado)
+     ESTAT_FASE("6 mapa final");
+     libertarLista(efeitos);
+     efeitos = estadoListaEfeitos(estado);
      printf("\nMapa Final:\n");
      imprimirMapa(lista, efeitos, linhas, colunas);
  
-     return 0;
+     ESTAT_FASE(NULL);
+ 
+     libertarLista(lista);
+     libertarLista(efeitos);
+     libertarEstadoEfeitos(estado);
+     return terminarComEstatisticas(0, stats);
  }
\ No newline at end of file
@@ -0,0 +1,97 @@
+/**
+ * @file mapeamento.c
+ * @brief Implementação do mapeamento de ficheiros para POSIX e Windows
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include "mapeamento.h"
+
+ #ifdef _WIN32
+ #include <windows.h>
+
+int mapearFicheiro(const char* filename, FicheiroMapeado* ficheiro) {
+    ficheiro->dados = NULL;
+    ficheiro->tamanho = 0;
+
+    HANDLE f = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (f == INVALID_HANDLE_VALUE) return 0;
+
+    LARGE_INTEGER tamanho;
+    if (!GetFileSizeEx(f, &tamanho)) {
+        CloseHandle(f);
+        return 0;
+    }
+    if (tamanho.QuadPart > 0) {
+        HANDLE m = CreateFileMappingA(f, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m == NULL) {
+            CloseHandle(f);
+            return 0;
+        }
+        ficheiro->dados = (const char*)MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(m);
+        if (ficheiro->dados == NULL) {
+            CloseHandle(f);
+            return 0;
+        }
+        ficheiro->tamanho = (size_t)tamanho.QuadPart;
+    }
+    CloseHandle(f);
+    return 1;
+}
+
+void desmapearFicheiro(FicheiroMapeado* ficheiro) {
+    if (ficheiro->dados != NULL) UnmapViewOfFile((LPCVOID)ficheiro->dados);
+    ficheiro->dados = NULL;
+    ficheiro->tamanho = 0;
+}
+
+ #else
+ #include <fcntl.h>
+ #include <unistd.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+
+int mapearFicheiro(const char* filename, FicheiroMapeado* ficheiro) {
+    ficheiro->dados = NULL;
+    ficheiro->tamanho = 0;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return 0;
+    }
+    if (info.st_size > 0) {
+        void* p = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            close(fd);
+            return 0;
+        }
+        madvise(p, (size_t)info.st_size, MADV_SEQUENTIAL);
+        ficheiro->dados = (const char*)p;
+        ficheiro->tamanho = (size_t)info.st_size;
+    }
+    close(fd);
+    return 1;
+}
+
+void desmapearFicheiro(FicheiroMapeado* ficheiro) {
+    if (ficheiro->dados != NULL) munmap((void*)ficheiro->dados, ficheiro->tamanho);
+    ficheiro->dados = NULL;
+    ficheiro->tamanho = 0;
+}
+
+ #endif
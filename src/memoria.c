@@ -0,0 +1,68 @@
+/**
+ * @file memoria.c
+ * @brief Implementação da alocação com saída em caso de erro e das chaves (x,y)
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include "memoria.h"
+
+void* realocar(void* p, size_t n, size_t tamanho) {
+    void* novo = realloc(p, (n ? n : 1) * tamanho);
+    if (novo == NULL) {
+        fprintf(stderr, "Erro de alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    return novo;
+}
+
+void* alocarZeros(size_t n, size_t tamanho) {
+    void* p = calloc(n ? n : 1, tamanho);
+    if (p == NULL) {
+        fprintf(stderr, "Erro de alocação de memória\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+int compararChaves(const void* a, const void* b) {
+    uint64_t p = *(const uint64_t*)a, q = *(const uint64_t*)b;
+    return (p > q) - (p < q);
+}
+
+void ordenarPorChave(uint64_t* chaves, size_t* posicoes, size_t n) {
+    if (n < 2) return;
+    uint64_t* chavesAux = (uint64_t*)realocar(NULL, n, sizeof(uint64_t));
+    size_t* posicoesAux = posicoes != NULL ? (size_t*)realocar(NULL, n, sizeof(size_t)) : NULL;
+    size_t contagem[256];
+    for (int desvio = 0; desvio < 64; desvio += 8) {
+        memset(contagem, 0, sizeof(contagem));
+        for (size_t i = 0; i < n; i++) contagem[(chaves[i] >> desvio) & 0xff]++;
+        if (contagem[(chaves[0] >> desvio) & 0xff] == n) continue;
+        size_t soma = 0;
+        for (int d = 0; d < 256; d++) {
+            size_t c = contagem[d];
+            contagem[d] = soma;
+            soma += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            size_t k = contagem[(chaves[i] >> desvio) & 0xff]++;
+            chavesAux[k] = chaves[i];
+            if (posicoes != NULL) posicoesAux[k] = posicoes[i];
+        }
+        memcpy(chaves, chavesAux, n * sizeof(uint64_t));
+        if (posicoes != NULL) memcpy(posicoes, posicoesAux, n * sizeof(size_t));
+    }
+    free(chavesAux);
+    free(posicoesAux);
+}
@@ -0,0 +1,274 @@
+/**
+ * @file morton.c
+ * @brief Implementação do armazenamento por ordem Z (Morton)
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include "morton.h"
+ #include "memoria.h"
+
+/**
+ * @brief Bits de x (posições pares) numa chave de Morton
+ */
+ #define MORTON_BITS_X 0x5555555555555555ULL
+
+/**
+ * @brief Bits de y (posições ímpares) numa chave de Morton
+ */
+ #define MORTON_BITS_Y 0xAAAAAAAAAAAAAAAAULL
+
+/**
+ * @brief Espalha os 32 bits de v pelas posições pares de 64 bits
+ */
+static uint64_t espalhar(uint32_t v) {
+    uint64_t x = v;
+    x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+    x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+    x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    x = (x | (x << 2)) & 0x3333333333333333ULL;
+    x = (x | (x << 1)) & 0x5555555555555555ULL;
+    return x;
+}
+
+/**
+ * @brief Junta os bits das posições pares de v em 32 bits
+ */
+static uint32_t juntar(uint64_t v) {
+    v &= 0x5555555555555555ULL;
+    v = (v | (v >> 1)) & 0x3333333333333333ULL;
+    v = (v | (v >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    v = (v | (v >> 4)) & 0x00FF00FF00FF00FFULL;
+    v = (v | (v >> 8)) & 0x0000FFFF0000FFFFULL;
+    v = (v | (v >> 16)) & 0x00000000FFFFFFFFULL;
+    return (uint32_t)v;
+}
+
+uint64_t chaveMorton(int x, int y) {
+    return espalhar((uint32_t)x ^ 0x80000000u) | (espalhar((uint32_t)y ^ 0x80000000u) << 1);
+}
+
+void descodificarMorton(uint64_t chave, int* x, int* y) {
+    *x = (int)(juntar(chave) ^ 0x80000000u);
+    *y = (int)(juntar(chave >> 1) ^ 0x80000000u);
+}
+
+/**
+ * @brief Cria um conjunto a partir de vetores de coordenadas e frequências
+ */
+static ConjuntoMorton* construir(const int* xs, const int* ys, const char* frequencias, size_t n) {
+    ConjuntoMorton* conjunto = (ConjuntoMorton*)alocarZeros(1, sizeof(ConjuntoMorton));
+    conjunto->chaves = (uint64_t*)realocar(NULL, n, sizeof(uint64_t));
+    conjunto->frequencia = (char*)realocar(NULL, n, sizeof(char));
+    size_t* posicoes = (size_t*)realocar(NULL, n, sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        conjunto->chaves[i] = chaveMorton(xs[i], ys[i]);
+        posicoes[i] = i;
+    }
+    ordenarPorChave(conjunto->chaves, posicoes, n);
+
+    // Ordenação estável: numa chave repetida fica o primeiro elemento
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (k > 0 && conjunto->chaves[i] == conjunto->chaves[k - 1]) continue;
+        conjunto->chaves[k] = conjunto->chaves[i];
+        conjunto->frequencia[k] = frequencias[posicoes[i]];
+        k++;
+    }
+    conjunto->tamanho = k;
+    free(posicoes);
+    return conjunto;
+}
+
+ConjuntoMorton* mortonDeLista(Antena* lista) {
+    size_t n = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox) n++;
+    int* xs = (int*)realocar(NULL, n, sizeof(int));
+    int* ys = (int*)realocar(NULL, n, sizeof(int));
+    char* frequencias = (char*)realocar(NULL, n, sizeof(char));
+    size_t i = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox, i++) {
+        xs[i] = a->x;
+        ys[i] = a->y;
+        frequencias[i] = a->frequencia;
+    }
+    ConjuntoMorton* conjunto = construir(xs, ys, frequencias, n);
+    free(xs);
+    free(ys);
+    free(frequencias);
+    return conjunto;
+}
+
+ConjuntoMorton* mortonDeConjunto(const AntenaSet* conjunto) {
+    return construir(conjunto->x, conjunto->y, conjunto->frequencia, conjunto->tamanho);
+}
+
+void libertarMorton(ConjuntoMorton* conjunto) {
+    if (conjunto == NULL) return;
+    free(conjunto->chaves);
+    free(conjunto->frequencia);
+    free(conjunto);
+}
+
+/**
+ * @brief Primeira posição de [ini,fim) com chave >= valor
+ */
+static size_t limiteInferior(const uint64_t* chaves, size_t ini, size_t fim, uint64_t valor) {
+    while (ini < fim) {
+        size_t meio = ini + (fim - ini) / 2;
+        if (chaves[meio] < valor) ini = meio + 1;
+        else fim = meio;
+    }
+    return ini;
+}
+
+size_t procurarMorton(const ConjuntoMorton* conjunto, int x, int y) {
+    uint64_t chave = chaveMorton(x, y);
+    size_t pos = limiteInferior(conjunto->chaves, 0, conjunto->tamanho, chave);
+    if (pos < conjunto->tamanho && conjunto->chaves[pos] == chave) return pos;
+    return MORTON_NAO_ENCONTRADO;
+}
+
+/**
+ * @brief Menor chave > z dentro do retângulo [zmin, zmax] (BIGMIN)
+ *
+ * @details Percorre os bits do mais significativo para o menos: onde z,
+ * zmin e zmax divergem, o retângulo é dividido ao meio nessa dimensão e a
+ * procura continua na metade que pode conter chaves maiores do que z.
+ */
+static uint64_t bigmin(uint64_t z, uint64_t zmin, uint64_t zmax) {
+    uint64_t resultado = zmax;
+    for (int b = 63; b >= 0; b--) {
+        uint64_t bit = 1ULL << b;
+        uint64_t abaixo = (b % 2 == 0 ? MORTON_BITS_X : MORTON_BITS_Y) & (bit - 1);
+        int bz = (z & bit) != 0, bmin = (zmin & bit) != 0, bmax = (zmax & bit) != 0;
+        if (bz == 0 && bmin == 0 && bmax == 1) {
+            resultado = (zmin | bit) & ~abaixo;         // Início da metade superior
+            zmax = (zmax & ~bit) | abaixo;              // Continua na metade inferior
+        } else if (bz == 0 && bmin == 1 && bmax == 1) {
+            return zmin;
+        } else if (bz == 1 && bmin == 0 && bmax == 0) {
+            return resultado;
+        } else if (bz == 1 && bmin == 0 && bmax == 1) {
+            zmin = (zmin | bit) & ~abaixo;              // Continua na metade superior
+        }
+    }
+    return resultado;
+}
+
+size_t* mortonRetangulo(const ConjuntoMorton* conjunto, int x0, int y0, int x1, int y1, size_t* n) {
+    *n = 0;
+    if (x0 > x1 || y0 > y1 || conjunto->tamanho == 0) return NULL;
+    uint32_t ux0 = (uint32_t)x0 ^ 0x80000000u, ux1 = (uint32_t)x1 ^ 0x80000000u;
+    uint32_t uy0 = (uint32_t)y0 ^ 0x80000000u, uy1 = (uint32_t)y1 ^ 0x80000000u;
+    uint64_t zmin = chaveMorton(x0, y0), zmax = chaveMorton(x1, y1);
+    const uint64_t* chaves = conjunto->chaves;
+    size_t* posicoes = NULL;
+    size_t capacidade = 0;
+
+    size_t i = limiteInferior(chaves, 0, conjunto->tamanho, zmin);
+    while (i < conjunto->tamanho && chaves[i] <= zmax) {
+        uint32_t ux = juntar(chaves[i]), uy = juntar(chaves[i] >> 1);
+        if (ux >= ux0 && ux <= ux1 && uy >= uy0 && uy <= uy1) {
+            if (*n == capacidade) {
+                capacidade = capacidade ? capacidade * 2 : 64;
+                posicoes = (size_t*)realocar(posicoes, capacidade, sizeof(size_t));
+            }
+            posicoes[(*n)++] = i++;
+            continue;
+        }
+        // Fora do retângulo: salta para a próxima chave que lhe pertence
+        i = limiteInferior(chaves, i + 1, conjunto->tamanho, bigmin(chaves[i], zmin, zmax));
+    }
+    return posicoes;
+}
+
+size_t* mortonPercorrer(const ConjuntoMorton* conjunto, int ordem) {
+    size_t n = conjunto->tamanho;
+    uint64_t* chaves = (uint64_t*)realocar(NULL, n, sizeof(uint64_t));
+    size_t* posicoes = (size_t*)realocar(NULL, n, sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t ux = juntar(conjunto->chaves[i]), uy = juntar(conjunto->chaves[i] >> 1);
+        chaves[i] = ordem == MORTON_POR_COLUNAS ? (ux << 32) | uy : (uy << 32) | ux;
+        posicoes[i] = i;
+    }
+    ordenarPorChave(chaves, posicoes, n);
+    free(chaves);
+    return posicoes;
+}
+
+/**
+ * @brief Células de um conjunto dentro da janela, agrupadas por linha
+ *
+ * @note Counting sort pela linha: O(k + altura)
+ */
+static size_t* agruparPorLinha(const ConjuntoMorton* conjunto, int x0, int y0, int largura, int altura,
+                               size_t** posicoes) {
+    size_t* inicio = (size_t*)alocarZeros((size_t)altura + 1, sizeof(size_t));
+    *posicoes = NULL;
+    if (conjunto == NULL) return inicio;
+
+    size_t n;
+    size_t* dentro = mortonRetangulo(conjunto, x0, y0, (int)((long long)x0 + largura - 1),
+                                     (int)((long long)y0 + altura - 1), &n);
+    int x, y;
+    for (size_t k = 0; k < n; k++) {
+        descodificarMorton(conjunto->chaves[dentro[k]], &x, &y);
+        inicio[y - y0 + 1]++;
+    }
+    for (int r = 0; r < altura; r++) inicio[r + 1] += inicio[r];
+    *posicoes = (size_t*)realocar(NULL, n, sizeof(size_t));
+    size_t* proximo = (size_t*)realocar(NULL, (size_t)altura, sizeof(size_t));
+    memcpy(proximo, inicio, (size_t)altura * sizeof(size_t));
+    for (size_t k = 0; k < n; k++) {
+        descodificarMorton(conjunto->chaves[dentro[k]], &x, &y);
+        (*posicoes)[proximo[y - y0]++] = dentro[k];
+    }
+    free(proximo);
+    free(dentro);
+    return inicio;
+}
+
+void imprimirJanelaMorton(FILE* saida, const ConjuntoMorton* antenas, const ConjuntoMorton* efeitos,
+                          int x0, int y0, int largura, int altura) {
+    if (largura <= 0 || altura <= 0 ||
+        (long long)x0 + largura - 1 > 0x7fffffffLL || (long long)y0 + altura - 1 > 0x7fffffffLL) {
+        fprintf(stderr, "Erro: Dimensões inválidas da janela\n");
+        return;
+    }
+    size_t *pa, *pe;
+    size_t* ia = agruparPorLinha(antenas, x0, y0, largura, altura, &pa);
+    size_t* ie = agruparPorLinha(efeitos, x0, y0, largura, altura, &pe);
+
+    // Efeitos primeiro, antenas por cima, uma escrita por linha
+    char* linha = (char*)realocar(NULL, (size_t)largura + 1, sizeof(char));
+    linha[largura] = '\n';
+    int x, y;
+    for (int r = 0; r < altura; r++) {
+        memset(linha, '.', (size_t)largura);
+        for (size_t k = ie[r]; k < ie[r + 1]; k++) {
+            descodificarMorton(efeitos->chaves[pe[k]], &x, &y);
+            linha[x - x0] = '#';
+        }
+        for (size_t k = ia[r]; k < ia[r + 1]; k++) {
+            descodificarMorton(antenas->chaves[pa[k]], &x, &y);
+            linha[x - x0] = antenas->frequencia[pa[k]];
+        }
+        fwrite(linha, 1, (size_t)largura + 1, saida);
+    }
+    free(linha);
+    free(pa);
+    free(pe);
+    free(ia);
+    free(ie);
+}
@@ -0,0 +1,346 @@
+/**
+ * @file paralelo.c
+ * @brief Implementação do cálculo de efeitos em paralelo
+ * 
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdint.h>
+ #include <string.h>
+ #include <limits.h>
+ #include <pthread.h>
+ #include "paralelo.h"
+ #include "memoria.h"
+ #include "kernel.h"
+ #include "estatisticas.h"
+
+ #ifdef _WIN32
+ #include <windows.h>
+ #else
+ #include <unistd.h>
+ #endif
+
+/**
+ * @brief Tarefa: linhas [i0,i1) do espaço de pares do grupo que termina em fim
+ */
+typedef struct {
+    size_t i0;   ///< Primeira linha i
+    size_t i1;   ///< Linha seguinte à última
+    size_t fim;  ///< Fim do grupo de frequência (limite de j)
+} Tarefa;
+
+/**
+ * @brief Vetor de chaves (x,y) de efeitos de uma faixa de colunas
+ */
+typedef struct {
+    uint64_t* chaves;   ///< Chaves chaveOrdenada(x,y)
+    size_t tamanho;     ///< Número de chaves
+    size_t capacidade;  ///< Capacidade reservada
+} Balde;
+
+/**
+ * @brief Dados partilhados entre as threads
+ */
+typedef struct {
+    const AntenaSet* conjunto; ///< Antenas (só leitura)
+    KernelAlinhamento kernel;  ///< Núcleo de alinhamento, escolhido uma vez
+    Tarefa* tarefas;           ///< Tarefas por ordem de criação
+    size_t numTarefas;         ///< Número de tarefas
+    size_t proxima;            ///< Próxima tarefa (ou faixa) a atribuir
+    pthread_mutex_t trinco;    ///< Protege o campo proxima
+    size_t numFaixas;          ///< Número de faixas de colunas
+    long long largura;         ///< Colunas por faixa
+    int threads;               ///< Número de trabalhadores
+    struct Trabalhador* trabalhadores; ///< Todos os trabalhadores (fusão)
+    Balde* fundidos;           ///< Chaves ordenadas e únicas de cada faixa
+} Partilha;
+
+/**
+ * @brief Argumento de cada thread
+ */
+typedef struct Trabalhador {
+    Partilha* partilha;           ///< Dados partilhados
+    Balde* baldes;                ///< Um balde próprio por faixa de colunas
+    unsigned long long alinhados; ///< Pares alinhados encontrados (estatísticas)
+    unsigned long long emitidos;  ///< Pontos de efeito marcados (estatísticas)
+} Trabalhador;
+
+int numeroProcessadores(void) {
+ #ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+ #else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+ #endif
+}
+
+/**
+ * @brief Ordena um balde e remove as chaves repetidas
+ */
+static void compactarBalde(Balde* b) {
+    ordenarPorChave(b->chaves, NULL, b->tamanho);
+    size_t n = 0;
+    for (size_t i = 0; i < b->tamanho; i++)
+        if (n == 0 || b->chaves[i] != b->chaves[n - 1]) b->chaves[n++] = b->chaves[i];
+    b->tamanho = n;
+}
+
+/**
+ * @brief Acrescenta um ponto de efeito ao balde da sua faixa de colunas
+ * 
+ * @note Um balde cheio é primeiro compactado; só cresce se continuar mais
+ *       de meio cheio, o que limita a memória ao dobro dos pontos distintos
+ */
+static void marcar(Trabalhador* t, int x, int y) {
+    Balde* b = &t->baldes[(size_t)(x / t->partilha->largura)];
+    if (b->tamanho == b->capacidade) {
+        if (b->capacidade >= PARALELO_BALDE_COMPACTAR) compactarBalde(b);
+        if (b->tamanho * 2 >= b->capacidade) {
+            b->capacidade = b->capacidade ? b->capacidade * 2 : 256;
+            b->chaves = (uint64_t*)realocar(b->chaves, b->capacidade, sizeof(uint64_t));
+        }
+    }
+    b->chaves[b->tamanho++] = chaveOrdenada(x, y);
+}
+
+/**
+ * @brief Processa uma tarefa, marcando os efeitos no bitmap da thread
+ */
+static void executarTarefa(const AntenaSet* c, KernelAlinhamento kernel, const Tarefa* t,
+                           Trabalhador* trabalhador) {
+    const int *xs = c->x, *ys = c->y;
+    uint32_t alinhados[KERNEL_BLOCO];
+    uint8_t marcas[KERNEL_BLOCO];
+
+    for (size_t i = t->i0; i < t->i1; i++) {
+        for (size_t j0 = i + 1; j0 < t->fim; j0 += KERNEL_BLOCO) {
+            size_t n = t->fim - j0 < KERNEL_BLOCO ? t->fim - j0 : KERNEL_BLOCO;
+            size_t h = kernel(xs + j0, ys + j0, n, xs[i], ys[i], c->colunas, c->linhas,
+                              alinhados, marcas);
+            trabalhador->alinhados += h;
+            for (size_t k = 0; k < h; k++) {
+                size_t j = j0 + alinhados[k];
+                long long dx = (long long)xs[j] - xs[i];
+                long long dy = (long long)ys[j] - ys[i];
+                long long x1 = xs[i] - dx, y1 = ys[i] - dy;
+                long long x2 = xs[j] + dx, y2 = ys[j] + dy;
+                int valido1 = coordenadaRepresentavel(x1, y1);
+                int valido2 = coordenadaRepresentavel(x2, y2);
+                if ((valido1 && existeNoIndice(c->ocupadas, (int)x1, (int)y1)) ||
+                    (valido2 && existeNoIndice(c->ocupadas, (int)x2, (int)y2)))
+                    continue;
+                // Os pontos marcados pelo núcleo estão no mapa, logo com x >= 0
+                if (valido1 && (marcas[k] & KERNEL_PONTO1)) {
+                    marcar(trabalhador, (int)x1, (int)y1);
+                    trabalhador->emitidos++;
+                }
+                if (valido2 && (marcas[k] & KERNEL_PONTO2)) {
+                    marcar(trabalhador, (int)x2, (int)y2);
+                    trabalhador->emitidos++;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Ciclo de cada thread: retira tarefas até se esgotarem
+ */
+static void* trabalhar(void* arg) {
+    Trabalhador* t = (Trabalhador*)arg;
+    Partilha* p = t->partilha;
+    for (;;) {
+        pthread_mutex_lock(&p->trinco);
+        size_t k = p->proxima++;
+        pthread_mutex_unlock(&p->trinco);
+        if (k >= p->numTarefas) break;
+        executarTarefa(p->conjunto, p->kernel, &p->tarefas[k], t);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Fusão: junta os baldes de cada faixa de todas as threads, ordena e
+ *        remove repetidos, retirando faixas até se esgotarem
+ */
+static void* fundir(void* arg) {
+    Trabalhador* t = (Trabalhador*)arg;
+    Partilha* p = t->partilha;
+    for (;;) {
+        pthread_mutex_lock(&p->trinco);
+        size_t f = p->proxima++;
+        pthread_mutex_unlock(&p->trinco);
+        if (f >= p->numFaixas) break;
+
+        size_t total = 0;
+        for (int w = 0; w < p->threads; w++) total += p->trabalhadores[w].baldes[f].tamanho;
+        Balde* destino = &p->fundidos[f];
+        destino->chaves = (uint64_t*)realocar(NULL, total, sizeof(uint64_t));
+        destino->capacidade = total;
+        destino->tamanho = 0;
+        for (int w = 0; w < p->threads; w++) {
+            Balde* b = &p->trabalhadores[w].baldes[f];
+            if (b->tamanho > 0)
+                memcpy(destino->chaves + destino->tamanho, b->chaves, b->tamanho * sizeof(uint64_t));
+            destino->tamanho += b->tamanho;
+            free(b->chaves);
+            b->chaves = NULL;
+        }
+        compactarBalde(destino);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Corre uma fase em todos os trabalhadores (a thread principal é o 0)
+ */
+static void executarFase(Partilha* p, Trabalhador* trabalhadores, pthread_t* ids,
+                         void* (*fase)(void*)) {
+    p->proxima = 0;
+    for (int t = 1; t < p->threads; t++) {
+        if (pthread_create(&ids[t], NULL, fase, &trabalhadores[t]) != 0) {
+            fprintf(stderr, "Erro: Não foi possível criar a thread %d\n", t);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fase(&trabalhadores[0]);
+    for (int t = 1; t < p->threads; t++) pthread_join(ids[t], NULL);
+}
+
+/**
+ * @brief Parte cada grupo de frequência em tarefas com número de pares semelhante
+ */
+static Tarefa* criarTarefas(const AntenaSet* c, int threads, size_t* numTarefas) {
+    size_t totalPares = 0;
+    for (int f = 0; f < 256; f++) {
+        size_t k = c->inicio[f + 1] - c->inicio[f];
+        totalPares += k * (k > 0 ? k - 1 : 0) / 2;
+    }
+    size_t alvo = totalPares / ((size_t)threads * 8) + 1;
+    if (alvo < PARALELO_PARES_MINIMO) alvo = PARALELO_PARES_MINIMO;
+
+    size_t capacidade = 64, n = 0;
+    Tarefa* tarefas = (Tarefa*)realocar(NULL, capacidade, sizeof(Tarefa));
+    for (int f = 0; f < 256; f++) {
+        size_t ini = c->inicio[f], fim = c->inicio[f + 1];
+        while (ini + 1 < fim) {
+            // A linha i tem (fim - i - 1) pares; acumula linhas até ao alvo
+            size_t i = ini, pares = 0;
+            while (i + 1 < fim && pares < alvo) {
+                pares += fim - i - 1;
+                i++;
+            }
+            if (n == capacidade) {
+                capacidade *= 2;
+                tarefas = (Tarefa*)realocar(tarefas, capacidade, sizeof(Tarefa));
+            }
+            tarefas[n].i0 = ini;
+            tarefas[n].i1 = i;
+            tarefas[n].fim = fim;
+            n++;
+            ini = i;
+        }
+    }
+    *numTarefas = n;
+    return tarefas;
+}
+
+/**
+ * @brief Número de colunas de efeito a repartir pelas faixas
+ * 
+ * @note Os efeitos no mapa têm x >= 0; sem limite de colunas, o maior x
+ *       possível é 2*max(x) - min(x) das antenas
+ */
+static long long colunasDeEfeito(const AntenaSet* c) {
+    if (c->colunas > 0) return c->colunas;
+    long long minimo = 0, maximo = 0;
+    for (size_t i = 0; i < c->tamanho; i++) {
+        if (i == 0 || c->x[i] < minimo) minimo = c->x[i];
+        if (i == 0 || c->x[i] > maximo) maximo = c->x[i];
+    }
+    long long limite = 2 * maximo - minimo + 1;
+    if (limite > (long long)INT_MAX + 1) limite = (long long)INT_MAX + 1;
+    return limite > 0 ? limite : 1;
+}
+
+AntenaSet* calcularEfeitoNefastoParalelo(const AntenaSet* conjunto, int threads) {
+    if (threads <= 0) threads = numeroProcessadores();
+
+    Partilha partilha;
+    partilha.conjunto = conjunto;
+    partilha.kernel = escolherKernelPara(conjunto->x, conjunto->y, conjunto->tamanho);
+    partilha.tarefas = criarTarefas(conjunto, threads, &partilha.numTarefas);
+    pthread_mutex_init(&partilha.trinco, NULL);
+    if ((size_t)threads > partilha.numTarefas)
+        threads = partilha.numTarefas > 0 ? (int)partilha.numTarefas : 1;
+    partilha.threads = threads;
+
+    long long colunas = colunasDeEfeito(conjunto);
+    partilha.numFaixas = (size_t)threads * PARALELO_FAIXAS_POR_THREAD;
+    if ((long long)partilha.numFaixas > colunas) partilha.numFaixas = (size_t)colunas;
+    partilha.largura = (colunas + (long long)partilha.numFaixas - 1) / (long long)partilha.numFaixas;
+    partilha.fundidos = (Balde*)alocarZeros(partilha.numFaixas, sizeof(Balde));
+
+    Trabalhador* trabalhadores = (Trabalhador*)realocar(NULL, (size_t)threads, sizeof(Trabalhador));
+    pthread_t* ids = (pthread_t*)realocar(NULL, (size_t)threads, sizeof(pthread_t));
+    partilha.trabalhadores = trabalhadores;
+    for (int t = 0; t < threads; t++) {
+        trabalhadores[t].partilha = &partilha;
+        trabalhadores[t].baldes = (Balde*)alocarZeros(partilha.numFaixas, sizeof(Balde));
+        trabalhadores[t].alinhados = 0;
+        trabalhadores[t].emitidos = 0;
+    }
+
+    executarFase(&partilha, trabalhadores, ids, trabalhar);
+
+    // Os contadores das threads só são somados aos globais depois do join
+    for (int t = 0; t < threads; t++) {
+        ESTAT_SOMAR(paresAlinhados, trabalhadores[t].alinhados);
+        ESTAT_SOMAR(verificacoesColisao, 2 * trabalhadores[t].alinhados);
+        ESTAT_SOMAR(efeitosEmitidos, trabalhadores[t].emitidos);
+    }
+    for (int f = 0; f < 256; f++) {
+        unsigned long long k = conjunto->inicio[f + 1] - conjunto->inicio[f];
+        ESTAT_SOMAR(paresComparados, k * (k - 1) / 2);
+    }
+    ESTAT_SOMAR(paresPossiveis, (unsigned long long)conjunto->tamanho * (conjunto->tamanho - 1) / 2);
+
+    executarFase(&partilha, trabalhadores, ids, fundir);
+
+    // As faixas estão por ordem de x, logo a sua concatenação segue a ordem (x,y)
+    size_t total = 0;
+    for (size_t f = 0; f < partilha.numFaixas; f++) total += partilha.fundidos[f].tamanho;
+    AntenaSet* efeitos = criarConjunto(conjunto->linhas, conjunto->colunas, total);
+    for (size_t f = 0; f < partilha.numFaixas; f++) {
+        Balde* b = &partilha.fundidos[f];
+        for (size_t i = 0; i < b->tamanho; i++) {
+            size_t k = efeitos->tamanho++;
+            efeitos->x[k] = xDaChave(b->chaves[i]);
+            efeitos->y[k] = yDaChave(b->chaves[i]);
+            efeitos->frequencia[k] = '#';
+            indiceInserir(efeitos->ocupadas, efeitos->x[k], efeitos->y[k]);
+        }
+        free(b->chaves);
+    }
+    for (int g = (unsigned char)'#' + 1; g <= 256; g++) efeitos->inicio[g] = efeitos->tamanho;
+    ESTAT_SOMAR(efeitosUnicos, efeitos->tamanho);
+
+    for (int t = 0; t < threads; t++) free(trabalhadores[t].baldes);
+    free(partilha.fundidos);
+    free(ids);
+    free(trabalhadores);
+    free(partilha.tarefas);
+    pthread_mutex_destroy(&partilha.trinco);
+    return efeitos;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file regras.c
+ * @brief Compilação das regras de alinhamento e motor de efeitos associado
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include "regras.h"
+ #include "memoria.h"
+ #include "estatisticas.h"
+
+/**
+ * @brief Razões do perfil clássico (ver antenasAlinhadas)
+ */
+static const RacioAlinhamento RACIOS_CLASSICOS[] = {
+    {1, 0}, {0, 1}, {1, 1}, {1, 2}, {2, 1}, {1, 3}, {3, 1}
+};
+
+/**
+ * @brief Máximo divisor comum (algoritmo binário); mdc(a,0) = a
+ */
+static unsigned long long mdc(unsigned long long a, unsigned long long b) {
+    if (a == 0) return b;
+    if (b == 0) return a;
+    int comum = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    do {
+        b >>= __builtin_ctzll(b);
+        if (a > b) { unsigned long long t = a; a = b; b = t; }
+        b -= a;
+    } while (b != 0);
+    return a << comum;
+}
+
+/**
+ * @brief Marca na tabela de razões as razões de um vetor
+ *
+ * @return int 1 se todas as razões são válidas
+ */
+static int marcarRacios(uint8_t racios[REGRAS_RACIO_MAXIMO + 1][REGRAS_RACIO_MAXIMO + 1],
+                        const RacioAlinhamento* lista, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (lista[i].dx < 0 || lista[i].dy < 0) return 0;
+        unsigned long long g = mdc((unsigned long long)lista[i].dx, (unsigned long long)lista[i].dy);
+        if (g == 0) return 0;
+        unsigned long long p = (unsigned long long)lista[i].dx / g;
+        unsigned long long q = (unsigned long long)lista[i].dy / g;
+        if (p > REGRAS_RACIO_MAXIMO || q > REGRAS_RACIO_MAXIMO) return 0;
+        racios[p][q] = 1;
+    }
+    return 1;
+}
+
+int compilarRegras(const RacioAlinhamento* racios, size_t n, int fator, int lados,
+                   RegrasAlinhamento* regras) {
+    memset(regras, 0, sizeof(*regras));
+    if (n == 0 || fator < 1 || fator > REGRAS_FATOR_MAXIMO) return 0;
+    if (lados != REGRAS_LADOS_AMBOS && lados != REGRAS_LADO_UNICO) return 0;
+    if (!marcarRacios(regras->racios, racios, n)) return 0;
+    regras->fator = fator;
+    regras->lados = lados;
+
+    // Tabela direta: cada diferença pequena já normalizada
+    for (unsigned a = 0; a < REGRAS_TABELA; a++) {
+        for (unsigned b = 0; b < REGRAS_TABELA; b++) {
+            unsigned long long g = mdc(a, b);
+            if (g == 0) continue;
+            unsigned long long p = a / g, q = b / g;
+            regras->direta[a][b] = p <= REGRAS_RACIO_MAXIMO && q <= REGRAS_RACIO_MAXIMO &&
+                                   regras->racios[p][q];
+        }
+    }
+
+    uint8_t classicos[REGRAS_RACIO_MAXIMO + 1][REGRAS_RACIO_MAXIMO + 1] = {{0}};
+    marcarRacios(classicos, RACIOS_CLASSICOS, sizeof(RACIOS_CLASSICOS) / sizeof(RACIOS_CLASSICOS[0]));
+    regras->classicas = fator == 1 && lados == REGRAS_LADOS_AMBOS &&
+                        memcmp(classicos, regras->racios, sizeof(classicos)) == 0;
+    return 1;
+}
+
+int lerRegras(const char* perfil, RegrasAlinhamento* regras) {
+    RacioAlinhamento racios[(REGRAS_RACIO_MAXIMO + 1) * (REGRAS_RACIO_MAXIMO + 1)];
+    size_t n = 0;
+    int fator = 1, lados = REGRAS_LADOS_AMBOS;
+    const char* p = perfil;
+
+    while (*p != '\0') {
+        if (*p == ',' || *p == ';' || *p == ' ' || *p == '\t') { p++; continue; }
+        char* fim;
+        if (strncmp(p, "fator=", 6) == 0) {
+            fator = (int)strtol(p + 6, &fim, 10);
+        } else if (strncmp(p, "lados=", 6) == 0) {
+            lados = (int)strtol(p + 6, &fim, 10);
+        } else {
+            long dx = strtol(p, &fim, 10);
+            if (fim == p || *fim != ':') return 0;
+            const char* q = fim + 1;
+            long dy = strtol(q, &fim, 10);
+            if (fim == q || dx < 0 || dy < 0 || dx > 1000000 || dy > 1000000) return 0;
+            if (n == sizeof(racios) / sizeof(racios[0])) return 0;
+            racios[n].dx = (int)dx;
+            racios[n].dy = (int)dy;
+            n++;
+        }
+        if (*fim != '\0' && *fim != ',' && *fim != ';' && *fim != ' ' && *fim != '\t') return 0;
+        p = fim;
+    }
+    return compilarRegras(racios, n, fator, lados, regras);
+}
+
+/**
+ * @brief Teste para diferenças fora da tabela direta (valores absolutos)
+ */
+static int alinhadasLonge(const RegrasAlinhamento* regras, unsigned long long a, unsigned long long b) {
+    unsigned long long g = mdc(a, b);
+    if (g == 0) return 0;
+    a /= g;
+    b /= g;
+    return a <= REGRAS_RACIO_MAXIMO && b <= REGRAS_RACIO_MAXIMO && regras->racios[a][b];
+}
+
+int regrasAlinhadas(const RegrasAlinhamento* regras, long long dx, long long dy) {
+    unsigned long long a = dx < 0 ? 0ULL - (unsigned long long)dx : (unsigned long long)dx;
+    unsigned long long b = dy < 0 ? 0ULL - (unsigned long long)dy : (unsigned long long)dy;
+    if (a < REGRAS_TABELA && b < REGRAS_TABELA) return regras->direta[a][b];
+    return alinhadasLonge(regras, a, b);
+}
+
+/**
+ * @brief Vetor dinâmico de chaves de pontos de efeito
+ */
+typedef struct {
+    uint64_t* dados;    ///< Chaves (ver chaveOrdenada)
+    size_t tamanho;     ///< Número de chaves
+    size_t capacidade;  ///< Capacidade alocada
+} VetorChaves;
+
+/**
+ * @brief Projeta os pontos de efeito de um par alinhado (A antes de B em (x,y))
+ */
+static void projetarPar(const AntenaSet* conjunto, const RegrasAlinhamento* regras,
+                        int xa, int ya, int xb, int yb, VetorChaves* pontos) {
+    const Mapa mapa = {conjunto->linhas, conjunto->colunas};
+    long long dx = ((long long)xb - xa) * regras->fator;
+    long long dy = ((long long)yb - ya) * regras->fator;
+    long long x1 = xa - dx, y1 = ya - dy;
+    long long x2 = xb + dx, y2 = yb + dy;
+    int valido1 = regras->lados == REGRAS_LADOS_AMBOS && coordenadaRepresentavel(x1, y1);
+    int valido2 = coordenadaRepresentavel(x2, y2);
+    if ((valido1 && existeNoIndice(conjunto->ocupadas, (int)x1, (int)y1)) ||
+        (valido2 && existeNoIndice(conjunto->ocupadas, (int)x2, (int)y2)))
+        return;
+
+    if (pontos->tamanho + 2 > pontos->capacidade) {
+        pontos->capacidade = pontos->capacidade ? pontos->capacidade * 2 : 64;
+        pontos->dados = (uint64_t*)realocar(pontos->dados, pontos->capacidade, sizeof(uint64_t));
+    }
+    if (valido1 && pontoNoMapa(&mapa, x1, y1))
+        pontos->dados[pontos->tamanho++] = chaveOrdenada((int)x1, (int)y1);
+    if (valido2 && pontoNoMapa(&mapa, x2, y2))
+        pontos->dados[pontos->tamanho++] = chaveOrdenada((int)x2, (int)y2);
+}
+
+/**
+ * @brief Percorre os pares de um grupo [ini,fim) com o teste de alinhamento indicado
+ *
+ * @details Instanciado duas vezes: só com a tabela direta, quando todas as
+ * diferenças do grupo cabem nela, e com o teste completo. Dentro do grupo
+ * as antenas estão por ordem (x,y), pelo que dx >= 0.
+ */
+ #define REGRAS_PERCORRER_GRUPO(ALINHADOS)                                        \
+    for (size_t i = ini; i < fim; i++) {                                           \
+        for (size_t j = i + 1; j < fim; j++) {                                     \
+            long long dx = (long long)xs[j] - xs[i];                               \
+            long long dy = (long long)ys[j] - ys[i];                               \
+            if (!(ALINHADOS)) continue;                                            \
+            paresAlinhados++;                                                      \
+            projetarPar(conjunto, regras, xs[i], ys[i], xs[j], ys[j], &pontos);    \
+        }                                                                          \
+    }
+
+AntenaSet* calcularEfeitosComRegras(const AntenaSet* conjunto, const RegrasAlinhamento* regras) {
+    if (regras->classicas) return calcularEfeitoNefastoConjunto(conjunto);
+
+    const int *xs = conjunto->x, *ys = conjunto->y;
+    VetorChaves pontos = {NULL, 0, 0};
+    unsigned long long paresAlinhados = 0;
+
+    for (int f = 0; f < 256; f++) {
+        size_t ini = conjunto->inicio[f], fim = conjunto->inicio[f + 1];
+        if (fim - ini < 2) continue;
+        ESTAT_SOMAR(paresComparados, (unsigned long long)(fim - ini) * (fim - ini - 1) / 2);
+
+        int yMin = ys[ini], yMax = ys[ini];
+        for (size_t i = ini + 1; i < fim; i++) {
+            if (ys[i] < yMin) yMin = ys[i];
+            if (ys[i] > yMax) yMax = ys[i];
+        }
+        if ((long long)xs[fim - 1] - xs[ini] < REGRAS_TABELA && (long long)yMax - yMin < REGRAS_TABELA) {
+            REGRAS_PERCORRER_GRUPO(regras->direta[dx][dy < 0 ? -dy : dy])
+        } else {
+            REGRAS_PERCORRER_GRUPO(regrasAlinhadas(regras, dx, dy))
+        }
+    }
+
+    ESTAT_SOMAR(paresPossiveis, (unsigned long long)conjunto->tamanho * (conjunto->tamanho - 1) / 2);
+    ESTAT_SOMAR(paresAlinhados, paresAlinhados);
+    ESTAT_SOMAR(verificacoesColisao, (regras->lados == REGRAS_LADOS_AMBOS ? 2 : 1) * paresAlinhados);
+    ESTAT_SOMAR(efeitosEmitidos, pontos.tamanho);
+
+    // Ordenação e deduplicação; todos os efeitos formam o grupo '#'
+    if (pontos.tamanho > 1) qsort(pontos.dados, pontos.tamanho, sizeof(uint64_t), compararChaves);
+    AntenaSet* efeitos = criarConjunto(conjunto->linhas, conjunto->colunas, pontos.tamanho);
+    for (size_t i = 0; i < pontos.tamanho; i++) {
+        if (i > 0 && pontos.dados[i] == pontos.dados[i - 1]) continue;
+        size_t k = efeitos->tamanho++;
+        efeitos->x[k] = xDaChave(pontos.dados[i]);
+        efeitos->y[k] = yDaChave(pontos.dados[i]);
+        efeitos->frequencia[k] = '#';
+        indiceInserir(efeitos->ocupadas, efeitos->x[k], efeitos->y[k]);
+    }
+    for (int g = (unsigned char)'#' + 1; g <= 256; g++) efeitos->inicio[g] = efeitos->tamanho;
+    ESTAT_SOMAR(efeitosUnicos, efeitos->tamanho);
+    free(pontos.dados);
+    return efeitos;
+}
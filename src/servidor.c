@@ -0,0 +1,574 @@
+/**
+ * @file servidor.c
+ * @brief Implementação do modo servidor e do protocolo de comandos
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <string.h>
+ #include "servidor.h"
+ #include "memoria.h"
+ #include "util.h"
+ #include "estatisticas.h"
+
+ #ifdef _WIN32
+ #include <io.h>
+ #define lerDescritor(fd, buf, n) _read((fd), (buf), (unsigned)(n))
+ #else
+ #include <errno.h>
+ #include <fcntl.h>
+ #include <poll.h>
+ #include <signal.h>
+ #include <time.h>
+ #include <unistd.h>
+ #include <sys/socket.h>
+ #include <sys/stat.h>
+ #include <sys/un.h>
+ #define lerDescritor(fd, buf, n) read((fd), (buf), (n))
+ #endif
+
+Servidor* criarServidor(const char* filename) {
+    Servidor* servidor = (Servidor*)realocar(NULL, 1, sizeof(Servidor));
+    int linhas, colunas;
+    Antena* lista = carregarAntenasDoMapa(filename, &linhas, &colunas);
+    servidor->estado = criarEstadoEfeitos(lista, linhas, colunas);
+    servidor->antenas = lista;
+    servidor->efeitos = estadoListaEfeitos(servidor->estado);
+    servidor->antenasZ = NULL;
+    servidor->efeitosZ = NULL;
+    servidor->atualizado = 1;
+    servidor->mapa.linhas = linhas;
+    servidor->mapa.colunas = colunas;
+    return servidor;
+}
+
+/**
+ * @brief Descarta as listas materializadas após uma alteração
+ */
+static void invalidar(Servidor* servidor) {
+    libertarMorton(servidor->antenasZ);
+    libertarMorton(servidor->efeitosZ);
+    servidor->antenasZ = NULL;
+    servidor->efeitosZ = NULL;
+    if (!servidor->atualizado) return;
+    libertarLista(servidor->antenas);
+    libertarLista(servidor->efeitos);
+    servidor->antenas = NULL;
+    servidor->efeitos = NULL;
+    servidor->atualizado = 0;
+}
+
+/**
+ * @brief Reconstrói as listas, se necessário, antes de uma leitura
+ *
+ * @note Leituras consecutivas partilham as mesmas listas: o custo O(n + m)
+ *       é pago uma vez por alteração e não uma vez por consulta
+ */
+static void materializar(Servidor* servidor) {
+    if (servidor->atualizado) return;
+    servidor->antenas = conjuntoParaLista(servidor->estado->antenas);
+    servidor->efeitos = estadoListaEfeitos(servidor->estado);
+    servidor->atualizado = 1;
+}
+
+void libertarServidor(Servidor* servidor) {
+    if (servidor == NULL) return;
+    invalidar(servidor);
+    libertarEstadoEfeitos(servidor->estado);
+    free(servidor);
+}
+
+/**
+ * @brief Constrói, se necessário, as cópias por ordem Z usadas por JANELA
+ */
+static void materializarMorton(Servidor* servidor) {
+    if (servidor->antenasZ != NULL) return;
+    materializar(servidor);
+    servidor->antenasZ = mortonDeConjunto(servidor->estado->antenas);
+    servidor->efeitosZ = mortonDeLista(servidor->efeitos);
+}
+
+/**
+ * @brief Guarda o estado atual num snapshot binário
+ */
+static int guardarEstado(Servidor* servidor, const char* ficheiro) {
+    materializar(servidor);
+    const AntenaSet* antenas = servidor->estado->antenas;
+    AntenaSet* efeitos = conjuntoDeLista(servidor->efeitos, servidor->mapa.linhas,
+                                         servidor->mapa.colunas);
+    // Os bitmaps só compensam quando o próprio índice já é denso
+    unsigned marcas = antenas->ocupadas->modo == INDICE_BITMAP
+        ? SNAPSHOT_BITMAP_ANTENAS | SNAPSHOT_BITMAP_EFEITOS : 0;
+    int ok = guardarSnapshot(ficheiro, antenas, efeitos, marcas);
+    libertarConjunto(efeitos);
+    return ok;
+}
+
+int executarComando(Servidor* servidor, const char* linha, FILE* saida) {
+    char comando[16], texto[SERVIDOR_LINHA_MAXIMA];
+    char frequencia;
+    int x, y, largura, altura;
+
+    if (sscanf(linha, "%15s", comando) != 1) return 1;  // Linha vazia
+
+    if (strcmp(comando, "INSERIR") == 0) {
+        if (sscanf(linha, "%*s %c %d %d", &frequencia, &x, &y) != 3)
+            fputs("ERRO argumentos\n", saida);
+        else if (frequencia == '#' || frequencia == '.')
+            fputs("ERRO frequencia\n", saida);
+        else if (!pontoNoMapa(&servidor->mapa, x, y))
+            fputs("ERRO fora do mapa\n", saida);
+        else if (!estadoInserirAntena(servidor->estado, frequencia, x, y))
+            fputs("ERRO ocupada\n", saida);
+        else {
+            invalidar(servidor);
+            fputs("OK\n", saida);
+        }
+    } else if (strcmp(comando, "REMOVER") == 0) {
+        if (sscanf(linha, "%*s %d %d", &x, &y) != 2)
+            fputs("ERRO argumentos\n", saida);
+        else if (!estadoRemoverAntena(servidor->estado, x, y))
+            fputs("ERRO inexistente\n", saida);
+        else {
+            invalidar(servidor);
+            fputs("OK\n", saida);
+        }
+    } else if (strcmp(comando, "CONSULTAR") == 0) {
+        if (sscanf(linha, "%*s %d %d", &x, &y) != 2) {
+            fputs("ERRO argumentos\n", saida);
+        } else {
+            const AntenaSet* antenas = servidor->estado->antenas;
+            size_t pos = procurarNoConjunto(antenas, x, y);
+            char c = pos != CONJUNTO_NAO_ENCONTRADO ? antenas->frequencia[pos]
+                   : estadoTemEfeito(servidor->estado, x, y) ? '#' : '.';
+            fprintf(saida, "CELULA %d %d %c\n", x, y, c);
+        }
+    } else if (strcmp(comando, "ANTENAS") == 0) {
+        materializar(servidor);
+        fprintf(saida, "ANTENAS %zu\n", servidor->estado->antenas->tamanho);
+        for (Antena* a = servidor->antenas; a != NULL; a = a->prox)
+            fprintf(saida, "%c %d %d\n", a->frequencia, a->x, a->y);
+    } else if (strcmp(comando, "EFEITOS") == 0) {
+        materializar(servidor);
+        size_t n = 0;
+        for (Antena* e = servidor->efeitos; e != NULL; e = e->prox) n++;
+        fprintf(saida, "EFEITOS %zu\n", n);
+        for (Antena* e = servidor->efeitos; e != NULL; e = e->prox)
+            fprintf(saida, "%d %d\n", e->x, e->y);
+    } else if (strcmp(comando, "JANELA") == 0) {
+        if (sscanf(linha, "%*s %d %d %d %d", &x, &y, &largura, &altura) != 4 ||
+            largura <= 0 || altura <= 0) {
+            fputs("ERRO argumentos\n", saida);
+        } else if ((long long)largura * altura > SERVIDOR_JANELA_MAXIMA) {
+            fputs("ERRO janela demasiado grande\n", saida);
+        } else {
+            materializarMorton(servidor);
+            fprintf(saida, "JANELA %d\n", altura);
+            imprimirJanelaMorton(saida, servidor->antenasZ, servidor->efeitosZ, x, y, largura, altura);
+        }
+    } else if (strcmp(comando, "SNAPSHOT") == 0) {
+        if (sscanf(linha, "%*s %4095s", texto) != 1)
+            fputs("ERRO argumentos\n", saida);
+        else if (!guardarEstado(servidor, texto))
+            fputs("ERRO escrita\n", saida);
+        else
+            fputs("OK\n", saida);
+    } else if (strcmp(comando, "ESTATISTICAS") == 0) {
+        imprimirEstatisticas(saida, 1);
+    } else if (strcmp(comando, "SAIR") == 0) {
+        fputs("OK\n", saida);
+        return 0;
+    } else {
+        fputs("ERRO comando desconhecido\n", saida);
+    }
+    return 1;
+}
+
+/**
+ * @brief Linha de comando em construção entre blocos lidos
+ */
+typedef struct {
+    char linha[SERVIDOR_LINHA_MAXIMA]; ///< Caracteres da linha atual
+    size_t usado;                      ///< Caracteres já guardados
+    int descartar;                     ///< Linha demasiado longa: ignorada até ao próximo '\n'
+} LeitorLinhas;
+
+/**
+ * @brief Executa os comandos completos de um bloco lido
+ *
+ * @param[in] limite Tamanho da saída (ftell) a partir do qual se pára no fim
+ *            do comando atual, para retomar mais tarde (< 0 para não limitar)
+ * @param[out] consumidos Bytes do bloco tratados
+ * @return int 0 se um dos comandos foi SAIR (o resto do bloco é ignorado),
+ *         1 caso contrário
+ */
+static int executarBloco(Servidor* servidor, LeitorLinhas* leitor, const char* bloco,
+                         size_t lidos, FILE* saida, long limite, size_t* consumidos) {
+    size_t i = 0;
+    int continuar = 1;
+    while (i < lidos && continuar) {
+        char c = bloco[i++];
+        if (c != '\n') {
+            if (leitor->usado + 1 < sizeof(leitor->linha)) leitor->linha[leitor->usado++] = c;
+            else leitor->descartar = 1;
+            continue;
+        }
+        size_t usado = leitor->usado;
+        if (usado > 0 && leitor->linha[usado - 1] == '\r') usado--;
+        leitor->linha[usado] = '\0';
+        leitor->usado = 0;
+        if (leitor->descartar) {
+            leitor->descartar = 0;
+            fputs("ERRO linha demasiado longa\n", saida);
+        } else {
+            continuar = executarComando(servidor, leitor->linha, saida);
+        }
+        if (limite >= 0 && ftell(saida) >= limite) break;
+    }
+    *consumidos = i;
+    return continuar;
+}
+
+/**
+ * @brief Executa o último comando, sem '\n', antes do fim de ficheiro
+ *
+ * @return int 0 se esse comando foi SAIR, 1 caso contrário
+ */
+static int terminarLeitor(Servidor* servidor, LeitorLinhas* leitor, FILE* saida) {
+    if (leitor->usado == 0 || leitor->descartar) return 1;
+    leitor->linha[leitor->usado] = '\0';
+    leitor->usado = 0;
+    return executarComando(servidor, leitor->linha, saida);
+}
+
+int servirDescritor(Servidor* servidor, int entrada, FILE* saida) {
+    char bloco[SERVIDOR_LINHA_MAXIMA * 4];
+    LeitorLinhas leitor;
+    leitor.usado = 0;
+    leitor.descartar = 0;
+
+    for (;;) {
+        long lidos = (long)lerDescritor(entrada, bloco, sizeof(bloco));
+        if (lidos <= 0) break;
+        // Todos os comandos completos do bloco são executados antes de esvaziar a saída
+        size_t consumidos;
+        int continuar = executarBloco(servidor, &leitor, bloco, (size_t)lidos, saida, -1, &consumidos);
+        fflush(saida);
+        if (!continuar) return 0;
+    }
+
+    int continuar = terminarLeitor(servidor, &leitor, saida);
+    fflush(saida);
+    return continuar;
+}
+
+ #ifdef _WIN32
+
+int servirSocket(Servidor* servidor, const char* caminho) {
+    (void)servidor;
+    fprintf(stderr, "Erro: Sockets Unix não suportados nesta plataforma (%s)\n", caminho);
+    return 0;
+}
+
+ #else
+
+/**
+ * @brief Ligação de um cliente ao socket
+ */
+typedef struct {
+    int descritor;              ///< Socket do cliente (não bloqueante)
+    LeitorLinhas leitor;        ///< Linha em construção
+    char entrada[SERVIDOR_LINHA_MAXIMA * 4]; ///< Último bloco lido
+    size_t inicio;              ///< Primeiro byte de entrada ainda por tratar
+    size_t fim;                 ///< Fim dos dados em entrada
+    char* pendente;             ///< Respostas ainda por enviar
+    size_t tamanhoPendente;     ///< Bytes em pendente
+    size_t enviados;            ///< Bytes de pendente já enviados
+    long long ultimaAtividade;  ///< Instante (ms) da última leitura ou escrita
+    int fechar;                 ///< 1 após SAIR ou fim de ficheiro: fecha quando tudo for enviado
+} Sessao;
+
+/// Pedido de término recebido por sinal (SIGINT ou SIGTERM)
+static volatile sig_atomic_t terminoPedido = 0;
+
+static void pedirTermino(int sinal) {
+    (void)sinal;
+    terminoPedido = 1;
+}
+
+/**
+ * @brief Instante atual em milissegundos (relógio monótono)
+ */
+static long long agoraMs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Acrescenta as respostas de um lote às que aguardam envio
+ */
+static void acrescentarPendente(Sessao* sessao, char* respostas, size_t tamanho) {
+    if (tamanho == 0) {
+        free(respostas);
+        return;
+    }
+    if (sessao->pendente == NULL) {
+        sessao->pendente = respostas;
+        sessao->tamanhoPendente = tamanho;
+        sessao->enviados = 0;
+        return;
+    }
+    sessao->pendente = (char*)realocar(sessao->pendente, sessao->tamanhoPendente + tamanho, 1);
+    memcpy(sessao->pendente + sessao->tamanhoPendente, respostas, tamanho);
+    sessao->tamanhoPendente += tamanho;
+    free(respostas);
+}
+
+/**
+ * @brief Indica se a sessão pode produzir mais respostas agora
+ */
+static int sessaoAceitaMais(const Sessao* sessao) {
+    return !sessao->fechar && sessao->tamanhoPendente - sessao->enviados < SERVIDOR_PENDENTE_MAXIMO;
+}
+
+/**
+ * @brief Lê o que o cliente já enviou e executa os comandos completos
+ *
+ * @details Trata até SERVIDOR_BLOCOS_POR_LEITURA blocos (ou até não haver
+ * mais dados) e junta as respostas de todos os comandos num só envio. Se as
+ * respostas por enviar chegarem a SERVIDOR_PENDENTE_MAXIMO, o resto do bloco
+ * fica na sessão e só é tratado depois de o cliente as ler.
+ *
+ * @return int 0 se o cliente enviou SAIR, 1 caso contrário
+ */
+static int lerSessao(Servidor* servidor, Sessao* sessao) {
+    char* respostas = NULL;
+    size_t tamanho = 0;
+    FILE* saida = open_memstream(&respostas, &tamanho);
+    if (saida == NULL) {
+        sessao->fechar = 1;
+        return 1;
+    }
+    long limite = (long)(SERVIDOR_PENDENTE_MAXIMO - (sessao->tamanhoPendente - sessao->enviados));
+
+    int continuar = 1;
+    for (int b = 0; b < SERVIDOR_BLOCOS_POR_LEITURA && continuar; b++) {
+        if (sessao->inicio == sessao->fim) {
+            ssize_t lidos = recv(sessao->descritor, sessao->entrada, sizeof(sessao->entrada), 0);
+            if (lidos < 0 && errno == EINTR) continue;
+            if (lidos < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (lidos <= 0) {
+                // Fim de ficheiro ou erro: executa a última linha e fecha
+                if (lidos == 0) continuar = terminarLeitor(servidor, &sessao->leitor, saida);
+                sessao->fechar = 1;
+                break;
+            }
+            sessao->inicio = 0;
+            sessao->fim = (size_t)lidos;
+            sessao->ultimaAtividade = agoraMs();
+        }
+        size_t consumidos;
+        continuar = executarBloco(servidor, &sessao->leitor, sessao->entrada + sessao->inicio,
+                                  sessao->fim - sessao->inicio, saida, limite, &consumidos);
+        sessao->inicio += consumidos;
+        if (ftell(saida) >= limite) break;
+    }
+    if (!continuar) sessao->fechar = 1;
+
+    fclose(saida);
+    acrescentarPendente(sessao, respostas, tamanho);
+    return continuar;
+}
+
+/**
+ * @brief Envia o que o socket aceitar sem bloquear
+ *
+ * @return int 0 se a ligação falhou, 1 caso contrário
+ */
+static int enviarSessao(Sessao* sessao) {
+    while (sessao->enviados < sessao->tamanhoPendente) {
+        ssize_t n = send(sessao->descritor, sessao->pendente + sessao->enviados,
+                         sessao->tamanhoPendente - sessao->enviados, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 1;
+        if (n <= 0) return 0;
+        sessao->enviados += (size_t)n;
+        sessao->ultimaAtividade = agoraMs();
+    }
+    free(sessao->pendente);
+    sessao->pendente = NULL;
+    sessao->tamanhoPendente = 0;
+    sessao->enviados = 0;
+    return 1;
+}
+
+static void fecharSessao(Sessao* sessao) {
+    close(sessao->descritor);
+    free(sessao->pendente);
+    free(sessao);
+}
+
+/**
+ * @brief Aceita as ligações em espera
+ *
+ * @return int -1 se o socket de escuta falhou, 0 se se esgotaram os
+ *         descritores (aceitação suspensa), 1 caso contrário
+ */
+static int aceitarClientes(int escuta, Sessao** sessoes, int* numSessoes) {
+    while (*numSessoes < SERVIDOR_CLIENTES_MAXIMO) {
+        int cliente = accept(escuta, NULL, NULL);
+        if (cliente < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 1;
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                fprintf(stderr, "Aviso: Ligações suspensas durante %d ms (%s)\n",
+                        SERVIDOR_PAUSA_ACEITAR_MS, strerror(errno));
+                return 0;
+            }
+            fprintf(stderr, "Erro: Falha ao aceitar ligações (%s)\n", strerror(errno));
+            return -1;
+        }
+        fcntl(cliente, F_SETFL, fcntl(cliente, F_GETFL) | O_NONBLOCK);
+        Sessao* sessao = (Sessao*)alocarZeros(1, sizeof(Sessao));
+        sessao->descritor = cliente;
+        sessao->ultimaAtividade = agoraMs();
+        sessoes[(*numSessoes)++] = sessao;
+    }
+    return 1;
+}
+
+int servirSocket(Servidor* servidor, const char* caminho) {
+    struct sockaddr_un endereco;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "Erro: Caminho de socket demasiado longo: %s\n", caminho);
+        return 0;
+    }
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    strcpy(endereco.sun_path, caminho);
+
+    // Só um socket antigo pode ser substituído; qualquer outro ficheiro é mantido
+    struct stat info;
+    if (lstat(caminho, &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            fprintf(stderr, "Erro: %s já existe e não é um socket\n", caminho);
+            return 0;
+        }
+        unlink(caminho);
+    }
+
+    int escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (escuta < 0) {
+        fprintf(stderr, "Erro: Não foi possível criar o socket %s\n", caminho);
+        return 0;
+    }
+    if (bind(escuta, (struct sockaddr*)&endereco, sizeof(endereco)) != 0) {
+        fprintf(stderr, "Erro: Não foi possível escutar em %s\n", caminho);
+        close(escuta);
+        return 0;
+    }
+    if (listen(escuta, SERVIDOR_CLIENTES_MAXIMO) != 0) {
+        fprintf(stderr, "Erro: Não foi possível escutar em %s\n", caminho);
+        close(escuta);
+        unlink(caminho);
+        return 0;
+    }
+    fcntl(escuta, F_SETFL, fcntl(escuta, F_GETFL) | O_NONBLOCK);
+
+    // Um cliente que fecha a ligação antes de ler não deve terminar o servidor;
+    // SIGINT e SIGTERM interrompem o poll para o socket ser removido à saída
+    signal(SIGPIPE, SIG_IGN);
+    struct sigaction acao, anteriorInt, anteriorTerm;
+    memset(&acao, 0, sizeof(acao));
+    acao.sa_handler = pedirTermino;
+    sigemptyset(&acao.sa_mask);
+    sigaction(SIGINT, &acao, &anteriorInt);
+    sigaction(SIGTERM, &acao, &anteriorTerm);
+    terminoPedido = 0;
+
+    Sessao* sessoes[SERVIDOR_CLIENTES_MAXIMO];
+    struct pollfd eventos[SERVIDOR_CLIENTES_MAXIMO + 1];
+    int numSessoes = 0, resultado = 1, sair = 0;
+    long long retomarAceitar = 0;
+
+    while (!sair && !terminoPedido) {
+        long long agora = agoraMs();
+        int aceitar = agora >= retomarAceitar && numSessoes < SERVIDOR_CLIENTES_MAXIMO;
+        eventos[0].fd = escuta;
+        eventos[0].events = aceitar ? POLLIN : 0;
+        eventos[0].revents = 0;
+
+        // Espera até ao próximo limite de inatividade ou ao fim da pausa de aceitação
+        long long limite = aceitar ? -1 : retomarAceitar;
+        for (int i = 0; i < numSessoes; i++) {
+            Sessao* sessao = sessoes[i];
+            short pedidos = 0;
+            if (sessao->pendente != NULL) pedidos |= POLLOUT;
+            // Um cliente que não lê as respostas deixa de ser lido
+            if (sessaoAceitaMais(sessao)) {
+                pedidos |= POLLIN;
+                if (sessao->inicio < sessao->fim) limite = agora;  // Resto de um bloco por tratar
+            }
+            eventos[i + 1].fd = sessao->descritor;
+            eventos[i + 1].events = pedidos;
+            eventos[i + 1].revents = 0;
+            long long expira = sessao->ultimaAtividade + SERVIDOR_INATIVIDADE_MS;
+            if (limite < 0 || expira < limite) limite = expira;
+        }
+        int espera = limite < 0 ? -1 : limite <= agora ? 0 : (int)(limite - agora);
+        if (poll(eventos, (nfds_t)numSessoes + 1, espera) < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Erro: Falha ao esperar por ligações (%s)\n", strerror(errno));
+            resultado = 0;
+            break;
+        }
+
+        int vivas = 0;
+        agora = agoraMs();
+        for (int i = 0; i < numSessoes; i++) {
+            Sessao* sessao = sessoes[i];
+            short ocorridos = eventos[i + 1].revents;
+            int ok = 1;
+            int porTratar = sessao->inicio < sessao->fim;
+            if (!sair && sessaoAceitaMais(sessao) && (porTratar || (ocorridos & (POLLIN | POLLHUP | POLLERR))))
+                sair = !lerSessao(servidor, sessao);
+            if (sessao->pendente != NULL) ok = enviarSessao(sessao);
+            if (agora - sessao->ultimaAtividade > SERVIDOR_INATIVIDADE_MS) ok = 0;
+            if (!ok || (sessao->fechar && sessao->pendente == NULL)) fecharSessao(sessao);
+            else sessoes[vivas++] = sessao;
+        }
+        numSessoes = vivas;
+
+        if (!sair && (eventos[0].revents & POLLIN)) {
+            int estado = aceitarClientes(escuta, sessoes, &numSessoes);
+            if (estado < 0) {
+                resultado = 0;
+                break;
+            }
+            if (estado == 0) retomarAceitar = agora + SERVIDOR_PAUSA_ACEITAR_MS;
+        }
+    }
+
+    // As respostas já produzidas (incluindo o OK de SAIR) são enviadas se couberem no socket
+    for (int i = 0; i < numSessoes; i++) {
+        if (sessoes[i]->pendente != NULL) enviarSessao(sessoes[i]);
+        fecharSessao(sessoes[i]);
+    }
+    close(escuta);
+    unlink(caminho);
+    sigaction(SIGINT, &anteriorInt, NULL);
+    sigaction(SIGTERM, &anteriorTerm, NULL);
+    return resultado;
+}
+
+ #endif
@@ -0,0 +1,270 @@
+/**
+ * @file simulacao.c
+ * @brief Implementação da avaliação de candidatos em paralelo
+ *
+ * @author Diogo Pereira
+ * @date 11/04/2025
+ * @version 1.1
+ *
+ * @copyright Copyright (c) 2025
+ *
+ * @course Licenciatura em Engenharia de Sistemas Informáticos
+ * @institution EST-IPCA
+ */
+
+ #include <stdio.h>
+ #include <stdlib.h>
+ #include <stdint.h>
+ #include <pthread.h>
+ #include "simulacao.h"
+ #include "memoria.h"
+ #include "paralelo.h"
+
+/**
+ * @brief Variação da contagem de uma célula, com chave ordenável por (x,y)
+ */
+typedef struct {
+    uint64_t chave; ///< (x,y) com o bit de sinal invertido, para ordenar como inteiros
+    int delta;      ///< Soma das variações da célula
+} Variacao;
+
+/**
+ * @brief Vetor de variações reutilizado entre candidatos da mesma thread
+ */
+typedef struct {
+    Variacao* dados;   ///< Elementos
+    size_t tamanho;    ///< Elementos usados
+    size_t capacidade; ///< Elementos reservados
+} Variacoes;
+
+/**
+ * @brief Dados partilhados entre as threads
+ */
+typedef struct {
+    const EstadoEfeitos* estado;     ///< Estado (só leitura)
+    const Candidato* candidatos;     ///< Candidatos a avaliar
+    ResultadoCandidato* resultados;  ///< Resultados, um por candidato
+    size_t n;                        ///< Número de candidatos
+    size_t proximo;                  ///< Primeiro candidato ainda não atribuído
+    int raios;                       ///< 1 para procurar os pares anulados por raios
+    pthread_mutex_t trinco;          ///< Protege o campo proximo
+} PartilhaSimulacao;
+
+/**
+ * @brief Compara duas variações pela chave
+ */
+static int compararVariacoes(const void* a, const void* b) {
+    uint64_t p = ((const Variacao*)a)->chave, q = ((const Variacao*)b)->chave;
+    return (p > q) - (p < q);
+}
+
+/**
+ * @brief Regista uma variação numa célula, se pertencer ao mapa
+ */
+static void variar(Variacoes* v, const Mapa* mapa, long long x, long long y, int delta) {
+    if (!pontoNoMapa(mapa, x, y)) return;
+    if (v->tamanho == v->capacidade) {
+        v->capacidade = v->capacidade ? v->capacidade * 2 : 64;
+        v->dados = (Variacao*)realocar(v->dados, v->capacidade, sizeof(Variacao));
+    }
+    v->dados[v->tamanho].chave = chaveOrdenada((int)x, (int)y);
+    v->dados[v->tamanho].delta = delta;
+    v->tamanho++;
+}
+
+/**
+ * @brief Verifica se um ponto calculado em 64 bits está ocupado por uma antena
+ */
+static int ocupado(const AntenaSet* c, long long x, long long y) {
+    return coordenadaRepresentavel(x, y) && existeNoConjunto(c, (int)x, (int)y);
+}
+
+/**
+ * @brief Acrescenta uma coordenada a um vetor de resultado
+ */
+static void acrescentar(Coordenada** v, size_t* n, uint64_t chave) {
+    // Crescimento em potências de dois a partir de 4
+    if (*n >= 4 && (*n & (*n - 1)) == 0) *v = (Coordenada*)realocar(*v, *n * 2, sizeof(Coordenada));
+    else if (*n == 0) *v = (Coordenada*)realocar(NULL, 4, sizeof(Coordenada));
+    (*v)[*n].x = xDaChave(chave);
+    (*v)[*n].y = yDaChave(chave);
+    (*n)++;
+}
+
+/**
+ * @brief Anula o par (B,C) com ponto de efeito em P, se for válido
+ *
+ * @details C = 2B - P tem de ser uma antena do grupo de B, o par tem de
+ * estar alinhado e o outro ponto Q = C + (C - B) tem de estar livre.
+ */
+static void anularPar(const AntenaSet* c, const Mapa* mapa, int px, int py,
+                      size_t b, Variacoes* v) {
+    long long cx = 2LL * c->x[b] - px, cy = 2LL * c->y[b] - py;
+    if (!ocupado(c, cx, cy)) return;
+    if (procurarNoGrupo(c, c->frequencia[b], (int)cx, (int)cy) == CONJUNTO_NAO_ENCONTRADO) return;
+
+    long long dx = cx - c->x[b], dy = cy - c->y[b];
+    if (!antenasAlinhadas(dx, dy)) return;
+    if (ocupado(c, cx + dx, cy + dy)) return;
+    variar(v, mapa, px, py, -1);
+    variar(v, mapa, cx + dx, cy + dy, -1);
+}
+
+/**
+ * @brief Procura os pares anulados percorrendo todas as antenas: O(n)
+ */
+static void anularPorVarrimento(const EstadoEfeitos* estado, const Mapa* mapa,
+                                int px, int py, Variacoes* v) {
+    const AntenaSet* c = estado->antenas;
+    for (size_t i = 0; i < c->tamanho; i++) anularPar(c, mapa, px, py, i, v);
+}
+
+/**
+ * @brief Procura os pares anulados ao longo das 24 direções a partir de P
+ *
+ * @details B = P + t·u para cada direção u; como C = P + 2t·u também é uma
+ * antena do mapa, basta avançar enquanto C estiver dentro do mapa:
+ * O(lado do mapa) consultas, independentemente do número de antenas.
+ */
+static void anularPorRaios(const EstadoEfeitos* estado, const Mapa* mapa,
+                           int px, int py, Variacoes* v) {
+    const AntenaSet* c = estado->antenas;
+    for (int d = 0; d < 24; d++) {
+        long long ux = DIRECOES_ALINHAMENTO[d][0], uy = DIRECOES_ALINHAMENTO[d][1];
+        for (long long t = 1; pontoNoMapa(mapa, px + 2 * t * ux, py + 2 * t * uy); t++) {
+            int bx = (int)(px + t * ux), by = (int)(py + t * uy);
+            if (!existeNoConjunto(c, bx, by)) continue;
+            anularPar(c, mapa, px, py, procurarNoConjunto(c, bx, by), v);
+        }
+    }
+}
+
+/**
+ * @brief Escolhe entre os raios e o varrimento das antenas
+ *
+ * @note Os raios exigem um mapa limitado com todas as antenas dentro dele
+ *       e compensam quando 24 raios de meio lado custam menos que n
+ */
+static int usarRaios(const EstadoEfeitos* estado) {
+    if (estado->linhas <= 0 || estado->colunas <= 0 || estado->foraDoMapa > 0) return 0;
+    size_t lado = (size_t)(estado->linhas > estado->colunas ? estado->linhas : estado->colunas);
+    return 12 * lado < estado->antenas->tamanho;
+}
+
+/**
+ * @brief Avalia um candidato, acumulando em v as variações das contagens
+ *
+ * @details Replica estadoInserirAntena sem escrever no estado: anula os
+ * pares que têm a célula como ponto de efeito e soma os pares novos do
+ * grupo de frequência; as variações da mesma célula são depois somadas e
+ * comparadas com a contagem atual.
+ */
+static void avaliarCandidato(const EstadoEfeitos* estado, const Candidato* cand, int raios,
+                             Variacoes* v, ResultadoCandidato* r) {
+    const AntenaSet* c = estado->antenas;
+    const Mapa mapa = {estado->linhas, estado->colunas};
+    const int px = cand->x, py = cand->y;
+
+    r->valido = 0;
+    r->numAdicionados = r->numRemovidos = 0;
+    r->adicionados = r->removidos = NULL;
+    if (cand->frequencia == '#' || cand->frequencia == '.') return;
+    if (!pontoNoMapa(&mapa, px, py) || existeNoConjunto(c, px, py)) return;
+    r->valido = 1;
+    v->tamanho = 0;
+
+    // Pares anulados: só se a célula é hoje um efeito de algum par válido
+    if (contagemValor(estado->efeitos, px, py) > 0) {
+        if (raios) anularPorRaios(estado, &mapa, px, py, v);
+        else anularPorVarrimento(estado, &mapa, px, py, v);
+    }
+
+    // Pares novos com o grupo de frequência do candidato
+    int f = (unsigned char)cand->frequencia;
+    for (size_t i = c->inicio[f]; i < c->inicio[f + 1]; i++) {
+        long long dx = (long long)c->x[i] - px, dy = (long long)c->y[i] - py;
+        if (!antenasAlinhadas(dx, dy)) continue;
+        long long x1 = px - dx, y1 = py - dy;
+        long long x2 = c->x[i] + dx, y2 = c->y[i] + dy;
+        if (ocupado(c, x1, y1) || ocupado(c, x2, y2)) continue;
+        variar(v, &mapa, x1, y1, 1);
+        variar(v, &mapa, x2, y2, 1);
+    }
+
+    // Soma por célula e classificação face à contagem atual
+    if (v->tamanho > 1) qsort(v->dados, v->tamanho, sizeof(Variacao), compararVariacoes);
+    for (size_t i = 0; i < v->tamanho; ) {
+        uint64_t chave = v->dados[i].chave;
+        long long delta = 0;
+        for (; i < v->tamanho && v->dados[i].chave == chave; i++) delta += v->dados[i].delta;
+        if (delta == 0) continue;
+
+        int x = xDaChave(chave);
+        int y = yDaChave(chave);
+        long long antes = contagemValor(estado->efeitos, x, y);
+        if (antes == 0 && delta > 0) acrescentar(&r->adicionados, &r->numAdicionados, chave);
+        else if (antes > 0 && antes + delta == 0) acrescentar(&r->removidos, &r->numRemovidos, chave);
+    }
+}
+
+/**
+ * @brief Ciclo de cada thread: retira blocos de candidatos até se esgotarem
+ */
+static void* trabalharSimulacao(void* arg) {
+    PartilhaSimulacao* p = (PartilhaSimulacao*)arg;
+    Variacoes v = {NULL, 0, 0};
+    for (;;) {
+        pthread_mutex_lock(&p->trinco);
+        size_t inicio = p->proximo;
+        p->proximo += SIMULACAO_BLOCO;
+        pthread_mutex_unlock(&p->trinco);
+        if (inicio >= p->n) break;
+
+        size_t fim = inicio + SIMULACAO_BLOCO < p->n ? inicio + SIMULACAO_BLOCO : p->n;
+        for (size_t k = inicio; k < fim; k++)
+            avaliarCandidato(p->estado, &p->candidatos[k], p->raios, &v, &p->resultados[k]);
+    }
+    free(v.dados);
+    return NULL;
+}
+
+ResultadoCandidato* avaliarCandidatos(const EstadoEfeitos* estado, const Candidato* candidatos,
+                                      size_t n, int threads) {
+    ResultadoCandidato* resultados = (ResultadoCandidato*)realocar(NULL, n, sizeof(ResultadoCandidato));
+    if (threads <= 0) threads = numeroProcessadores();
+    size_t blocos = (n + SIMULACAO_BLOCO - 1) / SIMULACAO_BLOCO;
+    if ((size_t)threads > blocos) threads = blocos > 0 ? (int)blocos : 1;
+
+    PartilhaSimulacao partilha;
+    partilha.estado = estado;
+    partilha.candidatos = candidatos;
+    partilha.resultados = resultados;
+    partilha.n = n;
+    partilha.proximo = 0;
+    partilha.raios = usarRaios(estado);
+    pthread_mutex_init(&partilha.trinco, NULL);
+
+    // A thread principal também trabalha
+    pthread_t* ids = (pthread_t*)realocar(NULL, (size_t)threads, sizeof(pthread_t));
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&ids[t], NULL, trabalharSimulacao, &partilha) != 0) {
+            fprintf(stderr, "Erro: Não foi possível criar a thread %d\n", t);
+            exit(EXIT_FAILURE);
+        }
+    }
+    trabalharSimulacao(&partilha);
+    for (int t = 1; t < threads; t++) pthread_join(ids[t], NULL);
+
+    free(ids);
+    pthread_mutex_destroy(&partilha.trinco);
+    return resultados;
+}
+
+void libertarResultados(ResultadoCandidato* resultados, size_t n) {
+    if (resultados == NULL) return;
+    for (size_t i = 0; i < n; i++) {
+        free(resultados[i].adicionados);
+        free(resultados[i].removidos);
+    }
+    free(resultados);
+}
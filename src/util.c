@@ -19,9 +19,179 @@
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
+ #include <limits.h>
+ #include <stdint.h>
  #include "util.h"
+ #include "memoria.h"
  #include "funcoes.h"
+ #include "indice.h"
+ #include "mapeamento.h"
+
+ #ifdef __SSE2__
+ #include <emmintrin.h>
+ #endif
  
+ /**
+ * @brief Células não vazias de um mapa, pela ordem de leitura (linha a linha)
+ */
+typedef struct {
+    char* frequencia;  ///< Carácter de cada célula
+    int* x;            ///< Coluna de cada célula (0-based)
+    int* y;            ///< Linha de cada célula (0-based)
+    size_t tamanho;    ///< Número de células
+    size_t capacidade; ///< Capacidade alocada
+} Celulas;
+
+/**
+ * @brief Acrescenta uma célula, crescendo os vetores geometricamente
+ */
+static void acrescentarCelula(Celulas* c, char frequencia, int x, int y) {
+    if (c->tamanho == c->capacidade) {
+        c->capacidade = c->capacidade ? c->capacidade * 2 : 256;
+        c->frequencia = (char*)realocar(c->frequencia, c->capacidade, sizeof(char));
+        c->x = (int*)realocar(c->x, c->capacidade, sizeof(int));
+        c->y = (int*)realocar(c->y, c->capacidade, sizeof(int));
+    }
+    c->frequencia[c->tamanho] = frequencia;
+    c->x[c->tamanho] = x;
+    c->y[c->tamanho] = y;
+    c->tamanho++;
+}
+
+/**
+ * @brief Liberta os vetores de células
+ */
+static void libertarCelulas(Celulas* c) {
+    free(c->frequencia);
+    free(c->x);
+    free(c->y);
+}
+
+/**
+ * @brief Indica se o carácter é um separador (mesmo critério que "%s" no fscanf)
+ */
+static int separador(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Devolve o primeiro byte diferente de '.' em [p, fim)
+ * 
+ * @note Com SSE2 compara 16 bytes de cada vez
+ */
+static const char* saltarVazios(const char* p, const char* fim) {
+ #ifdef __SSE2__
+    const __m128i ponto = _mm_set1_epi8('.');
+    while (fim - p >= 16) {
+        __m128i bloco = _mm_loadu_si128((const __m128i*)p);
+        unsigned outros = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(bloco, ponto)) & 0xFFFFu;
+        if (outros) return p + __builtin_ctz(outros);
+        p += 16;
+    }
+ #endif
+    while (p < fim && *p == '.') p++;
+    return p;
+}
+
+/**
+ * @brief Lê um inteiro decimal a partir de p, ignorando separadores iniciais
+ * 
+ * @return int 1 se foi lido um inteiro, 0 caso contrário
+ */
+static int lerInteiro(const char** p, const char* fim, int* valor) {
+    const char* q = *p;
+    while (q < fim && separador(*q)) q++;
+    int negativo = 0;
+    if (q < fim && (*q == '-' || *q == '+')) negativo = (*q++ == '-');
+    if (q >= fim || *q < '0' || *q > '9') return 0;
+
+    long long v = 0;
+    while (q < fim && *q >= '0' && *q <= '9') {
+        if (v <= INT_MAX) v = v * 10 + (*q - '0');
+        q++;
+    }
+    if (v > INT_MAX) v = INT_MAX;
+    *valor = (int)(negativo ? -v : v);
+    *p = q;
+    return 1;
+}
+
+/**
+ * @brief Lê as dimensões e as células não vazias de um ficheiro de mapa
+ * 
+ * @param[in] filename Nome do ficheiro de entrada
+ * @param[out] linhas Número de linhas do mapa
+ * @param[out] colunas Número de colunas do mapa
+ * @param[out] celulas Células lidas, ordenadas por (y,x)
+ * @return int 1 em caso de sucesso, 0 se o ficheiro não abre ou o cabeçalho
+ *         é inválido (a mensagem de erro já foi escrita)
+ * 
+ * @details O ficheiro é mapeado em memória e percorrido uma única vez; as
+ * células são criadas diretamente a partir dos bytes mapeados, sem limite
+ * de largura das linhas.
+ */
+static int lerCelulas(const char* filename, int* linhas, int* colunas, Celulas* celulas) {
+    FicheiroMapeado ficheiro;
+    if (!mapearFicheiro(filename, &ficheiro)) {
+        fprintf(stderr, "Erro: Não foi possível abrir o ficheiro %s\n", filename);
+        return 0;
+    }
+
+    const char* p = ficheiro.dados;
+    const char* fim = ficheiro.dados + ficheiro.tamanho;
+
+    /* Leitura das dimensões do mapa */
+    if (!lerInteiro(&p, fim, linhas) || !lerInteiro(&p, fim, colunas) ||
+        *linhas < 0 || *colunas < 0) {
+        desmapearFicheiro(&ficheiro);
+        fprintf(stderr, "Erro: Formato inválido no ficheiro %s\n", filename);
+        return 0;
+    }
+
+    /* Processamento linha a linha */
+    for (int y = 0; y < *linhas; y++) {
+        while (p < fim && separador(*p)) p++;
+        if (p >= fim) break;
+
+        const char* linha = p;
+        for (;;) {
+            p = saltarVazios(p, fim);
+            if (p >= fim || separador(*p)) break;
+            if (p - linha < *colunas) {
+                acrescentarCelula(celulas, *p, (int)(p - linha), y);
+            }
+            p++;
+        }
+    }
+    
+    desmapearFicheiro(&ficheiro);
+    return 1;
+}
+
+/**
+ * @brief Ordena as células por (x,y) com um counting sort estável por coluna
+ * 
+ * @param[in] celulas Células pela ordem de leitura (y,x)
+ * @return size_t* Permutação: ordem[k] é a k-ésima célula por (x,y)
+ * 
+ * @note Os baldes vão só até à maior coluna ocupada, e não até ao número
+ *       de colunas do cabeçalho, que pode chegar a 2^31 num mapa esparso
+ * @note Complexidade: O(n + maior coluna ocupada)
+ */
+static size_t* ordenarPorColuna(const Celulas* celulas) {
+    size_t baldes = 0;
+    for (size_t k = 0; k < celulas->tamanho; k++)
+        if ((size_t)celulas->x[k] + 1 > baldes) baldes = (size_t)celulas->x[k] + 1;
+
+    size_t* inicio = (size_t*)alocarZeros(baldes + 1, sizeof(size_t));
+    size_t* ordem = (size_t*)realocar(NULL, celulas->tamanho, sizeof(size_t));
+    for (size_t k = 0; k < celulas->tamanho; k++) inicio[celulas->x[k] + 1]++;
+    for (size_t x = 0; x < baldes; x++) inicio[x + 1] += inicio[x];
+    for (size_t k = 0; k < celulas->tamanho; k++) ordem[inicio[celulas->x[k]]++] = k;
+    free(inicio);
+    return ordem;
+}
+
  /**
  * @brief Implementação do carregamento de mapas
  * 
@@ -35,39 +205,285 @@
  *       Linhas seguintes: linhas do mapa
  * 
  * @note Caracteres '.' são considerados espaços vazios
+ * @note As células são recolhidas numa passagem, ordenadas por (x,y) com
+ *       counting sort e ligadas de uma só vez: O(tamanho do ficheiro)
  */
 Antena* carregarAntenasDoMapa(const char* filename, int* linhas, int* colunas) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
+    Celulas celulas = {NULL, NULL, NULL, 0, 0};
+    if (!lerCelulas(filename, linhas, colunas, &celulas)) exit(EXIT_FAILURE);
+
+    size_t* ordem = ordenarPorColuna(&celulas);
+    Antena* lista = NULL;
+    for (size_t k = celulas.tamanho; k-- > 0; ) {
+        size_t c = ordem[k];
+        Antena* nova = criarAntena(celulas.frequencia[c], celulas.x[c], celulas.y[c]);
+        nova->prox = lista;
+        lista = nova;
+    }
+
+    free(ordem);
+    libertarCelulas(&celulas);
+    return lista;
+}
+
+/**
+ * @brief Implementação do carregamento direto para um AntenaSet, sem terminar o programa
+ * 
+ * @param[in] filename Nome do ficheiro de entrada
+ * @param[out] linhas Apontador para armazenar número de linhas
+ * @param[out] colunas Apontador para armazenar número de colunas
+ * @return AntenaSet* Conjunto de antenas carregadas, ou NULL se o ficheiro
+ *         não abre ou tem um cabeçalho inválido
+ * 
+ * @note Dois counting sorts estáveis (coluna, depois frequência) deixam as
+ *       células pela ordem (frequência, x, y) sem passar pela lista
+ */
+AntenaSet* tentarCarregarConjuntoDoMapa(const char* filename, int* linhas, int* colunas) {
+    Celulas celulas = {NULL, NULL, NULL, 0, 0};
+    if (!lerCelulas(filename, linhas, colunas, &celulas)) {
+        libertarCelulas(&celulas);
+        return NULL;
+    }
+
+    size_t* ordem = ordenarPorColuna(&celulas);
+    AntenaSet* conjunto = criarConjunto(*linhas, *colunas, celulas.tamanho);
+
+    size_t pos[257] = {0};
+    for (size_t k = 0; k < celulas.tamanho; k++) pos[(unsigned char)celulas.frequencia[k] + 1]++;
+    for (int f = 0; f < 256; f++) pos[f + 1] += pos[f];
+    memcpy(conjunto->inicio, pos, sizeof(pos));
+
+    for (size_t k = 0; k < celulas.tamanho; k++) {
+        size_t c = ordem[k];
+        size_t destino = pos[(unsigned char)celulas.frequencia[c]]++;
+        conjunto->x[destino] = celulas.x[c];
+        conjunto->y[destino] = celulas.y[c];
+        conjunto->frequencia[destino] = celulas.frequencia[c];
+        indiceInserir(conjunto->ocupadas, celulas.x[c], celulas.y[c]);
+    }
+    conjunto->tamanho = celulas.tamanho;
+
+    free(ordem);
+    libertarCelulas(&celulas);
+    return conjunto;
+}
+
+/**
+ * @brief Implementação do carregamento direto para um AntenaSet
+ * 
+ * @param[in] filename Nome do ficheiro de entrada
+ * @param[out] linhas Apontador para armazenar número de linhas
+ * @param[out] colunas Apontador para armazenar número de colunas
+ * @return AntenaSet* Conjunto de antenas carregadas
+ */
+AntenaSet* carregarConjuntoDoMapa(const char* filename, int* linhas, int* colunas) {
+    AntenaSet* conjunto = tentarCarregarConjuntoDoMapa(filename, linhas, colunas);
+    if (conjunto == NULL) exit(EXIT_FAILURE);
+    return conjunto;
+}
+
+/**
+ * @brief Cabeçalho do formato de texto comprimido por linhas
+ */
+ #define ESPARSO_MAGIA "EDARLE"
+
+/**
+ * @brief Lê o carácter seguinte que não seja separador
+ * 
+ * @return int 1 se foi lido um carácter, 0 no fim do ficheiro
+ */
+static int lerCarac(const char** p, const char* fim, char* carac) {
+    const char* q = *p;
+    while (q < fim && separador(*q)) q++;
+    if (q >= fim) return 0;
+    *carac = *q;
+    *p = q + 1;
+    return 1;
+}
+
+/**
+ * @brief Lê as células de um ficheiro no formato comprimido por linhas
+ * 
+ * @param[in] p Posição seguinte à marca ESPARSO_MAGIA
+ * @param[in] fim Fim do ficheiro mapeado
+ * @param[out] linhas Número de linhas do mapa
+ * @param[out] colunas Número de colunas do mapa
+ * @param[out] celulas Células lidas, ordenadas por (y,x)
+ * @return int 1 se o conteúdo é válido, 0 caso contrário
+ */
+static int lerCelulasComprimidas(const char* p, const char* fim, int* linhas, int* colunas,
+                                 Celulas* celulas) {
+    if (!lerInteiro(&p, fim, linhas) || !lerInteiro(&p, fim, colunas) ||
+        *linhas < 0 || *colunas < 0) return 0;
+
+    long long anterior = -1;
+    int y;
+    while (lerInteiro(&p, fim, &y)) {
+        int n;
+        if (y <= anterior || y >= *linhas || !lerInteiro(&p, fim, &n) || n <= 0) return 0;
+        long long x = -1;
+        for (int k = 0; k < n; k++) {
+            int salto;
+            char carac;
+            if (!lerInteiro(&p, fim, &salto) || salto < 0 || !lerCarac(&p, fim, &carac) ||
+                carac == '.') return 0;
+            x += (long long)salto + 1;
+            if (x >= *colunas) return 0;
+            acrescentarCelula(celulas, carac, (int)x, y);
+        }
+        anterior = y;
+    }
+    while (p < fim && separador(*p)) p++;
+    return p == fim;
+}
+
+/**
+ * @brief Implementação do carregamento para a representação comprimida por linhas
+ * 
+ * @param[in] filename Nome do ficheiro de entrada (mapa de texto ou ESPARSO_MAGIA)
+ * @param[out] linhas Apontador para armazenar número de linhas
+ * @param[out] colunas Apontador para armazenar número de colunas
+ * @return MapaEsparso* Mapa com as células ocupadas
+ * 
+ * @note As células já saem da leitura por (y,x); os vetores de colunas e
+ *       de caracteres passam diretamente para o mapa, sem cópia
+ */
+MapaEsparso* carregarEsparsoDoMapa(const char* filename, int* linhas, int* colunas) {
+    Celulas celulas = {NULL, NULL, NULL, 0, 0};
+    FicheiroMapeado ficheiro;
+    if (!mapearFicheiro(filename, &ficheiro)) {
         fprintf(stderr, "Erro: Não foi possível abrir o ficheiro %s\n", filename);
         exit(EXIT_FAILURE);
     }
-
-    /* Leitura das dimensões do mapa */
-    if (fscanf(file, "%d %d", linhas, colunas) != 2) {
-        fclose(file);
+    size_t marca = strlen(ESPARSO_MAGIA);
+    int comprimido = ficheiro.tamanho >= marca && memcmp(ficheiro.dados, ESPARSO_MAGIA, marca) == 0;
+    if (comprimido && !lerCelulasComprimidas(ficheiro.dados + marca, ficheiro.dados + ficheiro.tamanho,
+                                             linhas, colunas, &celulas)) {
+        desmapearFicheiro(&ficheiro);
         fprintf(stderr, "Erro: Formato inválido no ficheiro %s\n", filename);
         exit(EXIT_FAILURE);
     }
+    desmapearFicheiro(&ficheiro);
+    if (!comprimido && !lerCelulas(filename, linhas, colunas, &celulas)) exit(EXIT_FAILURE);
 
-    Antena* lista = NULL;
-    char linha[256];
-    int y = 0;
-    
-    /* Processamento linha a linha */
-    while (fscanf(file, "%s", linha) == 1 && y < *linhas) {
-        for (int x = 0; x < *colunas && x < (int)strlen(linha); x++) {
-            if (linha[x] != '.') {
-                lista = inserirAntena(lista, linha[x], x, y);
-            }
+    size_t n = celulas.tamanho;
+    MapaEsparso* mapa = esparsoOrdenado(*linhas, *colunas,
+                                        (int*)realocar(celulas.x, n, sizeof(int)),
+                                        (char*)realocar(celulas.frequencia, n, sizeof(char)),
+                                        celulas.y, n);
+    free(celulas.y);
+    return mapa;
+}
+
+/**
+ * @brief Implementação da exportação no formato comprimido por linhas
+ * 
+ * @param[in] filename Nome do ficheiro a escrever
+ * @param[in] mapa Mapa a exportar
+ * @return int 1 em caso de sucesso, 0 em caso de erro
+ */
+int guardarMapaEsparso(const char* filename, const MapaEsparso* mapa) {
+    FILE* f = fopen(filename, "w");
+    if (!f) {
+        fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", filename);
+        return 0;
+    }
+
+    int ok = fprintf(f, "%s %d %d\n", ESPARSO_MAGIA, mapa->linhas, mapa->colunas) > 0;
+    for (size_t r = 0; ok && r < mapa->numLinhas; r++) {
+        size_t inicio = mapa->inicio[r], fim = mapa->inicio[r + 1];
+        ok = fprintf(f, "%d %zu", mapa->linha[r], fim - inicio) > 0;
+        long long x = -1;
+        for (size_t k = inicio; ok && k < fim; k++) {
+            ok = fprintf(f, " %lld %c", (long long)mapa->coluna[k] - x - 1, mapa->carac[k]) > 0;
+            x = mapa->coluna[k];
         }
-        y++;
+        if (ok) ok = fputc('\n', f) != EOF;
     }
-    
-    fclose(file);
-    return lista;
+
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) fprintf(stderr, "Erro: Falha ao escrever o ficheiro %s\n", filename);
+    return ok;
 }
  
+/**
+ * @brief Pontos de uma lista dentro de uma janela, agrupados por linha de saída
+ */
+typedef struct {
+    int* coluna;      ///< Coluna de saída de cada ponto
+    char* carac;      ///< Carácter a desenhar
+    size_t* inicio;   ///< Pontos da linha r em [inicio[r], inicio[r+1])
+} Pinceis;
+
+/**
+ * @brief Agrupa por linha de saída os pontos da lista dentro da janela
+ * 
+ * @note Counting sort pela linha: O(n + altura)
+ */
+static void agruparPorLinha(Antena* lista, int x0, int y0, int largura, int altura,
+                            int fator, int alturaSaida, Pinceis* p) {
+    p->inicio = (size_t*)alocarZeros((size_t)alturaSaida + 1, sizeof(size_t));
+
+    size_t total = 0;
+    for (Antena* a = lista; a != NULL; a = a->prox) {
+        if (a->x < x0 || a->y < y0 || a->x - x0 >= largura || a->y - y0 >= altura) continue;
+        p->inicio[(a->y - y0) / fator + 1]++;
+        total++;
+    }
+    for (int r = 0; r < alturaSaida; r++) p->inicio[r + 1] += p->inicio[r];
+
+    p->coluna = (int*)realocar(NULL, total, sizeof(int));
+    p->carac = (char*)realocar(NULL, total, sizeof(char));
+    size_t* pos = (size_t*)realocar(NULL, (size_t)alturaSaida, sizeof(size_t));
+    memcpy(pos, p->inicio, (size_t)alturaSaida * sizeof(size_t));
+    for (Antena* a = lista; a != NULL; a = a->prox) {
+        if (a->x < x0 || a->y < y0 || a->x - x0 >= largura || a->y - y0 >= altura) continue;
+        size_t k = pos[(a->y - y0) / fator]++;
+        p->coluna[k] = (a->x - x0) / fator;
+        p->carac[k] = a->frequencia;
+    }
+    free(pos);
+}
+
+/**
+ * @brief Liberta os vetores de um Pinceis
+ */
+static void libertarPinceis(Pinceis* p) {
+    free(p->coluna);
+    free(p->carac);
+    free(p->inicio);
+}
+
+/**
+ * @brief Desenha uma janela do mapa, uma linha de saída de cada vez
+ * 
+ * @details Cada linha é preenchida num buffer (efeitos primeiro, antenas por
+ * cima) e escrita com um único fwrite. Com fator > 1, cada carácter
+ * representa um bloco fator x fator de células.
+ */
+static void desenhar(FILE* saida, Antena* antenas, Antena* efeitos,
+                     int x0, int y0, int largura, int altura, int fator) {
+    int larguraSaida = (int)(((long long)largura + fator - 1) / fator);
+    int alturaSaida = (int)(((long long)altura + fator - 1) / fator);
+
+    Pinceis pa, pe;
+    agruparPorLinha(antenas, x0, y0, largura, altura, fator, alturaSaida, &pa);
+    agruparPorLinha(efeitos, x0, y0, largura, altura, fator, alturaSaida, &pe);
+
+    char* linha = (char*)realocar(NULL, (size_t)larguraSaida + 1, sizeof(char));
+    linha[larguraSaida] = '\n';
+    for (int r = 0; r < alturaSaida; r++) {
+        memset(linha, '.', (size_t)larguraSaida);
+        for (size_t k = pe.inicio[r]; k < pe.inicio[r + 1]; k++) linha[pe.coluna[k]] = '#';
+        for (size_t k = pa.inicio[r]; k < pa.inicio[r + 1]; k++) linha[pa.coluna[k]] = pa.carac[k];
+        fwrite(linha, 1, (size_t)larguraSaida + 1, saida);
+    }
+
+    free(linha);
+    libertarPinceis(&pa);
+    libertarPinceis(&pe);
+}
+
 /**
  * @brief Implementação da renderização do mapa
  * 
@@ -80,6 +496,7 @@ Antena* carregarAntenasDoMapa(const char* filename, int* linhas, int* colunas) {
  *       1. Antenas normais
  *       2. Zonas de interferência
  *       3. Espaços vazios ('.')
+ * @note Complexidade: O(n + m + linhas*colunas), com uma escrita por linha
  */
 void imprimirMapa(Antena* antenas, Antena* efeitos, int linhas, int colunas) {
     /* Validação de parâmetros */
@@ -88,31 +505,246 @@ void imprimirMapa(Antena* antenas, Antena* efeitos, int linhas, int colunas) {
         return;
     }
 
-    /* Renderização do mapa */
-    for (int y = 0; y < linhas; y++) {
-        for (int x = 0; x < colunas; x++) {
-            char c = '.';
-            
-            /* Verifica antenas primeiro */
-            for (Antena* a = antenas; a != NULL; a = a->prox) {
-                if (a->x == x && a->y == y) {
-                    c = a->frequencia;
-                    break;
-                }
-            }
-            
-            /* Verifica efeitos se necessário */
-            if (c == '.' && efeitos != NULL) {
-                for (Antena* e = efeitos; e != NULL; e = e->prox) {
-                    if (e->x == x && e->y == y) {
-                        c = '#';
-                        break;
-                    }
-                }
-            }
-            
-            printf("%c", c);
-        }
-        printf("\n");
+    fflush(stdout);
+    desenhar(stdout, antenas, efeitos, 0, 0, colunas, linhas, 1);
+}
+
+/**
+ * @brief Implementação da renderização de uma janela do mapa
+ * 
+ * @param[in] saida Ficheiro de destino
+ * @param[in] antenas Lista de antenas ativas
+ * @param[in] efeitos Lista de zonas de interferência (pode ser NULL)
+ * @param[in] x0 Primeira coluna da janela
+ * @param[in] y0 Primeira linha da janela
+ * @param[in] largura Número de colunas da janela
+ * @param[in] altura Número de linhas da janela
+ */
+void imprimirJanela(FILE* saida, Antena* antenas, Antena* efeitos,
+                    int x0, int y0, int largura, int altura) {
+    if (largura <= 0 || altura <= 0) {
+        fprintf(stderr, "Erro: Dimensões inválidas da janela\n");
+        return;
+    }
+    desenhar(saida, antenas, efeitos, x0, y0, largura, altura, 1);
+}
+
+/**
+ * @brief Implementação da renderização reduzida do mapa
+ * 
+ * @param[in] saida Ficheiro de destino
+ * @param[in] antenas Lista de antenas ativas
+ * @param[in] efeitos Lista de zonas de interferência (pode ser NULL)
+ * @param[in] linhas Número total de linhas do mapa
+ * @param[in] colunas Número total de colunas do mapa
+ * @param[in] fator Lado, em células, de cada bloco representado por um carácter
+ */
+void imprimirMapaReduzido(FILE* saida, Antena* antenas, Antena* efeitos,
+                          int linhas, int colunas, int fator) {
+    if (linhas <= 0 || colunas <= 0 || fator <= 0) {
+        fprintf(stderr, "Erro: Dimensões inválidas do mapa\n");
+        return;
+    }
+    desenhar(saida, antenas, efeitos, 0, 0, colunas, linhas, fator);
+}
+
+/**
+ * @brief Cabeçalho fixo do snapshot binário
+ */
+typedef struct {
+    char magia[8];          ///< "EDASNAP" terminado em '\0'
+    uint32_t versao;        ///< SNAPSHOT_VERSAO
+    uint32_t ordem;         ///< 0x01020304 na ordem de bytes de quem escreveu
+    uint32_t marcas;        ///< Combinação de SNAPSHOT_BITMAP_*
+    int32_t linhas;         ///< Número de linhas do mapa
+    int32_t colunas;        ///< Número de colunas do mapa
+    uint32_t reservado;     ///< Alinhamento (zero)
+    uint64_t numAntenas;    ///< Número de antenas
+    uint64_t numEfeitos;    ///< Número de efeitos
+    uint64_t inicio[257];   ///< Limites dos grupos de frequência das antenas
+} CabecalhoSnapshot;
+
+/**
+ * @brief Marca de ordem de bytes gravada no cabeçalho
+ */
+ #define SNAPSHOT_ORDEM 0x01020304u
+
+/**
+ * @brief Arredonda para o múltiplo de 8 seguinte
+ */
+static size_t alinhar8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+/**
+ * @brief Escreve n bytes seguidos de enchimento até múltiplo de 8
+ */
+static int escreverSecao(FILE* f, const void* dados, size_t n) {
+    static const char zeros[8] = {0};
+    if (n > 0 && fwrite(dados, 1, n, f) != n) return 0;
+    size_t enchimento = alinhar8(n) - n;
+    return enchimento == 0 || fwrite(zeros, 1, enchimento, f) == enchimento;
+}
+
+/**
+ * @brief Escreve o bitmap de ocupação (ordem por linhas) de um conjunto
+ */
+static int escreverBitmap(FILE* f, const AntenaSet* c, int linhas, int colunas) {
+    size_t bytes = ((size_t)linhas * (size_t)colunas + 7) / 8;
+    uint8_t* bits = (uint8_t*)calloc(bytes ? bytes : 1, 1);
+    if (bits == NULL) return 0;
+    for (size_t i = 0; c != NULL && i < c->tamanho; i++) {
+        if (c->x[i] < 0 || c->x[i] >= colunas || c->y[i] < 0 || c->y[i] >= linhas) continue;
+        size_t p = (size_t)c->y[i] * (size_t)colunas + (size_t)c->x[i];
+        bits[p >> 3] |= (uint8_t)(1u << (p & 7));
+    }
+    int ok = escreverSecao(f, bits, bytes);
+    free(bits);
+    return ok;
+}
+
+int guardarSnapshot(const char* filename, const AntenaSet* antenas,
+                    const AntenaSet* efeitos, unsigned marcas) {
+    FILE* f = fopen(filename, "wb");
+    if (!f) {
+        fprintf(stderr, "Erro: Não foi possível criar o ficheiro %s\n", filename);
+        return 0;
+    }
+
+    // Bitmaps só fazem sentido com dimensões conhecidas e coordenadas dentro do mapa
+    if (antenas->linhas <= 0 || antenas->colunas <= 0) marcas = 0;
+
+    CabecalhoSnapshot cab;
+    memset(&cab, 0, sizeof(cab));
+    memcpy(cab.magia, "EDASNAP", 8);
+    cab.versao = SNAPSHOT_VERSAO;
+    cab.ordem = SNAPSHOT_ORDEM;
+    cab.marcas = marcas;
+    cab.linhas = antenas->linhas;
+    cab.colunas = antenas->colunas;
+    cab.numAntenas = antenas->tamanho;
+    cab.numEfeitos = efeitos != NULL ? efeitos->tamanho : 0;
+    for (int g = 0; g <= 256; g++) cab.inicio[g] = antenas->inicio[g];
+
+    size_t n = antenas->tamanho, m = (size_t)cab.numEfeitos;
+    int ok = escreverSecao(f, &cab, sizeof(cab)) &&
+             escreverSecao(f, antenas->x, n * sizeof(int32_t)) &&
+             escreverSecao(f, antenas->y, n * sizeof(int32_t)) &&
+             escreverSecao(f, antenas->frequencia, n) &&
+             escreverSecao(f, m ? efeitos->x : NULL, m * sizeof(int32_t)) &&
+             escreverSecao(f, m ? efeitos->y : NULL, m * sizeof(int32_t)) &&
+             escreverSecao(f, m ? efeitos->frequencia : NULL, m);
+    if (ok && (marcas & SNAPSHOT_BITMAP_ANTENAS))
+        ok = escreverBitmap(f, antenas, cab.linhas, cab.colunas);
+    if (ok && (marcas & SNAPSHOT_BITMAP_EFEITOS))
+        ok = escreverBitmap(f, efeitos, cab.linhas, cab.colunas);
+
+    if (fclose(f) != 0) ok = 0;
+    if (!ok) fprintf(stderr, "Erro: Falha ao escrever o ficheiro %s\n", filename);
+    return ok;
+}
+
+/**
+ * @brief Prepara um conjunto só de leitura sobre vetores do ficheiro mapeado
+ * 
+ * @return const char* Posição seguinte às secções do conjunto
+ */
+static const char* vistaConjunto(AntenaSet* c, IndiceCoord* indice, const char* p,
+                                 size_t n, int linhas, int colunas) {
+    c->x = (int*)p;
+    p += alinhar8(n * sizeof(int32_t));
+    c->y = (int*)p;
+    p += alinhar8(n * sizeof(int32_t));
+    c->frequencia = (char*)p;
+    p += alinhar8(n);
+    c->tamanho = n;
+    c->capacidade = n;
+    c->linhas = linhas;
+    c->colunas = colunas;
+    c->ocupadas = indice;
+    return p;
+}
+
+/**
+ * @brief Associa um índice a um conjunto: bitmap do ficheiro ou hash em memória
+ * 
+ * @return const char* Posição seguinte ao bitmap (se usado)
+ */
+static const char* indexarVista(AntenaSet* c, IndiceCoord* indice, const char* p, int temBitmap) {
+    memset(indice, 0, sizeof(*indice));
+    if (temBitmap) {
+        indice->modo = INDICE_BITMAP;
+        indice->linhas = c->linhas;
+        indice->colunas = c->colunas;
+        indice->tamanho = c->tamanho;
+        indice->bits = (uint8_t*)p;
+        return p + alinhar8(((size_t)c->linhas * (size_t)c->colunas + 7) / 8);
+    }
+    IndiceCoord* hash = criarIndiceCoord(0, 0, c->tamanho);
+    for (size_t i = 0; i < c->tamanho; i++) indiceInserir(hash, c->x[i], c->y[i]);
+    *indice = *hash;
+    free(hash);
+    return p;
+}
+
+SnapshotMapa* abrirSnapshot(const char* filename) {
+    SnapshotMapa* s = (SnapshotMapa*)alocarZeros(1, sizeof(SnapshotMapa));
+    if (!mapearFicheiro(filename, &s->ficheiro)) {
+        fprintf(stderr, "Erro: Não foi possível abrir o ficheiro %s\n", filename);
+        free(s);
+        return NULL;
+    }
+
+    const CabecalhoSnapshot* cab = (const CabecalhoSnapshot*)s->ficheiro.dados;
+    size_t tamanho = s->ficheiro.tamanho;
+    int valido = tamanho >= sizeof(CabecalhoSnapshot) &&
+                 memcmp(cab->magia, "EDASNAP", 8) == 0 &&
+                 cab->versao == SNAPSHOT_VERSAO && cab->ordem == SNAPSHOT_ORDEM &&
+                 cab->linhas >= 0 && cab->colunas >= 0 &&
+                 cab->inicio[0] == 0 && cab->inicio[256] == cab->numAntenas;
+    for (int g = 0; valido && g < 256; g++)
+        valido = cab->inicio[g] <= cab->inicio[g + 1];
+
+    if (valido) {
+        // Tamanho esperado a partir do cabeçalho (em 64 bits, sem transbordo)
+        uint64_t n = cab->numAntenas, m = cab->numEfeitos;
+        uint64_t bitmap = alinhar8(((uint64_t)cab->linhas * (uint64_t)cab->colunas + 7) / 8);
+        uint64_t esperado = sizeof(CabecalhoSnapshot) +
+                            2 * alinhar8(n * 4) + alinhar8(n) + 2 * alinhar8(m * 4) + alinhar8(m) +
+                            ((cab->marcas & SNAPSHOT_BITMAP_ANTENAS) ? bitmap : 0) +
+                            ((cab->marcas & SNAPSHOT_BITMAP_EFEITOS) ? bitmap : 0);
+        valido = n < ((uint64_t)1 << 40) && m < ((uint64_t)1 << 40) && esperado == tamanho;
+    }
+    if (!valido) {
+        fprintf(stderr, "Erro: Snapshot inválido ou de versão incompatível: %s\n", filename);
+        desmapearFicheiro(&s->ficheiro);
+        free(s);
+        return NULL;
+    }
+
+    s->linhas = cab->linhas;
+    s->colunas = cab->colunas;
+    const char* p = s->ficheiro.dados + sizeof(CabecalhoSnapshot);
+    p = vistaConjunto(&s->antenas, &s->ocupadasAntenas, p, (size_t)cab->numAntenas, s->linhas, s->colunas);
+    for (int g = 0; g <= 256; g++) s->antenas.inicio[g] = (size_t)cab->inicio[g];
+    p = vistaConjunto(&s->efeitos, &s->ocupadasEfeitos, p, (size_t)cab->numEfeitos, s->linhas, s->colunas);
+    for (int g = (unsigned char)'#' + 1; g <= 256; g++) s->efeitos.inicio[g] = s->efeitos.tamanho;
+    p = indexarVista(&s->antenas, &s->ocupadasAntenas, p, cab->marcas & SNAPSHOT_BITMAP_ANTENAS);
+    indexarVista(&s->efeitos, &s->ocupadasEfeitos, p, cab->marcas & SNAPSHOT_BITMAP_EFEITOS);
+    return s;
+}
+
+void fecharSnapshot(SnapshotMapa* snapshot) {
+    if (snapshot == NULL) return;
+    // Só os índices em hash pertencem à memória do processo
+    if (snapshot->ocupadasAntenas.modo == INDICE_HASH) {
+        free(snapshot->ocupadasAntenas.chaves);
+        free(snapshot->ocupadasAntenas.usados);
+    }
+    if (snapshot->ocupadasEfeitos.modo == INDICE_HASH) {
+        free(snapshot->ocupadasEfeitos.chaves);
+        free(snapshot->ocupadasEfeitos.usados);
     }
+    desmapearFicheiro(&snapshot->ficheiro);
+    free(snapshot);
 }
\ No newline at end of file